@@ -0,0 +1,587 @@
+/**
+ * @file Benchmark.c
+ * @brief Source code for the Benchmark module.
+ *
+ * This file contains the function definitions for the Benchmark module.
+ * It reports cycle counts measured with the Cycle_Counter driver over UART (EUSCI_A0) using printf.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Benchmark.h"
+
+// Names of the profiled interrupt service routines, indexed by ISR_Profile_ID
+static const char *ISR_Profile_Names[ISR_PROFILE_COUNT] =
+{
+    "TA1_0_IRQHandler",
+    "PORT4_IRQHandler",
+    "PORT6_IRQHandler",
+    "TA2_0_IRQHandler",
+    "DMA_INT0_IRQHandler",
+    "EUSCIA0_IRQHandler",
+    "EUSCIA2_IRQHandler"
+};
+
+void Benchmark_Print_ISR_Table(void)
+{
+    ISR_Profile_Stats stats;
+    int i;
+
+    printf("%-18s %10s %8s %8s %8s %8s\n", "ISR", "Samples", "Min", "Mean", "p99", "Max");
+    for (i = 0; i < ISR_PROFILE_COUNT; i = i + 1)
+    {
+        ISR_Profile_Get_Stats((ISR_Profile_ID)i, &stats);
+        printf("%-18s %10lu %8lu %8lu %8lu %8lu\n", ISR_Profile_Names[i],
+               (unsigned long)stats.count, (unsigned long)stats.min_cycles,
+               (unsigned long)stats.mean_cycles, (unsigned long)stats.p99_cycles,
+               (unsigned long)stats.max_cycles);
+    }
+}
+
+void Benchmark_Print_Task_Table(void)
+{
+    Task_Scheduler_Stats stats;
+    int i;
+
+    printf("%-18s %10s %8s %8s %8s %8s\n", "Task", "Runs", "Overrun", "Last", "Mean", "Max");
+    for (i = 0; i < Task_Scheduler_Get_Num_Tasks(); i = i + 1)
+    {
+        Task_Scheduler_Get_Stats((int8_t)i, &stats);
+        printf("Task %-13d %10lu %8lu %8lu %8lu %8lu\n", i,
+               (unsigned long)stats.run_count, (unsigned long)stats.overrun_count,
+               (unsigned long)stats.last_cycles, (unsigned long)stats.mean_cycles,
+               (unsigned long)stats.max_cycles);
+    }
+    printf("%-18s %10lu\n", "Scheduler overrun", (unsigned long)Task_Scheduler_Get_Overrun_Count());
+    printf("%-18s %10lu\n", "Sleep permille", (unsigned long)Task_Scheduler_Get_Sleep_Permille());
+}
+
+void Benchmark_Print_Servo_Angle_Table(void)
+{
+    const Servo_Angle_Calibration *calibration;
+    uint64_t ideal_numerator;
+    uint64_t actual_numerator;
+    uint64_t error_numerator;
+    uint64_t sum_error_ns;
+    uint32_t max_error_ns;
+    uint32_t error_ns;
+    uint32_t sum_cycles;
+    uint32_t start_cycles;
+    uint32_t num_samples;
+    uint32_t millidegrees;
+    uint16_t counts;
+    int i;
+
+    // Pulse widths are compared as fractions with the common denominator (SERVO_ANGLE_COUNTS_PER_US * SERVO_ANGLE_MAX_MILLIDEGREES),
+    // with numerators in units of 1 ns, so that the ideal pulse width is computed without rounding
+    printf("%-18s %10s %8s %8s %8s\n", "Servo", "Samples", "MaxErr", "MeanErr", "Cycles");
+    for (i = 0; i < SERVO_TRAJECTORY_NUM_SERVOS; i = i + 1)
+    {
+        calibration = Servo_Angle_Get_Calibration((Servo_Trajectory_ID)i);
+        sum_error_ns = 0;
+        max_error_ns = 0;
+        sum_cycles = 0;
+        num_samples = 0;
+
+        for (millidegrees = 0; millidegrees <= SERVO_ANGLE_MAX_MILLIDEGREES; millidegrees = millidegrees + BENCHMARK_SERVO_ANGLE_STEP)
+        {
+            start_cycles = Cycle_Counter_Read();
+            counts = Servo_Angle_To_Counts((Servo_Trajectory_ID)i, millidegrees);
+            sum_cycles = sum_cycles + Cycle_Counter_Elapsed(start_cycles);
+
+            ideal_numerator = ((uint64_t)calibration->min_counts * SERVO_ANGLE_MAX_MILLIDEGREES +
+                               (uint64_t)(calibration->max_counts - calibration->min_counts) * millidegrees) * 1000;
+            actual_numerator = (uint64_t)counts * SERVO_ANGLE_MAX_MILLIDEGREES * 1000;
+            error_numerator = (actual_numerator > ideal_numerator) ? (actual_numerator - ideal_numerator) : (ideal_numerator - actual_numerator);
+            error_ns = (uint32_t)(error_numerator / ((uint64_t)SERVO_ANGLE_COUNTS_PER_US * SERVO_ANGLE_MAX_MILLIDEGREES));
+
+            if (error_ns > max_error_ns)
+            {
+                max_error_ns = error_ns;
+            }
+            sum_error_ns = sum_error_ns + error_ns;
+            num_samples = num_samples + 1;
+        }
+
+        printf("Servo %-12d %10lu %8lu %8lu %8lu\n", i + 1, (unsigned long)num_samples,
+               (unsigned long)max_error_ns, (unsigned long)(sum_error_ns / num_samples),
+               (unsigned long)(sum_cycles / num_samples));
+    }
+}
+
+void Benchmark_Print_Servo_Mux_Table(void)
+{
+    Servo_Mux_Stats stats;
+    int i;
+
+    // Timer A3 counts are converted to nanoseconds (1000 / SERVO_MUX_COUNTS_PER_US ns per count)
+    printf("%-18s %10s %8s %8s %8s\n", "Mux channel", "Pulses", "MinLat", "MaxLat", "Jitter");
+    for (i = 0; i < SERVO_MUX_NUM_CHANNELS; i = i + 1)
+    {
+        Servo_Mux_Get_Stats((uint8_t)i, &stats);
+        printf("Channel %-10d %10lu %8lu %8lu %8lu\n", i, (unsigned long)stats.pulse_count,
+               (unsigned long)stats.min_latency * 1000 / SERVO_MUX_COUNTS_PER_US,
+               (unsigned long)stats.max_latency * 1000 / SERVO_MUX_COUNTS_PER_US,
+               (unsigned long)stats.max_width_error * 1000 / SERVO_MUX_COUNTS_PER_US);
+    }
+    Servo_Mux_Reset_Stats();
+}
+
+// Print one row of the LCD flush table
+static void Benchmark_Print_LCD_Flush_Row(const char *name, uint32_t cpu_cycles, uint32_t total_cycles)
+{
+    printf("%-18s %10lu %8lu %8lu %8lu\n", name, (unsigned long)BENCHMARK_LCD_NUM_FRAMES,
+           (unsigned long)(cpu_cycles / BENCHMARK_LCD_NUM_FRAMES),
+           (unsigned long)(total_cycles / BENCHMARK_LCD_NUM_FRAMES),
+           (unsigned long)((uint64_t)Clock_GetFreq() * BENCHMARK_LCD_NUM_FRAMES / total_cycles));
+}
+
+void Benchmark_Print_LCD_Flush_Table(void)
+{
+    ISR_Profile_Stats isr_stats;
+    uint32_t cpu_cycles;
+    uint32_t total_cycles;
+    uint32_t start_cycles;
+    int i;
+
+    printf("%-18s %10s %8s %8s %8s\n", "LCD flush", "Frames", "CPU", "Total", "FPS");
+
+    // Blocking flush: the CPU writes every byte and waits for the transmit buffer
+    start_cycles = Cycle_Counter_Read();
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        Nokia5110_DisplayBuffer();
+    }
+    while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+    total_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_LCD_Flush_Row("Blocking", total_cycles, total_cycles);
+
+    // uDMA flush: the CPU only sets up the transfer and handles the completion interrupt
+    ISR_Profile_Reset();
+    cpu_cycles = 0;
+    total_cycles = 0;
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        start_cycles = Cycle_Counter_Read();
+        Nokia5110_DisplayBuffer_DMA(0);
+        cpu_cycles = cpu_cycles + Cycle_Counter_Elapsed(start_cycles);
+        while (Nokia5110_Flush_Busy());
+        while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+        total_cycles = total_cycles + Cycle_Counter_Elapsed(start_cycles);
+    }
+    ISR_Profile_Get_Stats(ISR_PROFILE_DMA_INT0, &isr_stats);
+    cpu_cycles = cpu_cycles + isr_stats.mean_cycles * BENCHMARK_LCD_NUM_FRAMES;
+    Benchmark_Print_LCD_Flush_Row("uDMA", cpu_cycles, total_cycles);
+}
+
+// Redraw an 18x8 pixel region in bank 2 of the screen buffer, which is the size of three characters
+static void Benchmark_Draw_LCD_Digits(int frame)
+{
+    uint32_t row;
+    uint32_t column;
+
+    for (column = 30; column < 48; column = column + 1)
+    {
+        for (row = 16; row < 24; row = row + 1)
+        {
+            if (((row + column + frame) & 0x03) == 0)
+            {
+                Nokia5110_SetPxl(row, column);
+            }
+            else
+            {
+                Nokia5110_ClrPxl(row, column);
+            }
+        }
+    }
+}
+
+void Benchmark_Print_LCD_Dirty_Table(void)
+{
+    uint32_t total_cycles;
+    uint32_t total_bytes;
+    uint32_t start_cycles;
+    int i;
+
+    printf("%-18s %10s %8s %8s\n", "LCD update", "Frames", "Bytes", "Cycles");
+
+    // Start from a screen that matches the buffer
+    Nokia5110_ClearBuffer();
+    Nokia5110_DisplayBuffer();
+
+    // Full flush: the whole buffer is sent every frame
+    total_cycles = 0;
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        Benchmark_Draw_LCD_Digits(i);
+        start_cycles = Cycle_Counter_Read();
+        Nokia5110_DisplayBuffer();
+        while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+        total_cycles = total_cycles + Cycle_Counter_Elapsed(start_cycles);
+    }
+    printf("%-18s %10lu %8lu %8lu\n", "Full", (unsigned long)BENCHMARK_LCD_NUM_FRAMES,
+           (unsigned long)(2 + SCREENW*SCREENH/8), (unsigned long)(total_cycles / BENCHMARK_LCD_NUM_FRAMES));
+
+    // Dirty flush: only the modified columns of each bank are sent
+    total_cycles = 0;
+    total_bytes = 0;
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        Benchmark_Draw_LCD_Digits(i);
+        start_cycles = Cycle_Counter_Read();
+        total_bytes = total_bytes + Nokia5110_DisplayBuffer_Dirty();
+        while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+        total_cycles = total_cycles + Cycle_Counter_Elapsed(start_cycles);
+    }
+    printf("%-18s %10lu %8lu %8lu\n", "Dirty", (unsigned long)BENCHMARK_LCD_NUM_FRAMES,
+           (unsigned long)(total_bytes / BENCHMARK_LCD_NUM_FRAMES), (unsigned long)(total_cycles / BENCHMARK_LCD_NUM_FRAMES));
+}
+
+void Benchmark_Print_SPI_Rate_Table(void)
+{
+    uint32_t requested_bit_rate;
+    uint32_t actual_bit_rate;
+    uint32_t total_cycles;
+    uint32_t start_cycles;
+    uint32_t frame_cycles;
+    int i;
+
+    printf("%-18s %10s %8s %8s\n", "SPI bit rate", "Actual", "Bytes/s", "Frame us");
+    for (requested_bit_rate = 1000000; requested_bit_rate <= NOKIA5110_SPI_BIT_RATE; requested_bit_rate = requested_bit_rate + 1000000)
+    {
+        actual_bit_rate = EUSCI_A3_SPI_Set_Bit_Rate(requested_bit_rate);
+
+        start_cycles = Cycle_Counter_Read();
+        for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+        {
+            Nokia5110_DisplayBuffer();
+        }
+        while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+        total_cycles = Cycle_Counter_Elapsed(start_cycles);
+        frame_cycles = total_cycles / BENCHMARK_LCD_NUM_FRAMES;
+
+        // Each frame sends two cursor commands and the 504-byte screen buffer
+        printf("%-18lu %10lu %8lu %8lu\n", (unsigned long)requested_bit_rate, (unsigned long)actual_bit_rate,
+               (unsigned long)((uint64_t)(2 + SCREENW*SCREENH/8) * Clock_GetFreq() / frame_cycles),
+               (unsigned long)(frame_cycles / (Clock_GetFreq() / 1000000)));
+    }
+
+    EUSCI_A3_SPI_Set_Bit_Rate(NOKIA5110_SPI_BIT_RATE);
+}
+
+// 16x16 test sprite in the bank-major layout (a framed diagonal cross)
+static const uint8_t Benchmark_Sprite[32] =
+{
+    0xFF, 0x03, 0x05, 0x09, 0x11, 0x21, 0x41, 0x81, 0x81, 0x41, 0x21, 0x11, 0x09, 0x05, 0x03, 0xFF,
+    0xFF, 0xC0, 0xA0, 0x90, 0x88, 0x84, 0x82, 0x81, 0x81, 0x82, 0x84, 0x88, 0x90, 0xA0, 0xC0, 0xFF
+};
+
+// Print one row of the graphics table
+static void Benchmark_Print_Graphics_Row(const char *name, uint32_t pixel_cycles, uint32_t fast_cycles)
+{
+    printf("%-18s %10lu %8lu %8lu\n", name, (unsigned long)pixel_cycles, (unsigned long)fast_cycles,
+           (unsigned long)((fast_cycles != 0) ? ((pixel_cycles * 10) / fast_cycles) : 0));
+}
+
+// Set every pixel of a rectangle with Nokia5110_SetPxl
+static void Benchmark_Fill_Rect_Per_Pixel(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    uint32_t row;
+    uint32_t column;
+
+    for (row = y; row < (y + height); row = row + 1)
+    {
+        for (column = x; column < (x + width); column = column + 1)
+        {
+            Nokia5110_SetPxl(row, column);
+        }
+    }
+}
+
+void Benchmark_Print_Graphics_Table(void)
+{
+    uint32_t start_cycles;
+    uint32_t pixel_cycles;
+    uint32_t fast_cycles;
+    int32_t dx;
+    int32_t dy;
+    uint32_t row;
+    uint32_t column;
+
+    printf("%-18s %10s %8s %8s\n", "Graphics", "PerPixel", "Fast", "Speedup10");
+
+    // Full screen fill
+    start_cycles = Cycle_Counter_Read();
+    Benchmark_Fill_Rect_Per_Pixel(0, 0, SCREENW, SCREENH);
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Fill_Rect(0, 0, SCREENW, SCREENH, NOKIA5110_PIXEL_SET);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("Fill 84x48", pixel_cycles, fast_cycles);
+
+    // Unaligned rectangle
+    start_cycles = Cycle_Counter_Read();
+    Benchmark_Fill_Rect_Per_Pixel(3, 5, 40, 20);
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Fill_Rect(3, 5, 40, 20, NOKIA5110_PIXEL_SET);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("Fill 40x20", pixel_cycles, fast_cycles);
+
+    // Horizontal line across the screen
+    start_cycles = Cycle_Counter_Read();
+    Benchmark_Fill_Rect_Per_Pixel(0, 20, SCREENW, 1);
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Draw_HLine(0, 20, SCREENW, NOKIA5110_PIXEL_SET);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("HLine 84", pixel_cycles, fast_cycles);
+
+    // Vertical line across the screen
+    start_cycles = Cycle_Counter_Read();
+    Benchmark_Fill_Rect_Per_Pixel(40, 0, 1, SCREENH);
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Draw_VLine(40, 0, SCREENH, NOKIA5110_PIXEL_SET);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("VLine 48", pixel_cycles, fast_cycles);
+
+    // Filled circle
+    start_cycles = Cycle_Counter_Read();
+    for (dy = -20; dy <= 20; dy = dy + 1)
+    {
+        for (dx = -20; dx <= 20; dx = dx + 1)
+        {
+            if ((dx * dx + dy * dy) <= 400)
+            {
+                Nokia5110_SetPxl(24 + dy, 42 + dx);
+            }
+        }
+    }
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Fill_Circle(42, 24, 20, NOKIA5110_PIXEL_SET);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("Circle r20", pixel_cycles, fast_cycles);
+
+    // 16x16 sprite at an unaligned row
+    start_cycles = Cycle_Counter_Read();
+    for (row = 0; row < 16; row = row + 1)
+    {
+        for (column = 0; column < 16; column = column + 1)
+        {
+            if (Benchmark_Sprite[16*(row >> 3) + column] & (1 << (row & 0x07)))
+            {
+                Nokia5110_SetPxl(5 + row, 10 + column);
+            }
+            else
+            {
+                Nokia5110_ClrPxl(5 + row, 10 + column);
+            }
+        }
+    }
+    pixel_cycles = Cycle_Counter_Elapsed(start_cycles);
+    start_cycles = Cycle_Counter_Read();
+    Nokia5110_Blit(10, 5, Benchmark_Sprite, 16, 16, NOKIA5110_PIXEL_COPY);
+    fast_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_Graphics_Row("Blit 16x16", pixel_cycles, fast_cycles);
+
+    Nokia5110_ClearBuffer();
+}
+
+void Benchmark_Print_LCD_Text_Table(void)
+{
+    ISR_Profile_Stats isr_stats;
+    char text[] = "Servo 1 90.0";
+    uint32_t cpu_cycles;
+    uint32_t total_cycles;
+    uint32_t start_cycles;
+    char *ptr;
+    int i;
+
+    printf("%-18s %10s %8s %8s %8s\n", "LCD text", "Strings", "CPU", "Total", "Per sec");
+
+    // One Nokia5110_Data_Write call per column
+    start_cycles = Cycle_Counter_Read();
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        for (ptr = text; *ptr != 0; ptr = ptr + 1)
+        {
+            Nokia5110_OutChar(*ptr);
+        }
+    }
+    while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+    total_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_LCD_Flush_Row("OutChar", total_cycles, total_cycles);
+
+    // Data/Command pin set once per string
+    start_cycles = Cycle_Counter_Read();
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        Nokia5110_OutString(text);
+    }
+    while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+    total_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_LCD_Flush_Row("OutString", total_cycles, total_cycles);
+
+    // uDMA: the CPU only renders the columns and sets up the transfer
+    ISR_Profile_Reset();
+    cpu_cycles = 0;
+    total_cycles = 0;
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        start_cycles = Cycle_Counter_Read();
+        Nokia5110_OutString_DMA(text, 0);
+        cpu_cycles = cpu_cycles + Cycle_Counter_Elapsed(start_cycles);
+        while (Nokia5110_Flush_Busy());
+        while ((EUSCI_A3->STATW & 0x0001) == 0x0001);
+        total_cycles = total_cycles + Cycle_Counter_Elapsed(start_cycles);
+    }
+    ISR_Profile_Get_Stats(ISR_PROFILE_DMA_INT0, &isr_stats);
+    cpu_cycles = cpu_cycles + isr_stats.mean_cycles * BENCHMARK_LCD_NUM_FRAMES;
+    Benchmark_Print_LCD_Flush_Row("OutString_DMA", cpu_cycles, total_cycles);
+
+    // Screen buffer at an unaligned row, without sending it to the LCD
+    start_cycles = Cycle_Counter_Read();
+    for (i = 0; i < BENCHMARK_LCD_NUM_FRAMES; i = i + 1)
+    {
+        Nokia5110_Draw_String(0, 3, text, NOKIA5110_PIXEL_COPY);
+    }
+    total_cycles = Cycle_Counter_Elapsed(start_cycles);
+    Benchmark_Print_LCD_Flush_Row("Draw_String", total_cycles, total_cycles);
+
+    Nokia5110_ClearBuffer();
+}
+
+// Convert n into a decimal string with one division and one remainder per digit, like the original EUSCI_A0_UART_OutUDec
+static char *Benchmark_UDec_Divide(char *buffer, uint32_t n)
+{
+    if (n >= 10)
+    {
+        buffer = Benchmark_UDec_Divide(buffer, n/10);
+        n = n%10;
+    }
+    *buffer = n + '0';
+    *(buffer + 1) = 0;
+    return buffer + 1;
+}
+
+void Benchmark_Print_Format_Table(void)
+{
+    static const uint32_t values[] = {0, 7, 42, 999, 65535, 1234567, 4294967295u};
+    char buffer[FORMAT_BUFFER_SIZE];
+    uint32_t divide_cycles;
+    uint32_t format_cycles;
+    uint32_t sprintf_cycles;
+    uint32_t width_cycles;
+    uint32_t fix_cycles;
+    uint32_t start_cycles;
+    int i;
+
+    printf("%-18s %10s %8s %8s %8s %8s\n", "Format", "Divide", "UDec", "sprintf", "SDecW", "SFix");
+
+    for (i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i = i + 1)
+    {
+        start_cycles = Cycle_Counter_Read();
+        Benchmark_UDec_Divide(buffer, values[i]);
+        divide_cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        start_cycles = Cycle_Counter_Read();
+        Format_UDec(buffer, values[i]);
+        format_cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        start_cycles = Cycle_Counter_Read();
+        sprintf(buffer, "%lu", (unsigned long)values[i]);
+        sprintf_cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        start_cycles = Cycle_Counter_Read();
+        Format_SDec_Width(buffer, -(int32_t)(values[i] >> 1), 12);
+        width_cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        start_cycles = Cycle_Counter_Read();
+        Format_SFix(buffer, -(int32_t)(values[i] >> 1), 1, 13);
+        fix_cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        printf("%-18lu %10lu %8lu %8lu %8lu %8lu\n", (unsigned long)values[i], (unsigned long)divide_cycles,
+               (unsigned long)format_cycles, (unsigned long)sprintf_cycles, (unsigned long)width_cycles, (unsigned long)fix_cycles);
+    }
+}
+
+// Replaces Bumper_Task during Benchmark_Print_Emergency_Stop_Table, so that no collision handling is started
+static void Benchmark_Bumper_Task(uint8_t bumper_sensor_state)
+{
+    (void)bumper_sensor_state;
+}
+
+void Benchmark_Print_Emergency_Stop_Table(void)
+{
+    void (*bumper_task)(uint8_t);
+    Bumper_Sensors_Stats stats;
+    uint32_t stop_count;
+    uint32_t start_cycles;
+    uint32_t latency_cycles;
+    uint32_t min_cycles = 0xFFFFFFFF;
+    uint32_t max_cycles = 0;
+    uint32_t total_cycles = 0;
+    uint32_t count = 0;
+    uint32_t skipped_count = 0;
+    uint32_t timeout;
+    int i;
+
+    bumper_task = Bumper_Task;
+    Bumper_Task = &Benchmark_Bumper_Task;
+
+    for (i = 0; i < BENCHMARK_EMERGENCY_STOP_NUM_SAMPLES; i = i + 1)
+    {
+        // Wait until Bumper_Sensors_Process enables the interrupt of P4.0 again. After a sample, this takes the lockout
+        // of the press, the lockout of the release that is detected at its end, and up to one period of the task.
+        timeout = BENCHMARK_EMERGENCY_STOP_TIMEOUT_MS;
+        while (((P4->IE & 0x01) == 0) && (timeout > 0))
+        {
+            Clock_Delay1ms(1);
+            timeout = timeout - 1;
+        }
+
+        // The interrupt of P4.0 must be enabled for a press (falling edge) and the switch must be released
+        if (((P4->IE & 0x01) == 0) || ((P4->IES & 0x01) == 0) || ((P4->IN & 0x01) == 0))
+        {
+            skipped_count = skipped_count + 1;
+            continue;
+        }
+
+        Bumper_Sensors_Get_Stats(&stats);
+        stop_count = stats.emergency_stop_count;
+
+        // Simulate a press of BUMP_0. PORT4_IRQHandler runs right after the flag is set.
+        start_cycles = Cycle_Counter_Read();
+        P4->IFG |= 0x01;
+
+        timeout = 1000;
+        do
+        {
+            Bumper_Sensors_Get_Stats(&stats);
+            timeout = timeout - 1;
+        } while ((stats.emergency_stop_count == stop_count) && (timeout > 0));
+
+        if (stats.emergency_stop_count == stop_count)
+        {
+            skipped_count = skipped_count + 1;
+            continue;
+        }
+
+        latency_cycles = stats.emergency_stop_cycles - start_cycles;
+        if (latency_cycles < min_cycles) min_cycles = latency_cycles;
+        if (latency_cycles > max_cycles) max_cycles = latency_cycles;
+        total_cycles = total_cycles + latency_cycles;
+        count = count + 1;
+    }
+
+    Bumper_Task = bumper_task;
+
+    if (count == 0) min_cycles = 0;
+
+    printf("%-18s %10s %8s %8s %8s %8s\n", "Emergency stop", "Samples", "Skipped", "Min", "Mean", "Max");
+    printf("%-18s %10lu %8lu %8lu %8lu %8lu\n", "IFG to motors off", (unsigned long)count, (unsigned long)skipped_count,
+           (unsigned long)min_cycles, (unsigned long)((count > 0) ? (total_cycles / count) : 0), (unsigned long)max_cycles);
+}
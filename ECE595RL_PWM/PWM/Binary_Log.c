@@ -0,0 +1,120 @@
+/**
+ * @file Binary_Log.c
+ * @brief Source code for the Binary_Log driver.
+ *
+ * This file contains the function definitions for the Binary_Log driver.
+ * It provides a deferred logging mechanism that can be used from any interrupt service routine.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Binary_Log.h"
+
+// A single log record
+typedef struct
+{
+    const char *fmt;
+    uint32_t timestamp;
+    uint8_t num_args;
+    uint32_t args[BINARY_LOG_MAX_ARGS];
+} Binary_Log_Record;
+
+// Log ring buffer. The buffer is empty when Log_Head == Log_Tail.
+static Binary_Log_Record Log_Buffer[BINARY_LOG_BUFFER_SIZE];
+static volatile uint16_t Log_Head = 0;
+static volatile uint16_t Log_Tail = 0;
+
+static volatile uint32_t Log_Dropped_Count = 0;
+
+#define LOG_NEXT(index)  (((index) + 1) & (BINARY_LOG_BUFFER_SIZE - 1))
+
+void Binary_Log_Write(const char *fmt, uint8_t num_args, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+    Binary_Log_Record *record;
+    long sr;
+
+    // Reserve and fill a record with interrupts disabled, so that a higher priority interrupt cannot write
+    // to the same record and Binary_Log_Drain never reads a partially written one. Filling the record only
+    // takes a few stores, so interrupts are disabled for a short, fixed time.
+    sr = StartCritical();
+    if (LOG_NEXT(Log_Head) == Log_Tail)
+    {
+        Log_Dropped_Count = Log_Dropped_Count + 1;
+        EndCritical(sr);
+        return;
+    }
+    record = &Log_Buffer[Log_Head];
+    record->fmt = fmt;
+    record->timestamp = Cycle_Counter_Read();
+    record->num_args = num_args;
+    record->args[0] = a0;
+    record->args[1] = a1;
+    record->args[2] = a2;
+    record->args[3] = a3;
+    Log_Head = LOG_NEXT(Log_Head);
+    EndCritical(sr);
+}
+
+// Store a 32-bit value in little-endian byte order
+static uint8_t *Binary_Log_Put_Word(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)(value & 0xFF);
+    data[1] = (uint8_t)((value >> 8) & 0xFF);
+    data[2] = (uint8_t)((value >> 16) & 0xFF);
+    data[3] = (uint8_t)((value >> 24) & 0xFF);
+    return data + 4;
+}
+
+uint32_t Binary_Log_Drain(void)
+{
+    Binary_Log_Record *record;
+    uint8_t frame[BINARY_LOG_FRAME_SIZE(BINARY_LOG_MAX_ARGS)];
+    uint8_t *position;
+    uint32_t num_records = 0;
+    uint16_t frame_size;
+    uint16_t crc;
+    long sr;
+    int i;
+
+    while (Log_Tail != Log_Head)
+    {
+        record = &Log_Buffer[Log_Tail];
+        frame_size = BINARY_LOG_FRAME_SIZE(record->num_args);
+
+        frame[0] = BINARY_LOG_SYNC_BYTE;
+        frame[1] = record->num_args;
+        position = Binary_Log_Put_Word(&frame[2], (uint32_t)(uintptr_t)record->fmt);
+        position = Binary_Log_Put_Word(position, record->timestamp);
+        for (i = 0; i < record->num_args; i = i + 1)
+        {
+            position = Binary_Log_Put_Word(position, record->args[i]);
+        }
+
+        // The CRC covers the Number of arguments field through the last argument
+        crc = CRC16_Update(CRC16_INIT, &frame[1], frame_size - 3);
+        position[0] = (uint8_t)(crc & 0xFF);
+        position[1] = (uint8_t)(crc >> 8);
+
+        // Only send a record if it fits in the UART transmit ring buffer as a whole
+        sr = StartCritical();
+        if (EUSCI_A0_UART_Get_TX_Free_Space() < frame_size)
+        {
+            EndCritical(sr);
+            break;
+        }
+        EUSCI_A0_UART_Write_Bytes(frame, frame_size);
+        EndCritical(sr);
+
+        // Release the record only after it has been copied
+        Log_Tail = LOG_NEXT(Log_Tail);
+        num_records = num_records + 1;
+    }
+
+    return num_records;
+}
+
+uint32_t Binary_Log_Get_Dropped_Count(void)
+{
+    return Log_Dropped_Count;
+}
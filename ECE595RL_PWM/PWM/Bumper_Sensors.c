@@ -30,6 +30,43 @@
 
 #include "../inc/Bumper_Sensors.h"
 
+// Pointer to the user-defined task executed by PORT4_IRQHandler
+void (*Bumper_Task)(uint8_t bumper_sensor_state);
+
+// P4 pins of the bumper switches, indexed by the bumper number (BUMP_0 to BUMP_5)
+static const uint8_t Bumper_Pins[BUMPER_SENSORS_NUM_SWITCHES] = {0x01, 0x04, 0x08, 0x20, 0x40, 0x80};
+
+// Interrupt flags of the switches that fired, the flags of those detected on a falling edge (press),
+// and the cycle counter value, stored by PORT4_IRQHandler
+typedef struct
+{
+    uint8_t flags;
+    uint8_t falling;
+    uint32_t timestamp_cycles;
+} Bumper_Edge;
+
+// Edge queue. Entries are added by PORT4_IRQHandler and removed by Bumper_Sensors_Process.
+static Bumper_Edge Edge_Queue[BUMPER_SENSORS_EDGE_QUEUE_SIZE];
+static volatile uint8_t Edge_Head = 0;
+static volatile uint8_t Edge_Tail = 0;
+
+// Event queue. Entries are added by Bumper_Sensors_Process and removed by Bumper_Sensors_Get_Event.
+static Bumper_Event Event_Queue[BUMPER_SENSORS_EVENT_QUEUE_SIZE];
+static volatile uint8_t Event_Head = 0;
+static volatile uint8_t Event_Tail = 0;
+
+// Pins whose interrupt is disabled until the end of their lockout, and the start of each lockout
+static uint8_t Locked_Pins = 0;
+static uint32_t Lockout_Start_Cycles[BUMPER_SENSORS_NUM_SWITCHES];
+static uint32_t Lockout_Cycles = 0;
+
+// Debounced state in the format of Bumper_Read, and the time of the last event of each switch
+static volatile uint8_t Debounced_State = 0;
+static uint32_t Last_Event_Cycles[BUMPER_SENSORS_NUM_SWITCHES];
+static uint8_t Has_Event = 0;
+
+static volatile Bumper_Sensors_Stats Stats;
+
 void Bumper_Sensors_Init(void(*task)(uint8_t))
 {
     // Store the user-defined task function for use during interrupt handling
@@ -52,6 +89,23 @@ void Bumper_Sensors_Init(void(*task)(uint8_t))
     // Configure the pins to use falling edge event triggers: P4.7 - P4.5, P4.3, P4.2, and P4.0
     P4->IES |= 0xED;
 
+    // Empty the queues and start from the current state of the switches.
+    // A switch that is already pressed waits for its release (Low-to-High Transition).
+    Edge_Head = 0;
+    Edge_Tail = 0;
+    Event_Head = 0;
+    Event_Tail = 0;
+    Locked_Pins = 0;
+    Has_Event = 0;
+    Stats.edge_count = 0;
+    Stats.edge_dropped_count = 0;
+    Stats.event_dropped_count = 0;
+    Stats.emergency_stop_count = 0;
+    Stats.emergency_stop_cycles = 0;
+    Lockout_Cycles = BUMPER_SENSORS_LOCKOUT_MS * (Clock_GetFreq() / 1000);
+    P4->IES &= P4->IN | ~0xED;
+    Debounced_State = Bumper_Read();
+
     // Clear any existing interrupt flags
     P4->IFG &= ~0xED;
 
@@ -81,23 +135,203 @@ uint8_t Bumper_Read(void)
     return (((bumper_state & 0xE0) >> 2) | ((bumper_state & 0x0C) >> 1) | (bumper_state & 0x01));
 }
 
+// Store an event of a switch in the event queue and update the debounced state
+static void Bumper_Sensors_Report(int bumper, uint8_t pressed, uint32_t timestamp_cycles)
+{
+    uint8_t bit = (uint8_t)(1 << bumper);
+    uint8_t next;
+
+    // Ignore an edge that does not change the debounced state
+    if (((Debounced_State & bit) != 0) == pressed) return;
+
+    Debounced_State = pressed ? (Debounced_State | bit) : (Debounced_State & ~bit);
+
+    next = (Event_Head + 1) & (BUMPER_SENSORS_EVENT_QUEUE_SIZE - 1);
+    if (next == Event_Tail)
+    {
+        Stats.event_dropped_count = Stats.event_dropped_count + 1;
+    }
+    else
+    {
+        Event_Queue[Event_Head].bumper = (uint8_t)bumper;
+        Event_Queue[Event_Head].pressed = pressed;
+        Event_Queue[Event_Head].timestamp_cycles = timestamp_cycles;
+        Event_Queue[Event_Head].duration_cycles = (Has_Event & bit) ? (timestamp_cycles - Last_Event_Cycles[bumper]) : 0;
+        Event_Head = next;
+    }
+
+    Has_Event |= bit;
+    Last_Event_Cycles[bumper] = timestamp_cycles;
+}
+
+void Bumper_Sensors_Process(void)
+{
+    Bumper_Edge edge;
+    uint32_t now;
+    uint8_t pin;
+    uint8_t pressed;
+    long sr;
+    int i;
+
+    // Report the queued edges and start the lockout of the switches that fired
+    while (Edge_Tail != Edge_Head)
+    {
+        edge = Edge_Queue[Edge_Tail];
+        Edge_Tail = (Edge_Tail + 1) & (BUMPER_SENSORS_EDGE_QUEUE_SIZE - 1);
+
+        for (i = 0; i < BUMPER_SENSORS_NUM_SWITCHES; i = i + 1)
+        {
+            pin = Bumper_Pins[i];
+            if (edge.flags & pin)
+            {
+                Locked_Pins |= pin;
+                Lockout_Start_Cycles[i] = edge.timestamp_cycles;
+                Bumper_Sensors_Report(i, (edge.falling & pin) != 0, edge.timestamp_cycles);
+            }
+        }
+    }
+
+    now = Cycle_Counter_Read();
+
+    // A disabled switch without a lockout lost its edge because the edge queue was full
+    for (i = 0; i < BUMPER_SENSORS_NUM_SWITCHES; i = i + 1)
+    {
+        pin = Bumper_Pins[i];
+        if (((P4->IE & pin) == 0) && ((Locked_Pins & pin) == 0))
+        {
+            Locked_Pins |= pin;
+            Lockout_Start_Cycles[i] = now;
+        }
+    }
+
+    // End the lockout of the switches whose edges have settled
+    for (i = 0; i < BUMPER_SENSORS_NUM_SWITCHES; i = i + 1)
+    {
+        pin = Bumper_Pins[i];
+        if (((Locked_Pins & pin) == 0) || ((now - Lockout_Start_Cycles[i]) < Lockout_Cycles)) continue;
+
+        pressed = ((P4->IN & pin) == 0);
+
+        // The switch changed state during the lockout, so report the missed edge and wait for it to settle
+        if (pressed != ((Debounced_State >> i) & 0x01))
+        {
+            Bumper_Sensors_Report(i, pressed, now);
+            Lockout_Start_Cycles[i] = now;
+            continue;
+        }
+
+        sr = StartCritical();
+
+        // Detect the opposite transition of the current level. Changing IES can set the flag, so clear it afterwards.
+        if (pressed)
+        {
+            P4->IES &= ~pin;
+        }
+        else
+        {
+            P4->IES |= pin;
+        }
+        P4->IFG &= ~pin;
+        P4->IE |= pin;
+
+        // If the level changed since it was read, the edge came before the new IES setting.
+        // Set the flag in software so that PORT4_IRQHandler stores it.
+        if (((P4->IN & pin) == 0) != pressed)
+        {
+            P4->IFG |= pin;
+        }
+
+        EndCritical(sr);
+
+        Locked_Pins &= ~pin;
+    }
+}
+
+uint8_t Bumper_Sensors_Get_Event(Bumper_Event *event)
+{
+    if (Event_Tail == Event_Head) return 0;
+
+    *event = Event_Queue[Event_Tail];
+    Event_Tail = (Event_Tail + 1) & (BUMPER_SENSORS_EVENT_QUEUE_SIZE - 1);
+    return 1;
+}
+
+uint8_t Bumper_Sensors_Get_State(void)
+{
+    return Debounced_State;
+}
+
+void Bumper_Sensors_Get_Stats(Bumper_Sensors_Stats *stats)
+{
+    stats->edge_count = Stats.edge_count;
+    stats->edge_dropped_count = Stats.edge_dropped_count;
+    stats->event_dropped_count = Stats.event_dropped_count;
+    stats->emergency_stop_count = Stats.emergency_stop_count;
+    stats->emergency_stop_cycles = Stats.emergency_stop_cycles;
+}
+
 /**
  * @brief Interrupt handler for PORT4 (P4) events.
  *
  * This function is an interrupt service routine (ISR) for PORT4 (P4) of the TI MSP432 LaunchPad.
- * It is triggered on a falling edge event on any of the switches connected to P4 (BUMP_0 to BUMP_5).
- * The function clears all interrupt flags for PORT4 and then executes the user-defined task function (Bump_Task)
- * by passing the current state of the switches, which is obtained by calling Bump_Read().
- *
- * @note This function does not handle critical section/race conditions.
+ * It is triggered on an edge event on any of the switches connected to P4 (BUMP_0 to BUMP_5).
+ * If a switch was pressed and BUMPER_SENSORS_EMERGENCY_STOP_ENABLED is set to 1, the motors are stopped first.
+ * The function disables the interrupts of the switches that fired until the end of their lockout, clears their
+ * interrupt flags, and stores the flags with a timestamp in the edge queue. Then, if a switch was pressed, it
+ * executes the user-defined task function (Bumper_Task) by passing the current state of the switches, which is
+ * obtained by calling Bumper_Read().
  *
  * @return None
  */
 void PORT4_IRQHandler(void)
 {
-    // Clear the interrupt flags for P4.7 - P4.5, P4.3, P4.2, and P4.0
-    P4->IFG &= ~0xED;
+    uint32_t timestamp_cycles = Cycle_Counter_Read();
+    uint8_t flags;
+    uint8_t falling;
+    uint8_t next;
+
+    ISR_PROFILE_BEGIN();
+
+    // Only the flags of the enabled pins are handled. The other pins are in their lockout.
+    flags = P4->IFG & P4->IE & 0xED;
+    falling = P4->IES & flags;
+
+#if (BUMPER_SENSORS_EMERGENCY_STOP_ENABLED)
+    // Stop the motors before anything else when a switch is pressed
+    if (falling)
+    {
+        Motor_Stop();
+        Stats.emergency_stop_cycles = Cycle_Counter_Read();
+        Stats.emergency_stop_count = Stats.emergency_stop_count + 1;
+    }
+#endif
+
+    // Start the lockout and clear only the flags that were read, so that an edge on another switch is not lost
+    P4->IE &= ~flags;
+    P4->IFG &= ~flags;
+
+    if (flags)
+    {
+        next = (Edge_Head + 1) & (BUMPER_SENSORS_EDGE_QUEUE_SIZE - 1);
+        if (next == Edge_Tail)
+        {
+            Stats.edge_dropped_count = Stats.edge_dropped_count + 1;
+        }
+        else
+        {
+            Edge_Queue[Edge_Head].flags = flags;
+            Edge_Queue[Edge_Head].falling = falling;
+            Edge_Queue[Edge_Head].timestamp_cycles = timestamp_cycles;
+            Edge_Head = next;
+            Stats.edge_count = Stats.edge_count + 1;
+        }
+    }
+
+    // Execute the user-defined task when a switch is pressed
+    if (falling)
+    {
+        (*Bumper_Task)(Bumper_Read());
+    }
 
-    // Execute the user-defined task
-    (*Bumper_Task)(Bumper_Read());
+    ISR_PROFILE_END(ISR_PROFILE_PORT4);
 }
@@ -0,0 +1,34 @@
+/**
+ * @file CRC16.c
+ * @brief Source code for the CRC16 driver.
+ *
+ * This file contains the function definitions for the CRC16 driver.
+ * It computes the CRC-16/CCITT-FALSE checksum four bits at a time.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/CRC16.h"
+
+// Checksum of each 4-bit value shifted into the top of the register
+static const uint16_t CRC16_Table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint16_t length)
+{
+    while (length > 0)
+    {
+        // High nibble first, then low nibble
+        crc = (uint16_t)((crc << 4) ^ CRC16_Table[(crc >> 12) ^ (*data >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ CRC16_Table[(crc >> 12) ^ (*data & 0x0F)]);
+
+        data = data + 1;
+        length = length - 1;
+    }
+
+    return crc;
+}
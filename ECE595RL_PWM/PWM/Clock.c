@@ -46,7 +46,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include "../inc/Clock.h"
 
 uint32_t ClockFrequency = 3000000; // cycles/second
-//static uint32_t SubsystemFrequency = 3000000; // cycles/second
+static uint32_t SubsystemFrequency = 3000000; // cycles/second
 
 // ------------Clock_InitFastest------------
 // Configure the system clock to run at the fastest
@@ -127,7 +127,7 @@ void Clock_Init48MHz(void){
            0x00000005;                  // configure for MCLK sourced from HFXTCLK
   CS->KEY = 0;                          // lock CS module from unintended access
   ClockFrequency = 48000000;
-//  SubsystemFrequency = 12000000;
+  SubsystemFrequency = 12000000;
 }
 
 // ------------Clock_GetFreq------------
@@ -139,6 +139,15 @@ uint32_t Clock_GetFreq(void){
   return ClockFrequency;
 }
 
+// ------------Clock_GetSMCLKFreq------------
+// Return the current subsystem clock (SMCLK) frequency
+// for the LaunchPad.
+// Input: none
+// Output: subsystem clock frequency in cycles/second
+uint32_t Clock_GetSMCLKFreq(void){
+  return SubsystemFrequency;
+}
+
 
 // delay function
 // which delays about 6*ulCount cycles
@@ -0,0 +1,373 @@
+/**
+ * @file Command_Protocol.c
+ * @brief Source code for the Command_Protocol driver.
+ *
+ * This file contains the function definitions for the Command_Protocol driver.
+ * It parses binary command frames received over EUSCI_A0, executes them, and sends a reply frame for each command.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Command_Protocol.h"
+
+// States of the frame parser
+typedef enum
+{
+    PARSER_WAIT_SYNC = 0,
+    PARSER_LENGTH,
+    PARSER_OPCODE,
+    PARSER_PAYLOAD,
+    PARSER_CRC_LOW,
+    PARSER_CRC_HIGH
+} Parser_State;
+
+static Parser_State State = PARSER_WAIT_SYNC;
+
+// Length, opcode, and payload of the frame being received, in the order covered by the CRC
+static uint8_t Frame[2 + COMMAND_PROTOCOL_MAX_PAYLOAD];
+static uint8_t Payload_Index = 0;
+static uint16_t Received_CRC = 0;
+
+// Cycle counter value when the sync byte of the current frame was received
+static uint32_t Frame_Start_Cycles = 0;
+
+static Command_Protocol_Stats Stats;
+
+#define FRAME_LENGTH    (Frame[0])
+#define FRAME_OPCODE    (Frame[1])
+#define FRAME_PAYLOAD   (&Frame[2])
+
+// Read a little-endian value from a byte array
+static int32_t Read_S32(const uint8_t *data)
+{
+    return (int32_t)((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+}
+
+// Write little-endian values to a byte array and return the position after them
+static uint8_t *Write_U16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    return data + 2;
+}
+
+static uint8_t *Write_U32(uint8_t *data, uint32_t value)
+{
+    data = Write_U16(data, (uint16_t)value);
+    return Write_U16(data, (uint16_t)(value >> 16));
+}
+
+// Send a reply frame. The frame is built in a local buffer, then added to the transmit ring buffer
+// in a single critical section once there is room for all of it. This way, a Binary_Log record written
+// by a scheduled task cannot be inserted in the middle of the frame, and interrupts are never disabled
+// while waiting for the UART.
+static void Command_Protocol_Reply(uint8_t opcode, const uint8_t *payload, uint8_t length)
+{
+    uint8_t frame[COMMAND_PROTOCOL_MAX_PAYLOAD + 5];
+    uint16_t size = length + 5;
+    uint16_t crc;
+    long sr;
+    int i;
+
+    frame[0] = COMMAND_PROTOCOL_REPLY_SYNC;
+    frame[1] = length;
+    frame[2] = opcode | 0x80;
+    for (i = 0; i < length; i = i + 1)
+    {
+        frame[3 + i] = payload[i];
+    }
+    crc = CRC16_Update(CRC16_INIT, &frame[1], length + 2);
+    frame[3 + length] = (uint8_t)(crc & 0xFF);
+    frame[4 + length] = (uint8_t)(crc >> 8);
+
+    while (1)
+    {
+        // Wait with interrupts enabled, so that the transmit interrupt can make room
+        while (EUSCI_A0_UART_Get_TX_Free_Space() < size);
+
+        // A task may have added bytes since the check, so check again before writing
+        sr = StartCritical();
+        if (EUSCI_A0_UART_Get_TX_Free_Space() >= size)
+        {
+            EUSCI_A0_UART_Write_Bytes(frame, size);
+            EndCritical(sr);
+            return;
+        }
+        EndCritical(sr);
+    }
+}
+
+// Check a single setpoint entry without applying it
+static uint8_t Command_Protocol_Check_Setpoint(uint8_t target, int32_t value)
+{
+    const Servo_Angle_Calibration *calibration;
+    uint8_t index = target & 0x0F;
+
+    switch (target & 0xF0)
+    {
+        case COMMAND_PROTOCOL_MOTOR_LEFT:
+            if (index > COMMAND_PROTOCOL_MOTOR_RIGHT) return 0;
+            return ((value >= -COMMAND_PROTOCOL_MAX_MOTOR_DUTY) && (value <= COMMAND_PROTOCOL_MAX_MOTOR_DUTY));
+
+        case COMMAND_PROTOCOL_SERVO_ANGLE:
+            if (index >= SERVO_TRAJECTORY_NUM_SERVOS) return 0;
+            return ((value >= 0) && (value <= SERVO_ANGLE_MAX_MILLIDEGREES));
+
+        case COMMAND_PROTOCOL_SERVO_COUNTS:
+            if (index >= SERVO_TRAJECTORY_NUM_SERVOS) return 0;
+            calibration = Servo_Angle_Get_Calibration((Servo_Trajectory_ID)index);
+            return ((value >= calibration->min_counts) && (value <= calibration->max_counts));
+
+        case COMMAND_PROTOCOL_TASK_PERIOD:
+            if (index >= Task_Scheduler_Get_Num_Tasks()) return 0;
+            return ((value >= 1) && (value <= 65535));
+
+        default:
+            return 0;
+    }
+}
+
+// Apply the motor duty cycles, choosing the Motor function from their signs.
+// Returns 0 if the Motor driver rejected the command.
+static uint8_t Command_Protocol_Apply_Motors(int16_t left_duty_cycle, int16_t right_duty_cycle)
+{
+    // Stop the motion sequence so that it does not override the new command
+    Motion_Sequencer_Abort();
+
+    if ((left_duty_cycle == 0) && (right_duty_cycle == 0))
+    {
+        Motor_Stop();
+        return 1;
+    }
+    else if ((left_duty_cycle >= 0) && (right_duty_cycle >= 0))
+    {
+        return Motor_Forward(left_duty_cycle, right_duty_cycle);
+    }
+    else if ((left_duty_cycle < 0) && (right_duty_cycle < 0))
+    {
+        return Motor_Backward(-left_duty_cycle, -right_duty_cycle);
+    }
+    else if (left_duty_cycle >= 0)
+    {
+        return Motor_Right(left_duty_cycle, -right_duty_cycle);
+    }
+    else
+    {
+        return Motor_Left(-left_duty_cycle, right_duty_cycle);
+    }
+}
+
+static uint8_t Command_Protocol_Set_Setpoints(const uint8_t *payload, uint8_t length)
+{
+    int16_t left_duty_cycle;
+    int16_t right_duty_cycle;
+    uint8_t motors_changed = 0;
+    uint8_t target;
+    int32_t value;
+    int i;
+
+    if ((length == 0) || ((length % COMMAND_PROTOCOL_SETPOINT_SIZE) != 0)) return COMMAND_PROTOCOL_BAD_LENGTH;
+
+    // Check every entry first, so that an invalid frame has no effect
+    for (i = 0; i < length; i = i + COMMAND_PROTOCOL_SETPOINT_SIZE)
+    {
+        if (Command_Protocol_Check_Setpoint(payload[i], Read_S32(&payload[i + 1])) == 0) return COMMAND_PROTOCOL_BAD_SETPOINT;
+    }
+
+    // Keep the duty cycle of a motor that is not in the frame
+    Motor_Get_Duty_Cycles(&left_duty_cycle, &right_duty_cycle);
+
+    for (i = 0; i < length; i = i + COMMAND_PROTOCOL_SETPOINT_SIZE)
+    {
+        target = payload[i];
+        value = Read_S32(&payload[i + 1]);
+
+        switch (target & 0xF0)
+        {
+            case COMMAND_PROTOCOL_MOTOR_LEFT:
+                if (target == COMMAND_PROTOCOL_MOTOR_LEFT)
+                {
+                    left_duty_cycle = (int16_t)value;
+                }
+                else
+                {
+                    right_duty_cycle = (int16_t)value;
+                }
+                motors_changed = 1;
+                break;
+
+            case COMMAND_PROTOCOL_SERVO_ANGLE:
+                Servo_Angle_Move((Servo_Trajectory_ID)(target & 0x0F), (uint32_t)value);
+                break;
+
+            case COMMAND_PROTOCOL_SERVO_COUNTS:
+                Servo_Trajectory_Move((Servo_Trajectory_ID)(target & 0x0F), (uint16_t)value);
+                break;
+
+            case COMMAND_PROTOCOL_TASK_PERIOD:
+                Task_Scheduler_Set_Period((int8_t)(target & 0x0F), (uint16_t)value);
+                break;
+        }
+    }
+
+    // Both motors are committed together
+    if (motors_changed)
+    {
+        if (Command_Protocol_Apply_Motors(left_duty_cycle, right_duty_cycle) == 0) return COMMAND_PROTOCOL_COMMIT_FAILED;
+    }
+
+    return COMMAND_PROTOCOL_OK;
+}
+
+// Execute the received frame and send its reply
+static void Command_Protocol_Execute(void)
+{
+    uint8_t reply[1 + 20];
+    uint8_t *position = &reply[1];
+    int16_t left_duty_cycle;
+    int16_t right_duty_cycle;
+    uint8_t servo_done = 0;
+    int i;
+
+    reply[0] = COMMAND_PROTOCOL_OK;
+
+    // Commands without a payload reject a payload before they are executed
+    if (((FRAME_OPCODE == COMMAND_PROTOCOL_PING) || (FRAME_OPCODE == COMMAND_PROTOCOL_STOP) ||
+         (FRAME_OPCODE == COMMAND_PROTOCOL_GET_STATE)) && (FRAME_LENGTH != 0))
+    {
+        reply[0] = COMMAND_PROTOCOL_BAD_LENGTH;
+        Command_Protocol_Reply(FRAME_OPCODE, reply, 1);
+        return;
+    }
+
+    switch (FRAME_OPCODE)
+    {
+        case COMMAND_PROTOCOL_PING:
+            *position = COMMAND_PROTOCOL_VERSION;
+            position = position + 1;
+            break;
+
+        case COMMAND_PROTOCOL_STOP:
+            Motion_Sequencer_Abort();
+            Motor_Stop();
+            break;
+
+        case COMMAND_PROTOCOL_SET_SETPOINTS:
+            reply[0] = Command_Protocol_Set_Setpoints(FRAME_PAYLOAD, FRAME_LENGTH);
+            break;
+
+        case COMMAND_PROTOCOL_GET_STATE:
+            Motor_Get_Duty_Cycles(&left_duty_cycle, &right_duty_cycle);
+            position = Write_U32(position, Task_Scheduler_Get_Ticks());
+            position = Write_U16(position, (uint16_t)left_duty_cycle);
+            position = Write_U16(position, (uint16_t)right_duty_cycle);
+            for (i = 0; i < SERVO_TRAJECTORY_NUM_SERVOS; i = i + 1)
+            {
+                position = Write_U16(position, Servo_Trajectory_Get_Position((Servo_Trajectory_ID)i));
+                if (Servo_Trajectory_Is_Done((Servo_Trajectory_ID)i))
+                {
+                    servo_done |= (1 << i);
+                }
+            }
+            *position = servo_done;
+            position = position + 1;
+            position = Write_U16(position, (uint16_t)Task_Scheduler_Get_Sleep_Permille());
+            position = Write_U16(position, (Stats.crc_error_count > 0xFFFF) ? 0xFFFF : (uint16_t)Stats.crc_error_count);
+            break;
+
+        default:
+            reply[0] = COMMAND_PROTOCOL_UNKNOWN_OPCODE;
+            break;
+    }
+
+    Command_Protocol_Reply(FRAME_OPCODE, reply, (uint8_t)(position - reply));
+}
+
+void Command_Protocol_Init(void)
+{
+    State = PARSER_WAIT_SYNC;
+    Stats.frame_count = 0;
+    Stats.crc_error_count = 0;
+    Stats.timeout_count = 0;
+}
+
+void Command_Protocol_Process(void)
+{
+    char character;
+    uint8_t data;
+
+    // Discard a frame that stopped arriving, so that the following bytes are parsed again
+    if ((State != PARSER_WAIT_SYNC) &&
+        (Cycle_Counter_Elapsed(Frame_Start_Cycles) > (Clock_GetFreq() / 1000) * COMMAND_PROTOCOL_TIMEOUT_MS))
+    {
+        State = PARSER_WAIT_SYNC;
+        Stats.timeout_count = Stats.timeout_count + 1;
+    }
+
+    while (EUSCI_A0_UART_Try_InChar(&character))
+    {
+        data = (uint8_t)character;
+
+        switch (State)
+        {
+            case PARSER_WAIT_SYNC:
+                if (data == COMMAND_PROTOCOL_SYNC)
+                {
+                    Frame_Start_Cycles = Cycle_Counter_Read();
+                    State = PARSER_LENGTH;
+                }
+                else
+                {
+                    // Not part of a frame: pass it to the text console
+                    EUSCI_A0_UART_Process_Char(character);
+                }
+                break;
+
+            case PARSER_LENGTH:
+                FRAME_LENGTH = data;
+                State = (data <= COMMAND_PROTOCOL_MAX_PAYLOAD) ? PARSER_OPCODE : PARSER_WAIT_SYNC;
+                break;
+
+            case PARSER_OPCODE:
+                FRAME_OPCODE = data;
+                Payload_Index = 0;
+                State = (FRAME_LENGTH != 0) ? PARSER_PAYLOAD : PARSER_CRC_LOW;
+                break;
+
+            case PARSER_PAYLOAD:
+                FRAME_PAYLOAD[Payload_Index] = data;
+                Payload_Index = Payload_Index + 1;
+                if (Payload_Index == FRAME_LENGTH)
+                {
+                    State = PARSER_CRC_LOW;
+                }
+                break;
+
+            case PARSER_CRC_LOW:
+                Received_CRC = data;
+                State = PARSER_CRC_HIGH;
+                break;
+
+            case PARSER_CRC_HIGH:
+                Received_CRC |= (uint16_t)data << 8;
+                State = PARSER_WAIT_SYNC;
+
+                if (Received_CRC == CRC16_Update(CRC16_INIT, Frame, 2 + FRAME_LENGTH))
+                {
+                    Stats.frame_count = Stats.frame_count + 1;
+                    Command_Protocol_Execute();
+                }
+                else
+                {
+                    Stats.crc_error_count = Stats.crc_error_count + 1;
+                }
+                break;
+        }
+    }
+}
+
+void Command_Protocol_Get_Stats(Command_Protocol_Stats *stats)
+{
+    *stats = Stats;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file Cycle_Counter.c
+ * @brief Source code for the Cycle_Counter driver.
+ *
+ * This file contains the function definitions for the Cycle_Counter driver.
+ * It uses the Data Watchpoint and Trace (DWT) unit of the Cortex-M4 to count processor clock cycles,
+ * and it records the execution time of the interrupt service routines used in this lab.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Cycle_Counter.h"
+
+// Execution time record for a single profiled interrupt service routine
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+    uint16_t next_sample;
+    uint32_t samples[ISR_PROFILE_NUM_SAMPLES];
+} ISR_Profile_Record_Type;
+
+static ISR_Profile_Record_Type ISR_Profiles[ISR_PROFILE_COUNT];
+
+// Number of clock cycles taken by a back-to-back pair of Cycle_Counter_Read calls
+static uint32_t Measurement_Overhead_Cycles = 0;
+
+void Cycle_Counter_Init(void)
+{
+    uint32_t start_cycles;
+
+    // Enable the trace subsystem, which powers the DWT unit
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    // Clear the cycle counter and enable it
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // Measure the cost of the instrumentation itself so that it can be removed from each sample
+    start_cycles = Cycle_Counter_Read();
+    Measurement_Overhead_Cycles = Cycle_Counter_Read() - start_cycles;
+
+    ISR_Profile_Reset();
+}
+
+uint32_t Cycle_Counter_Elapsed(uint32_t start_cycles)
+{
+    return (Cycle_Counter_Read() - start_cycles);
+}
+
+void ISR_Profile_Record(ISR_Profile_ID id, uint32_t cycles)
+{
+    ISR_Profile_Record_Type *profile = &ISR_Profiles[id];
+
+    // Remove the measurement overhead from the sample
+    if (cycles > Measurement_Overhead_Cycles)
+    {
+        cycles = cycles - Measurement_Overhead_Cycles;
+    }
+    else
+    {
+        cycles = 0;
+    }
+
+    if (cycles < profile->min_cycles)
+    {
+        profile->min_cycles = cycles;
+    }
+
+    if (cycles > profile->max_cycles)
+    {
+        profile->max_cycles = cycles;
+    }
+
+    profile->sum_cycles = profile->sum_cycles + cycles;
+    profile->count = profile->count + 1;
+
+    // Store the sample in the ring of recent samples
+    profile->samples[profile->next_sample] = cycles;
+    profile->next_sample = (profile->next_sample + 1) % ISR_PROFILE_NUM_SAMPLES;
+}
+
+void ISR_Profile_Get_Stats(ISR_Profile_ID id, ISR_Profile_Stats *stats)
+{
+    static uint32_t sorted_samples[ISR_PROFILE_NUM_SAMPLES];
+    ISR_Profile_Record_Type *profile = &ISR_Profiles[id];
+    uint64_t sum_cycles;
+    uint32_t num_samples;
+    uint32_t value;
+    uint32_t i;
+    int j;
+    long sr;
+
+    // Take a consistent snapshot of the record since the interrupt service routine may update it
+    sr = StartCritical();
+    stats->count = profile->count;
+    stats->min_cycles = profile->min_cycles;
+    stats->max_cycles = profile->max_cycles;
+    sum_cycles = profile->sum_cycles;
+    num_samples = (profile->count < ISR_PROFILE_NUM_SAMPLES) ? profile->count : ISR_PROFILE_NUM_SAMPLES;
+    for (i = 0; i < num_samples; i = i + 1)
+    {
+        sorted_samples[i] = profile->samples[i];
+    }
+    EndCritical(sr);
+
+    if (stats->count == 0)
+    {
+        stats->min_cycles = 0;
+        stats->mean_cycles = 0;
+        stats->p99_cycles = 0;
+        return;
+    }
+
+    stats->mean_cycles = (uint32_t)(sum_cycles / stats->count);
+
+    // Insertion sort is sufficient for a few hundred samples and runs outside of interrupt context
+    for (i = 1; i < num_samples; i = i + 1)
+    {
+        value = sorted_samples[i];
+        j = i - 1;
+        while ((j >= 0) && (sorted_samples[j] > value))
+        {
+            sorted_samples[j + 1] = sorted_samples[j];
+            j = j - 1;
+        }
+        sorted_samples[j + 1] = value;
+    }
+
+    // Nearest-rank 99th percentile of the recent samples
+    stats->p99_cycles = sorted_samples[((num_samples * 99) + 99) / 100 - 1];
+}
+
+void ISR_Profile_Reset(void)
+{
+    int i;
+    long sr;
+
+    sr = StartCritical();
+    for (i = 0; i < ISR_PROFILE_COUNT; i = i + 1)
+    {
+        ISR_Profiles[i].count = 0;
+        ISR_Profiles[i].min_cycles = 0xFFFFFFFF;
+        ISR_Profiles[i].max_cycles = 0;
+        ISR_Profiles[i].sum_cycles = 0;
+        ISR_Profiles[i].next_sample = 0;
+    }
+    EndCritical(sr);
+}
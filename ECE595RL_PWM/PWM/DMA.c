@@ -0,0 +1,136 @@
+/**
+ * @file DMA.c
+ * @brief Source code for the DMA driver.
+ *
+ * This file contains the function definitions for the DMA driver.
+ * It configures the micro Direct Memory Access (uDMA) controller to move blocks of bytes
+ * from memory to peripheral transmit buffers.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/DMA.h"
+
+// Channel control structure, as defined by the uDMA controller
+typedef struct
+{
+    volatile uint32_t source_end;
+    volatile uint32_t destination_end;
+    volatile uint32_t control;
+    volatile uint32_t unused;
+} DMA_Control_Structure;
+
+// Primary control structures of all channels followed by the alternate control structures.
+// The controller requires the table to be aligned to its size.
+static DMA_Control_Structure DMA_Control_Table[2 * DMA_NUM_CHANNELS] __attribute__((aligned(2 * DMA_NUM_CHANNELS * 16)));
+
+// Callback of the transfer in progress on each channel
+static void (*DMA_Done_Tasks[DMA_NUM_CHANNELS])(void);
+
+// Bit n is set while a transfer is in progress on channel n
+static volatile uint32_t Busy_Channels = 0;
+
+void DMA_Init(void)
+{
+    // Set the base address of the channel control table
+    DMA_Control->CTLBASE = (uint32_t)(uintptr_t)DMA_Control_Table;
+
+    // Enable the uDMA controller (MASTEN bit)
+    DMA_Control->CFG = 0x01;
+
+    // Set interrupt priority level to 3
+    NVIC->IP[8] = (NVIC->IP[8] & 0xFF00FFFF) | 0x00600000;
+
+    // Enable Interrupt 34 in NVIC
+    NVIC->ISER[1] = 0x00000004;
+}
+
+uint8_t DMA_Transfer_To_Peripheral(uint8_t channel, uint8_t source, const uint8_t *source_buffer,
+                                   volatile void *destination_register, uint16_t size, void (*done_task)(void))
+{
+    uint32_t channel_bit;
+    long sr;
+
+    if ((channel >= DMA_NUM_CHANNELS) || (size == 0) || (size > DMA_MAX_TRANSFER_SIZE)) return 0;
+
+    channel_bit = 1 << channel;
+
+    sr = StartCritical();
+    if (Busy_Channels & channel_bit)
+    {
+        EndCritical(sr);
+        return 0;
+    }
+    Busy_Channels |= channel_bit;
+    EndCritical(sr);
+
+    DMA_Done_Tasks[channel] = done_task;
+
+    // The controller uses the address of the last item of the source and destination
+    DMA_Control_Table[channel].source_end = (uint32_t)(uintptr_t)(source_buffer + size - 1);
+    DMA_Control_Table[channel].destination_end = (uint32_t)(uintptr_t)destination_register;
+
+//     Control Word Configuration
+//
+//      Bit(s)      Field           Value       Description
+//      -----       -----           -----       -----------
+//      31-30       DST_INC          0x3        Destination address is not incremented
+//      29-28       DST_SIZE         0x0        Destination data size is 8 bits
+//      27-26       SRC_INC          0x0        Source address is incremented by 1 byte
+//      25-24       SRC_SIZE         0x0        Source data size is 8 bits
+//      17-14       R_POWER          0x0        Arbitrate after each item, so that one item is moved per request
+//      13-4        N_MINUS_1        size - 1   Number of items to transfer, minus 1
+//      3           NXT_USEBURST     0x0        Single requests are used
+//      2-0         CYCLE_CTRL       0x1        Basic mode
+    DMA_Control_Table[channel].control = 0xC0000000 | ((uint32_t)(size - 1) << 4) | 0x01;
+
+    // Select the trigger source of the channel
+    DMA_Channel->CH_SRCCFG[channel] = source;
+
+    // Use the primary control structure, default priority, and both single and burst requests
+    DMA_Control->ALTCLR = channel_bit;
+    DMA_Control->PRIOCLR = channel_bit;
+    DMA_Control->USEBURSTCLR = channel_bit;
+    DMA_Control->REQMASKCLR = channel_bit;
+
+    // Clear a stale completion flag, then enable the channel
+    DMA_Channel->INT0_CLRFLG = channel_bit;
+    DMA_Control->ENASET = channel_bit;
+
+    return 1;
+}
+
+uint8_t DMA_Is_Busy(uint8_t channel)
+{
+    return ((Busy_Channels >> channel) & 0x01);
+}
+
+void DMA_INT0_IRQHandler(void)
+{
+    uint32_t completed_channels;
+    int channel;
+
+    ISR_PROFILE_BEGIN();
+
+    // Handle only the channels that have a transfer in progress
+    completed_channels = DMA_Channel->INT0_SRCFLG & Busy_Channels;
+
+    for (channel = 0; channel < DMA_NUM_CHANNELS; channel = channel + 1)
+    {
+        if (completed_channels & (1 << channel))
+        {
+            // Acknowledge the completion of the channel and clear it
+            DMA_Channel->INT0_CLRFLG = (1 << channel);
+            Busy_Channels &= ~(1 << channel);
+
+            // Execute the user-defined task
+            if (DMA_Done_Tasks[channel] != 0)
+            {
+                (*DMA_Done_Tasks[channel])();
+            }
+        }
+    }
+
+    ISR_PROFILE_END(ISR_PROFILE_DMA_INT0);
+}
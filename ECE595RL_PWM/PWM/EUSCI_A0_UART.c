@@ -15,22 +15,42 @@
 
 #include "../inc/EUSCI_A0_UART.h"
 
+// Ring buffers of EUSCI_A0. Bytes are added to the transmit ring buffer by EUSCI_A0_UART_OutChar and to the receive
+// ring buffer by EUSCIA0_IRQHandler. Received bytes are removed by EUSCI_A0_UART_InChar, EUSCI_A0_UART_Try_InChar,
+// or EUSCI_A0_UART_Process_Input.
+static uint8_t TX_Buffer[EUSCI_A0_UART_TX_BUFFER_SIZE];
+static uint8_t RX_Buffer[EUSCI_A0_UART_RX_BUFFER_SIZE];
+static EUSCI_A_UART_Port EUSCI_A0_Port;
+
+// Block transmitted by EUSCI_A0_UART_Write_DMA and its completion callback
+static const uint8_t *DMA_Data;
+static uint16_t DMA_Size;
+static void (*DMA_Done_Task)(void);
+
+// Line being edited by EUSCI_A0_UART_Process_Input
+static char Line_Buffer[EUSCI_A0_UART_LINE_BUFFER_SIZE];
+static uint16_t Line_Length = 0;
+
+// User-defined task executed when a full line has been received
+static void (*Line_Task)(char *line, uint16_t length) = 0;
+
+// Buffer of stdout, set by EUSCI_A0_UART_Init_Printf
+static char Printf_Buffer[EUSCI_A0_UART_PRINTF_BUFFER_SIZE];
+
 void EUSCI_A0_UART_Init()
 {
     // Hold the EUSCI_A0 module in reset mode
     EUSCI_A0->CTLW0 |= 1;
 
-    // Set all the bits of the modulation control register to zero
-    EUSCI_A0->MCTLW |= 0;
-
     // Hold the EUSCI_A0 module in reset mode
     // Set the clock source to SMCLK
-    EUSCI_A0->CTLW0 |= 0x00C1;
+    // Pass characters with receive errors to the receive interrupt (UCRXEIE) so that they are counted
+    EUSCI_A0->CTLW0 |= 0x00E1;
 
-    // Set the baud rate
+    // Set the baud rate with the fractional divider
     // N = (Clock Frequency) / (Baud Rate) = (12,000,000 / 115,200) = 104.1667
-    // Use only the integer part, so N = 104
-    EUSCI_A0->BRW |= 104;
+    // UCOS16 = 1, UCBRx = 6, UCBRFx = 8, UCBRSx = 0x20
+    EUSCI_A_UART_Set_Baud_Rate(EUSCI_A0, Clock_GetSMCLKFreq(), EUSCI_A0_UART_BAUD_RATE);
 
     // Configure P1.2 and P1.3 as primary module function
     P1->SEL0 |= 0x0C;
@@ -39,26 +59,195 @@ void EUSCI_A0_UART_Init()
     // Clear the software reset bit to enable the EUSCI_A0 module
     EUSCI_A0->CTLW0 &= ~1;
 
-    // Ensure that the following interrupts are disabled:
-    // - Receive Interrupt
-    // - Transmit Interrupt
-    // - Start Bit Interrupt
-    // - Transmit Complete Interrupt
-    EUSCI_A0->IE &= ~0xF;
+    // Empty the transmit and receive ring buffers and enable the receive interrupt
+    EUSCI_A_UART_Init_Port(&EUSCI_A0_Port, EUSCI_A0,
+                           TX_Buffer, EUSCI_A0_UART_TX_BUFFER_SIZE,
+                           RX_Buffer, EUSCI_A0_UART_RX_BUFFER_SIZE);
+
+    // Empty the line buffer
+    Line_Length = 0;
+
+    // Set interrupt priority level to 3, below the bumper sensors and Timer A1
+    NVIC->IP[4] = (NVIC->IP[4] & 0xFFFFFF00) | 0x00000060;
+
+    // Enable Interrupt 16 in NVIC
+    NVIC->ISER[0] = 0x00010000;
+}
+
+uint8_t EUSCI_A0_UART_Set_Baud_Rate(uint32_t baud_rate)
+{
+    return EUSCI_A_UART_Change_Baud_Rate(&EUSCI_A0_Port, Clock_GetSMCLKFreq(), baud_rate);
+}
+
+void EUSCI_A0_UART_Set_TX_Overflow_Policy(EUSCI_A0_UART_TX_Overflow_Policy policy)
+{
+    EUSCI_A_UART_Set_TX_Overflow_Policy(&EUSCI_A0_Port, policy);
+}
+
+uint32_t EUSCI_A0_UART_Get_TX_Dropped_Count()
+{
+    return EUSCI_A0_Port.stats.tx_dropped_count;
+}
+
+uint16_t EUSCI_A0_UART_Get_TX_Free_Space()
+{
+    return EUSCI_A_UART_Get_TX_Free_Space(&EUSCI_A0_Port);
+}
+
+void EUSCI_A0_UART_Flush()
+{
+    EUSCI_A_UART_Flush(&EUSCI_A0_Port);
+}
+
+uint32_t EUSCI_A0_UART_Get_RX_Dropped_Count()
+{
+    return EUSCI_A0_Port.stats.rx_dropped_count;
+}
+
+void EUSCI_A0_UART_Get_Stats(EUSCI_A_UART_Stats *stats)
+{
+    EUSCI_A_UART_Get_Stats(&EUSCI_A0_Port, stats);
+}
+
+uint8_t EUSCI_A0_UART_Try_InChar(char *letter)
+{
+    return EUSCI_A_UART_Try_Read_Byte(&EUSCI_A0_Port, (uint8_t *)letter);
+}
+
+uint16_t EUSCI_A0_UART_Write_Bytes(const uint8_t *data, uint16_t length)
+{
+    return EUSCI_A_UART_Write(&EUSCI_A0_Port, data, length);
+}
+
+// Called from DMA_INT0_IRQHandler when the block has been written to TXBUF
+static void EUSCI_A0_UART_DMA_Done(void)
+{
+    EUSCI_A_UART_Release_TX(&EUSCI_A0_Port);
+
+    if (DMA_Done_Task != 0)
+    {
+        (*DMA_Done_Task)();
+    }
+}
+
+// Called by the EUSCI_A_UART driver once the transmit ring buffer is empty
+static void EUSCI_A0_UART_Start_DMA(void)
+{
+    if (DMA_Transfer_To_Peripheral(EUSCI_A0_UART_DMA_CHANNEL, EUSCI_A0_UART_DMA_SOURCE, DMA_Data,
+                                   &EUSCI_A0->TXBUF, DMA_Size, &EUSCI_A0_UART_DMA_Done) == 0)
+    {
+        // The channel is used by another transfer, so give the transmitter back and drop the block
+        EUSCI_A0_UART_DMA_Done();
+    }
+}
+
+uint8_t EUSCI_A0_UART_Write_DMA(const uint8_t *data, uint16_t size, void (*done_task)(void))
+{
+    long sr;
+
+    if ((size == 0) || (size > DMA_MAX_TRANSFER_SIZE)) return 0;
+
+    sr = StartCritical();
+
+    // The parameters of a pending block must not be replaced
+    if (EUSCI_A_UART_Is_TX_Handoff_Busy(&EUSCI_A0_Port))
+    {
+        EndCritical(sr);
+        return 0;
+    }
+
+    DMA_Data = data;
+    DMA_Size = size;
+    DMA_Done_Task = done_task;
+    EUSCI_A_UART_Request_TX_Handoff(&EUSCI_A0_Port, &EUSCI_A0_UART_Start_DMA);
+
+    EndCritical(sr);
+
+    return 1;
+}
+
+uint16_t EUSCI_A0_UART_Read_Bytes(uint8_t *data, uint16_t max)
+{
+    return EUSCI_A_UART_Read(&EUSCI_A0_Port, data, max);
 }
 
 char EUSCI_A0_UART_InChar()
 {
-    while((EUSCI_A0->IFG & 0x01) == 0);
+    char letter;
+    long sr;
+
+    // Sleep until the receive interrupt has added a character to the ring buffer.
+    // The ring buffer is checked with interrupts disabled, so a character received right after the check
+    // still wakes up the CPU. Its handler runs when interrupts are enabled again, before the next check.
+    sr = StartCritical();
+    while (EUSCI_A0_UART_Try_InChar(&letter) == 0)
+    {
+        WaitForInterrupt();
+        EndCritical(sr);
+        sr = StartCritical();
+    }
+    EndCritical(sr);
+
+    return letter;
+}
 
-    return((char)(EUSCI_A0->RXBUF));
+void EUSCI_A0_UART_Set_Line_Task(void (*line_task)(char *line, uint16_t length))
+{
+    Line_Task = line_task;
+}
+
+void EUSCI_A0_UART_Process_Input()
+{
+    char character;
+
+    while (EUSCI_A0_UART_Try_InChar(&character))
+    {
+        EUSCI_A0_UART_Process_Char(character);
+    }
+}
+
+void EUSCI_A0_UART_Process_Char(char character)
+{
+    if (character == CR)
+    {
+        Line_Buffer[Line_Length] = 0;
+        EUSCI_A0_UART_OutChar(CR);
+        EUSCI_A0_UART_OutChar(LF);
+
+        if (Line_Task != 0)
+        {
+            (*Line_Task)(Line_Buffer, Line_Length);
+        }
+        Line_Length = 0;
+    }
+    else if ((character == BS) || (character == DEL))
+    {
+        if (Line_Length)
+        {
+            Line_Length--;
+            EUSCI_A0_UART_OutChar(BS);
+        }
+    }
+    else if ((character != LF) && (Line_Length < (EUSCI_A0_UART_LINE_BUFFER_SIZE - 1)))
+    {
+        Line_Buffer[Line_Length] = character;
+        Line_Length++;
+        EUSCI_A0_UART_OutChar(character);
+    }
 }
 
 void EUSCI_A0_UART_OutChar(char letter)
 {
-    while((EUSCI_A0->IFG & 0x02) == 0);
+    EUSCI_A_UART_Write_Byte(&EUSCI_A0_Port, (uint8_t)letter);
+}
+
+void EUSCIA0_IRQHandler(void)
+{
+    ISR_PROFILE_BEGIN();
+
+    EUSCI_A_UART_IRQ_Handler(&EUSCI_A0_Port);
 
-    EUSCI_A0->TXBUF = letter;
+    ISR_PROFILE_END(ISR_PROFILE_EUSCIA0);
 }
 
 void EUSCI_A0_UART_InString(char *bufPt, uint16_t max)
@@ -131,32 +320,26 @@ uint32_t EUSCI_A0_UART_InUDec()
 
 void EUSCI_A0_UART_OutUDec(uint32_t n)
 {
-    if (n >= 10)
-    {
-        EUSCI_A0_UART_OutUDec(n/10);
-        n = n%10;
-    }
-    EUSCI_A0_UART_OutChar(n + '0'); /* n is between 0 and 9 */
+    char buffer[FORMAT_BUFFER_SIZE];
+
+    Format_UDec(buffer, n);
+    EUSCI_A0_UART_OutString(buffer);
 }
 
 void EUSCI_A0_UART_OutSDec(int32_t n)
 {
-    if (n < 0)
-    {
-        EUSCI_A0_UART_OutChar('-');
-        EUSCI_A0_UART_OutUDec(-n);
-    }
-    else
-    {
-        EUSCI_A0_UART_OutUDec(n);
-    }
+    char buffer[FORMAT_BUFFER_SIZE];
+
+    Format_SDec(buffer, n);
+    EUSCI_A0_UART_OutString(buffer);
 }
 
 void EUSCI_A0_UART_OutUFix(uint32_t n)
 {
-    EUSCI_A0_UART_OutUDec(n/10);
-    EUSCI_A0_UART_OutChar('.');
-    EUSCI_A0_UART_OutUDec(n%10);
+    char buffer[FORMAT_BUFFER_SIZE];
+
+    Format_UFix(buffer, n, 1, 0);
+    EUSCI_A0_UART_OutString(buffer);
 }
 
 uint32_t UART0_InUHex()
@@ -204,24 +387,10 @@ uint32_t UART0_InUHex()
 
 void EUSCI_A0_UART_OutUHex(uint32_t number)
 {
-    // Use recursion to convert the number of
-    // unspecified length as an ASCII string
-    if (number >= 0x10)
-    {
-        EUSCI_A0_UART_OutUHex(number/0x10);
-        EUSCI_A0_UART_OutUHex(number%0x10);
-    }
-    else
-    {
-        if (number < 0xA)
-        {
-            EUSCI_A0_UART_OutChar(number+'0');
-        }
-        else
-        {
-            EUSCI_A0_UART_OutChar((number-0x0A)+'A');
-        }
-    }
+    char buffer[FORMAT_BUFFER_SIZE];
+
+    Format_UHex(buffer, number);
+    EUSCI_A0_UART_OutString(buffer);
 }
 
 int EUSCI_A0_UART_Open(const char *path, unsigned flags, int llv_fd)
@@ -240,7 +409,7 @@ int EUSCI_A0_UART_Read(int dev_fd, char *buf, unsigned count)
     char ch = EUSCI_A0_UART_InChar();
 
     // Return by reference
-    ch = *buf;
+    *buf = ch;
 
     // Output the received char from the serial terminal
     EUSCI_A0_UART_OutChar(ch);
@@ -250,18 +419,28 @@ int EUSCI_A0_UART_Read(int dev_fd, char *buf, unsigned count)
 
 int EUSCI_A0_UART_Write(int dev_fd, const char *buf, unsigned count)
 {
-    unsigned int num = count;
+    unsigned int start = 0;
+    unsigned int i;
 
-    while(num)
+    // Copy each run of characters to the transmit ring buffer as a block, and send a carriage return before each newline
+    for (i = 0; i < count; i = i + 1)
     {
-        if(*buf == 10)
+        if (buf[i] == 10)
         {
-            EUSCI_A0_UART_OutChar(13);
+            if (i > start)
+            {
+                EUSCI_A0_UART_Write_Bytes((const uint8_t *)&buf[start], i - start);
+            }
+            EUSCI_A0_UART_Write_Bytes((const uint8_t *)"\r\n", 2);
+            start = i + 1;
         }
-        EUSCI_A0_UART_OutChar(*buf);
-        buf++;
-        num--;
     }
+
+    if (count > start)
+    {
+        EUSCI_A0_UART_Write_Bytes((const uint8_t *)&buf[start], count - start);
+    }
+
     return count;
 }
 
@@ -306,6 +485,7 @@ void EUSCI_A0_UART_Init_Printf()
     // Redirect stdout to UART
     freopen("uart:", "w", stdout);
 
-    // Turn off buffering for stdout
-    setvbuf(stdout, NULL, _IONBF, 0);
+    // Make stdout line buffered, so that printf hands a whole line to EUSCI_A0_UART_Write
+    // instead of one character at a time
+    setvbuf(stdout, Printf_Buffer, _IOLBF, sizeof(Printf_Buffer));
 }
@@ -17,23 +17,27 @@
 
 #include "../inc/EUSCI_A2_UART.h"
 
+// Ring buffers of EUSCI_A2. Bytes are added to the transmit ring buffer by EUSCI_A2_UART_OutChar or EUSCI_A2_UART_Write
+// and to the receive ring buffer by EUSCIA2_IRQHandler.
+static uint8_t TX_Buffer[EUSCI_A2_UART_TX_BUFFER_SIZE];
+static uint8_t RX_Buffer[EUSCI_A2_UART_RX_BUFFER_SIZE];
+static EUSCI_A_UART_Port EUSCI_A2_Port;
+
 void EUSCI_A2_UART_Init()
 {
     // Hold the EUSCI_A2 module in reset mode
     EUSCI_A2->CTLW0 |= 0x01;
 
-    // Set all the bits of the modulation control register to zero
-    EUSCI_A2->MCTLW &= ~0xFF;
-
     // Hold the EUSCI_A2 module in reset mode
     // Set the clock source to SMCLK
     // MSB first
-    EUSCI_A2->CTLW0 |= 0x20C1;
+    // Pass characters with receive errors to the receive interrupt (UCRXEIE) so that they are counted
+    EUSCI_A2->CTLW0 |= 0x20E1;
 
-    // Set the baud rate
+    // Set the baud rate with the fractional divider
     // N = (Clock Frequency) / (Baud Rate) = (12,000,000 / 115,200) = 104.1667
-    // Use only the integer part, so N = 104
-    EUSCI_A2->BRW |= 104;
+    // UCOS16 = 1, UCBRx = 6, UCBRFx = 8, UCBRSx = 0x20
+    EUSCI_A_UART_Set_Baud_Rate(EUSCI_A2, Clock_GetSMCLKFreq(), EUSCI_A2_UART_BAUD_RATE);
 
     // Configure P3.2 and P3.3 as primary module function
     P3->SEL0 |= 0x0C;
@@ -42,22 +46,93 @@ void EUSCI_A2_UART_Init()
     // Clear the software reset bit to enable the EUSCI_A2 module
     EUSCI_A2->CTLW0 &= ~0x01;
 
-    // Ensure that the following interrupts are disabled:
-    // - Receive Interrupt
-    // - Transmit Interrupt
-    // - Start Bit Interrupt
-    // - Transmit Complete Interrupt
-    EUSCI_A2->IE &= ~0x0F;
+    // Empty the transmit and receive ring buffers and enable the receive interrupt
+    EUSCI_A_UART_Init_Port(&EUSCI_A2_Port, EUSCI_A2,
+                           TX_Buffer, EUSCI_A2_UART_TX_BUFFER_SIZE,
+                           RX_Buffer, EUSCI_A2_UART_RX_BUFFER_SIZE);
+
+    // Set interrupt priority level to 3, below the bumper sensors and Timer A1
+    NVIC->IP[4] = (NVIC->IP[4] & 0xFF00FFFF) | 0x00600000;
+
+    // Enable Interrupt 18 in NVIC
+    NVIC->ISER[0] = 0x00040000;
+}
+
+uint8_t EUSCI_A2_UART_Set_Baud_Rate(uint32_t baud_rate)
+{
+    return EUSCI_A_UART_Change_Baud_Rate(&EUSCI_A2_Port, Clock_GetSMCLKFreq(), baud_rate);
+}
+
+void EUSCI_A2_UART_Set_TX_Overflow_Policy(EUSCI_A_UART_TX_Overflow_Policy policy)
+{
+    EUSCI_A_UART_Set_TX_Overflow_Policy(&EUSCI_A2_Port, policy);
 }
 
 void EUSCI_A2_UART_OutChar(uint8_t data)
 {
-    while((EUSCI_A2->IFG & 0x02) == 0);
-    EUSCI_A2->TXBUF = data;
+    EUSCI_A_UART_Write_Byte(&EUSCI_A2_Port, data);
+}
+
+uint8_t EUSCI_A2_UART_Try_InChar(uint8_t *data)
+{
+    return EUSCI_A_UART_Try_Read_Byte(&EUSCI_A2_Port, data);
 }
 
 uint8_t EUSCI_A2_UART_InChar()
 {
-    while((EUSCI_A2->IFG & 0x01) == 0);
-    return EUSCI_A2->RXBUF;
+    uint8_t data;
+    long sr;
+
+    // Sleep until the receive interrupt has added a byte to the ring buffer.
+    // The ring buffer is checked with interrupts disabled, so a byte received right after the check
+    // still wakes up the CPU. Its handler runs when interrupts are enabled again, before the next check.
+    sr = StartCritical();
+    while (EUSCI_A_UART_Try_Read_Byte(&EUSCI_A2_Port, &data) == 0)
+    {
+        WaitForInterrupt();
+        EndCritical(sr);
+        sr = StartCritical();
+    }
+    EndCritical(sr);
+
+    return data;
+}
+
+uint16_t EUSCI_A2_UART_Write(const uint8_t *data, uint16_t length)
+{
+    return EUSCI_A_UART_Write(&EUSCI_A2_Port, data, length);
+}
+
+uint16_t EUSCI_A2_UART_Read(uint8_t *data, uint16_t max)
+{
+    return EUSCI_A_UART_Read(&EUSCI_A2_Port, data, max);
+}
+
+uint16_t EUSCI_A2_UART_Get_RX_Available()
+{
+    return EUSCI_A_UART_Get_RX_Available(&EUSCI_A2_Port);
+}
+
+uint16_t EUSCI_A2_UART_Get_TX_Free_Space()
+{
+    return EUSCI_A_UART_Get_TX_Free_Space(&EUSCI_A2_Port);
+}
+
+void EUSCI_A2_UART_Flush()
+{
+    EUSCI_A_UART_Flush(&EUSCI_A2_Port);
+}
+
+void EUSCI_A2_UART_Get_Stats(EUSCI_A_UART_Stats *stats)
+{
+    EUSCI_A_UART_Get_Stats(&EUSCI_A2_Port, stats);
+}
+
+void EUSCIA2_IRQHandler(void)
+{
+    ISR_PROFILE_BEGIN();
+
+    EUSCI_A_UART_IRQ_Handler(&EUSCI_A2_Port);
+
+    ISR_PROFILE_END(ISR_PROFILE_EUSCIA2);
 }
@@ -19,7 +19,7 @@
 
 #include "../inc/EUSCI_A3_SPI.h"
 
-void EUSCI_A3_SPI_Init()
+void EUSCI_A3_SPI_Init(uint32_t bit_rate)
 {
     // Hold the EUSCI_A3 module in reset mode
     EUSCI_A3->CTLW0 |= 0x01;
@@ -41,10 +41,8 @@ void EUSCI_A3_SPI_Init()
 //       0          UCSWRST      0x1        eUSCI logic held in reset state
     EUSCI_A3->CTLW0 |= 0xAD83;
 
-    // Set the baud rate. The clock frequency used is 1 MHz.
-    // N = (Clock Frequency) / (Baud Rate) = (12,000,000 / 1,000,000)
-    // N = 3
-    EUSCI_A3->BRW |= 12;
+    // Set the bit rate from the current SMCLK frequency
+    EUSCI_A3->BRW = EUSCI_A3_SPI_Prescaler(bit_rate);
 
     // Configure P9.4, P9.5, and P9.7 pins as primary module function
     P9->SEL0 |= 0xB0;
@@ -59,6 +57,37 @@ void EUSCI_A3_SPI_Init()
     EUSCI_A3->IE &= ~0x03;
 }
 
+uint16_t EUSCI_A3_SPI_Prescaler(uint32_t bit_rate)
+{
+    uint32_t smclk_frequency = Clock_GetSMCLKFreq();
+    uint32_t prescaler;
+
+    if (bit_rate == 0) return 0xFFFF;
+
+    // N = (Clock Frequency) / (Bit Rate), rounded up so that the bit rate does not exceed the requested rate
+    prescaler = (smclk_frequency + bit_rate - 1) / bit_rate;
+
+    if (prescaler < 1) prescaler = 1;
+    if (prescaler > 0xFFFF) prescaler = 0xFFFF;
+
+    return (uint16_t)prescaler;
+}
+
+uint32_t EUSCI_A3_SPI_Set_Bit_Rate(uint32_t bit_rate)
+{
+    uint16_t prescaler = EUSCI_A3_SPI_Prescaler(bit_rate);
+
+    // UCBUSY - Wait until the byte in progress has been shifted out
+    while((EUSCI_A3->STATW & 0x0001) == 0x0001);
+
+    // The bit rate can only be changed while the EUSCI_A3 module is held in reset mode
+    EUSCI_A3->CTLW0 |= 0x01;
+    EUSCI_A3->BRW = prescaler;
+    EUSCI_A3->CTLW0 &= ~0x01;
+
+    return (Clock_GetSMCLKFreq() / prescaler);
+}
+
 void EUSCI_A3_SPI_Command_Write(uint8_t command)
 {
     // UCBUSY - Wait until SPI is not busy
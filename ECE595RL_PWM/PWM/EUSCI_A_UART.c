@@ -0,0 +1,462 @@
+/**
+ * @file EUSCI_A_UART.c
+ * @brief Source code for the EUSCI_A_UART driver.
+ *
+ * This file contains the function definitions for the EUSCI_A_UART driver.
+ * It implements the ring buffers shared by the EUSCI_A0_UART and EUSCI_A2_UART drivers.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/EUSCI_A_UART.h"
+
+#define TX_NEXT(port, index)    (((index) + 1) & (port)->tx_mask)
+#define RX_NEXT(port, index)    (((index) + 1) & (port)->rx_mask)
+
+// Receive status bits of the STATW register
+#define STATW_UCBRK     0x08
+#define STATW_UCPE      0x10
+#define STATW_UCOE      0x20
+#define STATW_UCFE      0x40
+
+// States of the transmitter handoff
+#define TX_HANDOFF_NONE     0
+#define TX_HANDOFF_PENDING  1
+#define TX_HANDOFF_ACTIVE   2
+
+// Number of entries of the UCBRSx table
+#define UCBRS_TABLE_SIZE    36
+
+// Smallest fractional part of N, in units of 1/10000, that selects each UCBRSx value
+// (Table 24-4 of the MSP432P4xx Technical Reference Manual)
+static const uint16_t UCBRS_Fraction[UCBRS_TABLE_SIZE] =
+{
+       0,  529,  715,  835, 1001, 1252, 1430, 1670, 2147, 2224, 2503, 3000,
+    3335, 3575, 3753, 4003, 4286, 4378, 5002, 5715, 6003, 6254, 6432, 6667,
+    7001, 7147, 7503, 7861, 8004, 8333, 8464, 8572, 8751, 9004, 9170, 9288
+};
+
+static const uint8_t UCBRS_Pattern[UCBRS_TABLE_SIZE] =
+{
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x11, 0x21, 0x22, 0x44, 0x25,
+    0x49, 0x4A, 0x52, 0x92, 0x53, 0x55, 0xAA, 0x6B, 0xAD, 0xB5, 0xB6, 0xD6,
+    0xB7, 0xBB, 0xDD, 0xED, 0xEE, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE
+};
+
+void EUSCI_A_UART_Init_Port(EUSCI_A_UART_Port *port, EUSCI_A_Type *module,
+                            uint8_t *tx_buffer, uint16_t tx_size,
+                            uint8_t *rx_buffer, uint16_t rx_size)
+{
+    // Ensure that the following interrupts are disabled while the ring buffers are reset:
+    // - Receive Interrupt
+    // - Transmit Interrupt
+    // - Start Bit Interrupt
+    // - Transmit Complete Interrupt
+    // The transmit interrupt is enabled by EUSCI_A_UART_Write_Byte whenever the ring buffer holds data
+    module->IE &= ~0x0F;
+
+    port->module = module;
+    port->tx_buffer = tx_buffer;
+    port->tx_mask = tx_size - 1;
+    port->tx_head = 0;
+    port->tx_tail = 0;
+    port->rx_buffer = rx_buffer;
+    port->rx_mask = rx_size - 1;
+    port->rx_head = 0;
+    port->rx_tail = 0;
+    port->tx_overflow_policy = EUSCI_A_UART_TX_OVERFLOW_BLOCK;
+    port->tx_handoff_state = TX_HANDOFF_NONE;
+    port->tx_handoff_task = 0;
+
+    port->stats.tx_count = 0;
+    port->stats.rx_count = 0;
+    port->stats.tx_dropped_count = 0;
+    port->stats.rx_dropped_count = 0;
+    port->stats.rx_overrun_count = 0;
+    port->stats.rx_error_count = 0;
+
+    // Enable the receive interrupt so that EUSCI_A_UART_IRQ_Handler fills the receive ring buffer
+    module->IE |= 0x01;
+}
+
+uint8_t EUSCI_A_UART_Compute_Baud_Rate(uint32_t clock_frequency, uint32_t baud_rate, EUSCI_A_UART_Baud_Rate_Config *config)
+{
+    uint32_t n;
+    uint32_t fraction;
+    uint8_t ucbrs;
+    int i;
+
+    if ((baud_rate == 0) || (baud_rate > clock_frequency)) return 0;
+
+    // Integer part of N, and its fractional part in units of 1/10000
+    n = clock_frequency / baud_rate;
+    fraction = (uint32_t)(((uint64_t)(clock_frequency - (n * baud_rate)) * 10000) / baud_rate);
+
+    // Select the last UCBRSx entry whose fraction does not exceed the fractional part of N
+    ucbrs = 0;
+    for (i = 0; i < UCBRS_TABLE_SIZE; i = i + 1)
+    {
+        if (UCBRS_Fraction[i] > fraction) break;
+        ucbrs = UCBRS_Pattern[i];
+    }
+
+    if (n >= 16)
+    {
+        // Oversampling mode: UCBRx = INT(N / 16), UCBRFx = INT(N) mod 16, UCOS16 = 1
+        config->brw = (uint16_t)(n >> 4);
+        config->mctlw = (uint16_t)((ucbrs << 8) | ((n & 0x0F) << 4) | 0x01);
+    }
+    else
+    {
+        // Low-frequency mode: UCBRx = INT(N), UCOS16 = 0
+        config->brw = (uint16_t)n;
+        config->mctlw = (uint16_t)(ucbrs << 8);
+    }
+
+    return 1;
+}
+
+uint8_t EUSCI_A_UART_Set_Baud_Rate(EUSCI_A_Type *module, uint32_t clock_frequency, uint32_t baud_rate)
+{
+    EUSCI_A_UART_Baud_Rate_Config config;
+
+    if (EUSCI_A_UART_Compute_Baud_Rate(clock_frequency, baud_rate, &config) == 0) return 0;
+
+    module->BRW = config.brw;
+    module->MCTLW = config.mctlw;
+
+    return 1;
+}
+
+uint8_t EUSCI_A_UART_Change_Baud_Rate(EUSCI_A_UART_Port *port, uint32_t clock_frequency, uint32_t baud_rate)
+{
+    EUSCI_A_UART_Baud_Rate_Config config;
+    EUSCI_A_Type *module = port->module;
+    long sr;
+
+    if (EUSCI_A_UART_Compute_Baud_Rate(clock_frequency, baud_rate, &config) == 0) return 0;
+
+    // The other master (for example, the uDMA controller) would be cut off by the reset
+    if (port->tx_handoff_state != TX_HANDOFF_NONE) return 0;
+
+    while (1)
+    {
+        // Send the characters that were queued at the previous baud rate
+        EUSCI_A_UART_Flush(port);
+
+        sr = StartCritical();
+
+        // A task may have requested a handoff since the check
+        if (port->tx_handoff_state != TX_HANDOFF_NONE)
+        {
+            EndCritical(sr);
+            return 0;
+        }
+
+        // UCBUSY - A task may have queued a character that is now being shifted out, so wait for it again
+        if ((module->STATW & 0x01) == 0) break;
+
+        EndCritical(sr);
+    }
+
+    // Hold the module in reset mode while the baud rate registers are written
+    module->CTLW0 |= 0x01;
+    module->BRW = config.brw;
+    module->MCTLW = config.mctlw;
+    module->CTLW0 &= ~0x01;
+
+    // The reset cleared the interrupt enable bits, so enable the receive interrupt again.
+    // Characters queued by a task after the flush are sent at the new baud rate.
+    module->IE |= 0x01;
+    if (port->tx_head != port->tx_tail)
+    {
+        module->IE |= 0x02;
+    }
+
+    EndCritical(sr);
+
+    return 1;
+}
+
+void EUSCI_A_UART_Set_TX_Overflow_Policy(EUSCI_A_UART_Port *port, EUSCI_A_UART_TX_Overflow_Policy policy)
+{
+    port->tx_overflow_policy = policy;
+}
+
+// Called with interrupts disabled when the transmit ring buffer is full.
+// Returns 0 if the bytes must be dropped, or 1 once there is room in the buffer.
+static uint8_t EUSCI_A_UART_Make_Room(EUSCI_A_UART_Port *port, long *sr)
+{
+    if (port->tx_overflow_policy == EUSCI_A_UART_TX_OVERFLOW_DROP)
+    {
+        return 0;
+    }
+
+    if (((SCB->ICSR & 0x1FF) == 0) && (*sr == 0))
+    {
+        // Called from the main loop with interrupts enabled,
+        // so let the transmit interrupt make room in the buffer
+        EndCritical(*sr);
+        while (TX_NEXT(port, port->tx_head) == port->tx_tail);
+        *sr = StartCritical();
+    }
+    else if (port->tx_handoff_state == TX_HANDOFF_ACTIVE)
+    {
+        // Called from an interrupt service routine or with interrupts disabled while another master
+        // owns the transmitter. Sending the oldest byte directly would corrupt its transfer.
+        return 0;
+    }
+    else
+    {
+        // Called from an interrupt service routine or with interrupts disabled.
+        // The transmit interrupt cannot run, so send the oldest byte directly.
+        while((port->module->IFG & 0x02) == 0);
+        port->module->TXBUF = port->tx_buffer[port->tx_tail];
+        port->tx_tail = TX_NEXT(port, port->tx_tail);
+        port->stats.tx_count = port->stats.tx_count + 1;
+    }
+
+    return 1;
+}
+
+void EUSCI_A_UART_Write_Byte(EUSCI_A_UART_Port *port, uint8_t data)
+{
+    long sr = StartCritical();
+
+    while (TX_NEXT(port, port->tx_head) == port->tx_tail)
+    {
+        if (EUSCI_A_UART_Make_Room(port, &sr) == 0)
+        {
+            port->stats.tx_dropped_count = port->stats.tx_dropped_count + 1;
+            EndCritical(sr);
+            return;
+        }
+    }
+
+    port->tx_buffer[port->tx_head] = data;
+    port->tx_head = TX_NEXT(port, port->tx_head);
+
+    // Enable the transmit interrupt so that EUSCI_A_UART_IRQ_Handler drains the buffer,
+    // unless the transmitter is handed off
+    if (port->tx_handoff_state != TX_HANDOFF_ACTIVE)
+    {
+        port->module->IE |= 0x02;
+    }
+
+    EndCritical(sr);
+}
+
+uint16_t EUSCI_A_UART_Write(EUSCI_A_UART_Port *port, const uint8_t *data, uint16_t length)
+{
+    uint16_t count = 0;
+    uint16_t head;
+    uint16_t free_space;
+    long sr = StartCritical();
+
+    while (count < length)
+    {
+        free_space = (port->tx_tail - port->tx_head - 1) & port->tx_mask;
+
+        if (free_space == 0)
+        {
+            if (EUSCI_A_UART_Make_Room(port, &sr) == 0)
+            {
+                port->stats.tx_dropped_count = port->stats.tx_dropped_count + (length - count);
+                break;
+            }
+            continue;
+        }
+
+        // Copy as many bytes as the free space allows
+        head = port->tx_head;
+        while ((free_space > 0) && (count < length))
+        {
+            port->tx_buffer[head] = data[count];
+            head = TX_NEXT(port, head);
+            count = count + 1;
+            free_space = free_space - 1;
+        }
+        port->tx_head = head;
+
+        // Enable the transmit interrupt so that EUSCI_A_UART_IRQ_Handler drains the buffer,
+        // unless the transmitter is handed off
+        if (port->tx_handoff_state != TX_HANDOFF_ACTIVE)
+        {
+            port->module->IE |= 0x02;
+        }
+    }
+
+    EndCritical(sr);
+
+    return count;
+}
+
+uint8_t EUSCI_A_UART_Try_Read_Byte(EUSCI_A_UART_Port *port, uint8_t *data)
+{
+    if (port->rx_head == port->rx_tail) return 0;
+
+    *data = port->rx_buffer[port->rx_tail];
+    port->rx_tail = RX_NEXT(port, port->rx_tail);
+    return 1;
+}
+
+uint16_t EUSCI_A_UART_Read(EUSCI_A_UART_Port *port, uint8_t *data, uint16_t max)
+{
+    uint16_t count = 0;
+    uint16_t tail = port->rx_tail;
+
+    // Read the head once. Bytes received during the copy are left for the next call.
+    uint16_t head = port->rx_head;
+
+    while ((count < max) && (tail != head))
+    {
+        data[count] = port->rx_buffer[tail];
+        tail = RX_NEXT(port, tail);
+        count = count + 1;
+    }
+    port->rx_tail = tail;
+
+    return count;
+}
+
+uint16_t EUSCI_A_UART_Get_RX_Available(EUSCI_A_UART_Port *port)
+{
+    return ((port->rx_head - port->rx_tail) & port->rx_mask);
+}
+
+uint16_t EUSCI_A_UART_Get_TX_Free_Space(EUSCI_A_UART_Port *port)
+{
+    return ((port->tx_tail - port->tx_head - 1) & port->tx_mask);
+}
+
+void EUSCI_A_UART_Flush(EUSCI_A_UART_Port *port)
+{
+    // Wait until the ring buffer has been drained by the transmit interrupt and the transmitter is not handed off
+    while((port->tx_head != port->tx_tail) || (port->tx_handoff_state != TX_HANDOFF_NONE));
+
+    // UCBUSY - Wait until the last character has been shifted out
+    while((port->module->STATW & 0x01) == 0x01);
+}
+
+uint8_t EUSCI_A_UART_Request_TX_Handoff(EUSCI_A_UART_Port *port, void (*start_task)(void))
+{
+    long sr = StartCritical();
+
+    if (port->tx_handoff_state != TX_HANDOFF_NONE)
+    {
+        EndCritical(sr);
+        return 0;
+    }
+
+    if (port->tx_head == port->tx_tail)
+    {
+        // The ring buffer is empty, so the transmit interrupt is disabled. Start the other master now.
+        port->tx_handoff_state = TX_HANDOFF_ACTIVE;
+        (*start_task)();
+    }
+    else
+    {
+        // EUSCI_A_UART_IRQ_Handler starts the other master once the ring buffer is empty
+        port->tx_handoff_task = start_task;
+        port->tx_handoff_state = TX_HANDOFF_PENDING;
+    }
+
+    EndCritical(sr);
+
+    return 1;
+}
+
+void EUSCI_A_UART_Release_TX(EUSCI_A_UART_Port *port)
+{
+    long sr = StartCritical();
+
+    port->tx_handoff_state = TX_HANDOFF_NONE;
+
+    // Resume sending the bytes that were written to the ring buffer during the handoff
+    if (port->tx_head != port->tx_tail)
+    {
+        port->module->IE |= 0x02;
+    }
+
+    EndCritical(sr);
+}
+
+uint8_t EUSCI_A_UART_Is_TX_Handoff_Busy(EUSCI_A_UART_Port *port)
+{
+    return (port->tx_handoff_state != TX_HANDOFF_NONE);
+}
+
+void EUSCI_A_UART_Get_Stats(EUSCI_A_UART_Port *port, EUSCI_A_UART_Stats *stats)
+{
+    long sr = StartCritical();
+
+    stats->tx_count = port->stats.tx_count;
+    stats->rx_count = port->stats.rx_count;
+    stats->tx_dropped_count = port->stats.tx_dropped_count;
+    stats->rx_dropped_count = port->stats.rx_dropped_count;
+    stats->rx_overrun_count = port->stats.rx_overrun_count;
+    stats->rx_error_count = port->stats.rx_error_count;
+
+    EndCritical(sr);
+}
+
+void EUSCI_A_UART_IRQ_Handler(EUSCI_A_UART_Port *port)
+{
+    EUSCI_A_Type *module = port->module;
+    uint16_t status;
+    uint8_t data;
+
+    // Character received: move it to the receive ring buffer.
+    // The error flags must be read before RXBUF, since reading RXBUF clears them and the receive interrupt flag.
+    if (module->IFG & 0x01)
+    {
+        status = module->STATW;
+        data = module->RXBUF;
+
+        if (status & STATW_UCOE)
+        {
+            port->stats.rx_overrun_count = port->stats.rx_overrun_count + 1;
+        }
+
+        if (status & (STATW_UCFE | STATW_UCPE | STATW_UCBRK))
+        {
+            port->stats.rx_error_count = port->stats.rx_error_count + 1;
+        }
+        else if (RX_NEXT(port, port->rx_head) != port->rx_tail)
+        {
+            port->rx_buffer[port->rx_head] = data;
+            port->rx_head = RX_NEXT(port, port->rx_head);
+            port->stats.rx_count = port->stats.rx_count + 1;
+        }
+        else
+        {
+            port->stats.rx_dropped_count = port->stats.rx_dropped_count + 1;
+        }
+    }
+
+    // Transmit buffer empty: send the next byte from the ring buffer
+    if ((module->IE & 0x02) && (module->IFG & 0x02))
+    {
+        if (port->tx_head != port->tx_tail)
+        {
+            // Writing to TXBUF clears the transmit interrupt flag
+            module->TXBUF = port->tx_buffer[port->tx_tail];
+            port->tx_tail = TX_NEXT(port, port->tx_tail);
+            port->stats.tx_count = port->stats.tx_count + 1;
+        }
+
+        // Disable the transmit interrupt once the ring buffer is empty,
+        // and start the other master if a handoff is pending
+        if (port->tx_head == port->tx_tail)
+        {
+            module->IE &= ~0x02;
+
+            if (port->tx_handoff_state == TX_HANDOFF_PENDING)
+            {
+                port->tx_handoff_state = TX_HANDOFF_ACTIVE;
+                (*port->tx_handoff_task)();
+            }
+        }
+    }
+}
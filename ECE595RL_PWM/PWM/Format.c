@@ -0,0 +1,205 @@
+/**
+ * @file Format.c
+ * @brief Source code for the Format driver.
+ *
+ * This file contains the function definitions for the Format driver.
+ * It converts integers into decimal strings two digits at a time without division instructions.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Format.h"
+
+// ASCII digits of the numbers 00 to 99
+static const char Format_Digit_Pairs[200] =
+{
+    '0','0', '0','1', '0','2', '0','3', '0','4', '0','5', '0','6', '0','7', '0','8', '0','9',
+    '1','0', '1','1', '1','2', '1','3', '1','4', '1','5', '1','6', '1','7', '1','8', '1','9',
+    '2','0', '2','1', '2','2', '2','3', '2','4', '2','5', '2','6', '2','7', '2','8', '2','9',
+    '3','0', '3','1', '3','2', '3','3', '3','4', '3','5', '3','6', '3','7', '3','8', '3','9',
+    '4','0', '4','1', '4','2', '4','3', '4','4', '4','5', '4','6', '4','7', '4','8', '4','9',
+    '5','0', '5','1', '5','2', '5','3', '5','4', '5','5', '5','6', '5','7', '5','8', '5','9',
+    '6','0', '6','1', '6','2', '6','3', '6','4', '6','5', '6','6', '6','7', '6','8', '6','9',
+    '7','0', '7','1', '7','2', '7','3', '7','4', '7','5', '7','6', '7','7', '7','8', '7','9',
+    '8','0', '8','1', '8','2', '8','3', '8','4', '8','5', '8','6', '8','7', '8','8', '8','9',
+    '9','0', '9','1', '9','2', '9','3', '9','4', '9','5', '9','6', '9','7', '9','8', '9','9'
+};
+
+static const char Format_Hex_Digits[16] =
+{
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Write the decimal digits of n backward, ending just before end. Return a pointer to the first digit.
+// When min_digits is not 0, the result is padded with leading zeros to at least min_digits digits.
+static char *Format_Digits_Backward(char *end, uint32_t n, uint32_t min_digits)
+{
+    char *start = end;
+    uint32_t quotient;
+    uint32_t remainder;
+
+    while (n >= 100)
+    {
+        // quotient = n / 100, using the reciprocal 0x51EB851F / 2^37
+        quotient = (uint32_t)(((uint64_t)n * 0x51EB851F) >> 37);
+        remainder = n - quotient * 100;
+
+        start = start - 2;
+        start[0] = Format_Digit_Pairs[2 * remainder];
+        start[1] = Format_Digit_Pairs[2 * remainder + 1];
+        n = quotient;
+    }
+
+    if (n >= 10)
+    {
+        start = start - 2;
+        start[0] = Format_Digit_Pairs[2 * n];
+        start[1] = Format_Digit_Pairs[2 * n + 1];
+    }
+    else
+    {
+        start = start - 1;
+        start[0] = (char)('0' + n);
+    }
+
+    while ((uint32_t)(end - start) < min_digits)
+    {
+        start = start - 1;
+        start[0] = '0';
+    }
+
+    return start;
+}
+
+// Copy the characters from start to end into buffer, padded on the left with spaces to width, and terminate it
+static uint32_t Format_Copy(char *buffer, const char *start, const char *end, uint32_t width)
+{
+    uint32_t length = end - start;
+    uint32_t index = 0;
+
+    while ((length + index) < width)
+    {
+        buffer[index] = ' ';
+        index = index + 1;
+    }
+
+    while (start < end)
+    {
+        buffer[index] = *start;
+        index = index + 1;
+        start = start + 1;
+    }
+
+    buffer[index] = 0;
+    return index;
+}
+
+// Format an unsigned fixed-point number with an optional sign
+static uint32_t Format_Fix(char *buffer, uint32_t magnitude, uint8_t negative, uint32_t decimals, uint32_t width)
+{
+    char digits[FORMAT_BUFFER_SIZE];
+    char *end = &digits[FORMAT_BUFFER_SIZE];
+    char *start;
+    char *point;
+    uint32_t length;
+    uint32_t index = 0;
+
+    if (decimals > 9) decimals = 9;
+
+    // Keep at least one digit before the decimal point
+    start = Format_Digits_Backward(end, magnitude, decimals + 1);
+    point = end - decimals;
+
+    length = (end - start) + ((decimals != 0) ? 1 : 0) + ((negative != 0) ? 1 : 0);
+    while ((length + index) < width)
+    {
+        buffer[index] = ' ';
+        index = index + 1;
+    }
+
+    if (negative)
+    {
+        buffer[index] = '-';
+        index = index + 1;
+    }
+
+    while (start < end)
+    {
+        if (start == point)
+        {
+            buffer[index] = '.';
+            index = index + 1;
+        }
+        buffer[index] = *start;
+        index = index + 1;
+        start = start + 1;
+    }
+
+    buffer[index] = 0;
+    return index;
+}
+
+uint32_t Format_UDec(char *buffer, uint32_t n)
+{
+    char digits[FORMAT_BUFFER_SIZE];
+    char *end = &digits[FORMAT_BUFFER_SIZE];
+
+    return Format_Copy(buffer, Format_Digits_Backward(end, n, 0), end, 0);
+}
+
+uint32_t Format_SDec(char *buffer, int32_t n)
+{
+    return Format_SDec_Width(buffer, n, 0);
+}
+
+uint32_t Format_UDec_Width(char *buffer, uint32_t n, uint32_t width)
+{
+    char digits[FORMAT_BUFFER_SIZE];
+    char *end = &digits[FORMAT_BUFFER_SIZE];
+
+    return Format_Copy(buffer, Format_Digits_Backward(end, n, 0), end, width);
+}
+
+uint32_t Format_SDec_Width(char *buffer, int32_t n, uint32_t width)
+{
+    char digits[FORMAT_BUFFER_SIZE];
+    char *end = &digits[FORMAT_BUFFER_SIZE];
+    char *start;
+
+    // Negate as an unsigned value so that the most negative number is also converted correctly
+    start = Format_Digits_Backward(end, (n < 0) ? (0 - (uint32_t)n) : (uint32_t)n, 0);
+    if (n < 0)
+    {
+        start = start - 1;
+        *start = '-';
+    }
+
+    return Format_Copy(buffer, start, end, width);
+}
+
+uint32_t Format_UFix(char *buffer, uint32_t n, uint32_t decimals, uint32_t width)
+{
+    return Format_Fix(buffer, n, 0, decimals, width);
+}
+
+uint32_t Format_SFix(char *buffer, int32_t n, uint32_t decimals, uint32_t width)
+{
+    return Format_Fix(buffer, (n < 0) ? (0 - (uint32_t)n) : (uint32_t)n, (n < 0), decimals, width);
+}
+
+uint32_t Format_UHex(char *buffer, uint32_t n)
+{
+    char digits[FORMAT_BUFFER_SIZE];
+    char *end = &digits[FORMAT_BUFFER_SIZE];
+    char *start = end;
+
+    do
+    {
+        start = start - 1;
+        *start = Format_Hex_Digits[n & 0x0F];
+        n = n >> 4;
+    } while (n != 0);
+
+    return Format_Copy(buffer, start, end, 0);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file Motion_Sequencer.c
+ * @brief Source code for the Motion_Sequencer driver.
+ *
+ * This file contains the function definitions for the Motion_Sequencer driver.
+ * It executes a table of motor commands without blocking the CPU.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Motion_Sequencer.h"
+
+// The sequence that is running
+static const Motion_Step *Sequence_Steps = 0;
+static uint8_t Sequence_Num_Steps = 0;
+static uint8_t Sequence_Index = 0;
+static void (*Sequence_Done_Task)(void) = 0;
+
+// Time left in the current step, in milliseconds
+static uint32_t Step_Remaining_ms = 0;
+
+// Apply the motor command of a single step
+static void Motion_Sequencer_Apply(const Motion_Step *step)
+{
+    switch (step->command)
+    {
+        case MOTION_FORWARD:
+            Motor_Forward(step->left_duty_cycle, step->right_duty_cycle);
+            break;
+        case MOTION_BACKWARD:
+            Motor_Backward(step->left_duty_cycle, step->right_duty_cycle);
+            break;
+        case MOTION_LEFT:
+            Motor_Left(step->left_duty_cycle, step->right_duty_cycle);
+            break;
+        case MOTION_RIGHT:
+            Motor_Right(step->left_duty_cycle, step->right_duty_cycle);
+            break;
+        case MOTION_STOP:
+        default:
+            Motor_Stop();
+            break;
+    }
+}
+
+void Motion_Sequencer_Init(void)
+{
+    Motion_Sequencer_Abort();
+}
+
+void Motion_Sequencer_Start(const Motion_Step *steps, uint8_t num_steps, void(*done_task)(void))
+{
+    long sr;
+
+    if ((steps == 0) || (num_steps == 0)) return;
+
+    sr = StartCritical();
+    Sequence_Steps = steps;
+    Sequence_Num_Steps = num_steps;
+    Sequence_Index = 0;
+    Sequence_Done_Task = done_task;
+    Step_Remaining_ms = steps[0].duration_ms;
+    Motion_Sequencer_Apply(&steps[0]);
+    EndCritical(sr);
+}
+
+void Motion_Sequencer_Abort(void)
+{
+    long sr;
+
+    sr = StartCritical();
+    Sequence_Steps = 0;
+    Sequence_Num_Steps = 0;
+    Sequence_Index = 0;
+    Sequence_Done_Task = 0;
+    Step_Remaining_ms = 0;
+    Motor_Stop();
+    EndCritical(sr);
+}
+
+uint8_t Motion_Sequencer_Is_Busy(void)
+{
+    return (Sequence_Steps != 0);
+}
+
+void Motion_Sequencer_Tick(uint16_t elapsed_ms)
+{
+    void (*done_task)(void) = 0;
+    uint32_t elapsed = elapsed_ms;
+    long sr;
+
+    // A sequence started by a higher priority interrupt must not be mixed with this update
+    sr = StartCritical();
+
+    while ((Sequence_Steps != 0) && (elapsed >= Step_Remaining_ms))
+    {
+        // The current step has completed, so carry the excess time over to the next step
+        elapsed = elapsed - Step_Remaining_ms;
+        Sequence_Index = Sequence_Index + 1;
+
+        if (Sequence_Index >= Sequence_Num_Steps)
+        {
+            done_task = Sequence_Done_Task;
+            Sequence_Steps = 0;
+            Sequence_Done_Task = 0;
+            Step_Remaining_ms = 0;
+            Motor_Stop();
+        }
+        else
+        {
+            Step_Remaining_ms = Sequence_Steps[Sequence_Index].duration_ms;
+            Motion_Sequencer_Apply(&Sequence_Steps[Sequence_Index]);
+        }
+    }
+
+    if (Sequence_Steps != 0)
+    {
+        Step_Remaining_ms = Step_Remaining_ms - elapsed;
+    }
+
+    EndCritical(sr);
+
+    // Notify the user outside of the critical section
+    if (done_task != 0)
+    {
+        (*done_task)();
+    }
+}
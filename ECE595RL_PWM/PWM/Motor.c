@@ -12,6 +12,49 @@
 
 #include "../inc/Motor.h"
 
+// Direction bits (P5.4 and P5.5) applied by Motor_Commit_Task together with the next duty cycle commit
+static volatile uint8_t Pending_Direction_Bits = 0;
+
+// Signed duty cycles of the last command, reported by Motor_Get_Duty_Cycles
+static volatile int16_t Left_Duty_Cycle = 0;
+static volatile int16_t Right_Duty_Cycle = 0;
+
+// Executed by TA0_0_IRQHandler at the PWM period boundary, right before the duty cycles are latched
+static void Motor_Commit_Task(void)
+{
+    // Update the direction of both motors
+    P5->OUT = (P5->OUT & ~0x30) | Pending_Direction_Bits;
+
+    // Enable the motors
+    P3->OUT |= 0xC0;
+}
+
+// Commit the direction bits and the duty cycles of both motors in the same PWM period.
+// Returns 1 on success, or 0 if a duty cycle is out of range, in which case nothing is changed.
+static uint8_t Motor_Commit(uint8_t direction_bits, uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    long sr;
+
+    sr = StartCritical();
+
+    // The direction bits are only replaced when the duty cycles are accepted, so that a pending commit
+    // never applies new direction bits with the old duty cycles
+    if (Timer_A0_PWM_Commit(right_duty_cycle, left_duty_cycle) == 0)
+    {
+        EndCritical(sr);
+        return 0;
+    }
+
+    Pending_Direction_Bits = direction_bits;
+
+    // P5.4 selects the backward direction of the left motor, and P5.5 the backward direction of the right motor
+    Left_Duty_Cycle = (direction_bits & 0x10) ? -(int16_t)left_duty_cycle : (int16_t)left_duty_cycle;
+    Right_Duty_Cycle = (direction_bits & 0x20) ? -(int16_t)right_duty_cycle : (int16_t)right_duty_cycle;
+    EndCritical(sr);
+
+    return 1;
+}
+
 void Motor_Init()
 {
     // Configure P5.4 and P5.5 as GPIO output pins
@@ -27,74 +70,67 @@ void Motor_Init()
     P3->OUT &= ~0xC0;
 
     // Initialize Timer A0 with a period of 20 ms
-    Timer_A0_PWM_Init(15000, 0, 0);
+    Timer_A0_PWM_Init(MOTOR_PWM_PERIOD, 0, 0);
+
+    // Update the direction pins in the same PWM period as the duty cycles
+    Timer_A0_PWM_Set_Commit_Task(&Motor_Commit_Task);
 }
 
-void Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+uint8_t Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
 {
     // Configure the motors to move in a forward direction
-    P5->OUT &= ~0x30;
-
-    // Update the duty cycle for both motors
-    Timer_A0_Update_Duty_Cycle_1(right_duty_cycle);
-    Timer_A0_Update_Duty_Cycle_2(left_duty_cycle);
-
-    // Enable the motors
-    P3->OUT |= 0xC0;
+    return Motor_Commit(0x00, left_duty_cycle, right_duty_cycle);
 }
 
-void Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+uint8_t Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
 {
     // Configure the left motor to move in a forward direction
-    P5->OUT &= ~0x10;
-
     // Configure the right motor to move in a backward direction
-    P5->OUT |= 0x20;
-
-    // Update the duty cycle for both motors
-    Timer_A0_Update_Duty_Cycle_1(right_duty_cycle);
-    Timer_A0_Update_Duty_Cycle_2(left_duty_cycle);
-
-    // Enable the motors
-    P3->OUT |= 0xC0;
+    return Motor_Commit(0x20, left_duty_cycle, right_duty_cycle);
 }
 
-void Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+uint8_t Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
 {
     // Configure the left motor to move in a backward direction
-    P5->OUT |= 0x10;
-
     // Configure the right motor to move in a forward direction
-    P5->OUT &= ~0x20;
-
-    // Update the duty cycle for both motors
-    Timer_A0_Update_Duty_Cycle_1(right_duty_cycle);
-    Timer_A0_Update_Duty_Cycle_2(left_duty_cycle);
-
-    // Enable the motors
-    P3->OUT |= 0xC0;
+    return Motor_Commit(0x10, left_duty_cycle, right_duty_cycle);
 }
 
-void Motor_Backward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+uint8_t Motor_Backward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
 {
     // Configure the motors to move in a backward direction
-    P5->OUT |= 0x30;
-
-    // Update the duty cycle for both motors
-    Timer_A0_Update_Duty_Cycle_1(right_duty_cycle);
-    Timer_A0_Update_Duty_Cycle_2(left_duty_cycle);
-
-    // Enable the motors
-    P3->OUT |= 0xC0;
+    return Motor_Commit(0x30, left_duty_cycle, right_duty_cycle);
 }
 
 void Motor_Stop()
 {
-    // Disable the motors
+    long sr;
+
+    sr = StartCritical();
+
+    // Disable the motors first, since it is the fastest way to remove the drive current
     P3->OUT &= ~0xC0;
-    P5->OUT &= ~0x30;
 
     // Update the duty cycle to 0%
     Timer_A0_Update_Duty_Cycle_1(0);
     Timer_A0_Update_Duty_Cycle_2(0);
+
+    // Discard any command that has not been latched yet
+    Timer_A0_PWM_Cancel_Commit();
+    P5->OUT &= ~0x30;
+
+    Left_Duty_Cycle = 0;
+    Right_Duty_Cycle = 0;
+
+    EndCritical(sr);
+}
+
+void Motor_Get_Duty_Cycles(int16_t *left_duty_cycle, int16_t *right_duty_cycle)
+{
+    long sr;
+
+    sr = StartCritical();
+    *left_duty_cycle = Left_Duty_Cycle;
+    *right_duty_cycle = Right_Duty_Cycle;
+    EndCritical(sr);
 }
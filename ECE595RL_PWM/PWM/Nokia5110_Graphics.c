@@ -0,0 +1,398 @@
+/**
+ * @file Nokia5110_Graphics.c
+ * @brief Source code for the Nokia5110_Graphics driver.
+ *
+ * This file contains the function definitions for the Nokia5110_Graphics driver.
+ * It draws lines, rectangles, circles, and bitmaps into the bank-major screen buffer
+ * of the Nokia5110_LCD driver, one column byte or one 32-bit word at a time.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include <string.h>
+#include "../inc/Nokia5110_Graphics.h"
+
+// Combine a byte of the screen buffer with a mask
+static uint8_t Graphics_Apply(uint8_t destination, uint8_t mask, Nokia5110_Pixel_Mode mode)
+{
+    switch (mode)
+    {
+        case NOKIA5110_PIXEL_CLEAR:     return (destination & ~mask);
+        case NOKIA5110_PIXEL_INVERT:    return (destination ^ mask);
+        default:                        return (destination | mask);
+    }
+}
+
+// Apply the same mask to count consecutive bytes of the screen buffer, one 32-bit word at a time.
+// The words are read and written with memcpy, since the screen buffer is a uint8_t array and accessing it
+// through a uint32_t pointer would break the strict aliasing rule. The compiler turns each memcpy into a
+// single load or store.
+static void Graphics_Apply_Span(uint8_t *destination, uint8_t mask, int32_t count, Nokia5110_Pixel_Mode mode)
+{
+    uint32_t word_mask = (uint32_t)mask * 0x01010101u;
+    uint32_t word;
+
+    // Apply the mask to the bytes before the first word boundary
+    while ((count > 0) && (((uintptr_t)destination & 0x03) != 0))
+    {
+        *destination = Graphics_Apply(*destination, mask, mode);
+        destination = destination + 1;
+        count = count - 1;
+    }
+
+    switch (mode)
+    {
+        case NOKIA5110_PIXEL_CLEAR:
+            while (count >= 4)
+            {
+                memcpy(&word, destination, 4);
+                word = word & ~word_mask;
+                memcpy(destination, &word, 4);
+                destination = destination + 4;
+                count = count - 4;
+            }
+            break;
+
+        case NOKIA5110_PIXEL_INVERT:
+            while (count >= 4)
+            {
+                memcpy(&word, destination, 4);
+                word = word ^ word_mask;
+                memcpy(destination, &word, 4);
+                destination = destination + 4;
+                count = count - 4;
+            }
+            break;
+
+        default:
+            while (count >= 4)
+            {
+                memcpy(&word, destination, 4);
+                word = word | word_mask;
+                memcpy(destination, &word, 4);
+                destination = destination + 4;
+                count = count - 4;
+            }
+            break;
+    }
+
+    // Apply the mask to the remaining bytes
+    while (count > 0)
+    {
+        *destination = Graphics_Apply(*destination, mask, mode);
+        destination = destination + 1;
+        count = count - 1;
+    }
+}
+
+void Nokia5110_Draw_Pixel(int32_t x, int32_t y, Nokia5110_Pixel_Mode mode)
+{
+    uint8_t *destination;
+
+    if ((x < 0) || (x >= SCREENW) || (y < 0) || (y >= SCREENH)) return;
+
+    destination = &Screen[SCREENW*(y >> 3) + x];
+    *destination = Graphics_Apply(*destination, (uint8_t)(1 << (y & 0x07)), mode);
+    Nokia5110_Invalidate_Region(x, y, x, y);
+}
+
+void Nokia5110_Fill_Rect(int32_t x, int32_t y, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode)
+{
+    int32_t x0 = x;
+    int32_t y0 = y;
+    int32_t x1 = x + width - 1;
+    int32_t y1 = y + height - 1;
+    int32_t bank;
+    uint8_t mask;
+
+    // Clip the rectangle to the screen
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > (SCREENW - 1)) x1 = SCREENW - 1;
+    if (y1 > (SCREENH - 1)) y1 = SCREENH - 1;
+    if ((x0 > x1) || (y0 > y1)) return;
+
+    for (bank = (y0 >> 3); bank <= (y1 >> 3); bank = bank + 1)
+    {
+        // Keep only the rows of the bank that are inside the rectangle
+        mask = 0xFF;
+        if (bank == (y0 >> 3)) mask &= (uint8_t)(0xFF << (y0 & 0x07));
+        if (bank == (y1 >> 3)) mask &= (uint8_t)(0xFF >> (7 - (y1 & 0x07)));
+
+        Graphics_Apply_Span(&Screen[SCREENW*bank + x0], mask, x1 - x0 + 1, mode);
+    }
+
+    Nokia5110_Invalidate_Region(x0, y0, x1, y1);
+}
+
+void Nokia5110_Draw_HLine(int32_t x, int32_t y, int32_t width, Nokia5110_Pixel_Mode mode)
+{
+    Nokia5110_Fill_Rect(x, y, width, 1, mode);
+}
+
+void Nokia5110_Draw_VLine(int32_t x, int32_t y, int32_t height, Nokia5110_Pixel_Mode mode)
+{
+    Nokia5110_Fill_Rect(x, y, 1, height, mode);
+}
+
+void Nokia5110_Draw_Rect(int32_t x, int32_t y, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode)
+{
+    if ((width <= 0) || (height <= 0)) return;
+
+    Nokia5110_Draw_HLine(x, y, width, mode);
+    if (height > 1)
+    {
+        Nokia5110_Draw_HLine(x, y + height - 1, width, mode);
+    }
+
+    // Do not draw the corners twice, so that NOKIA5110_PIXEL_INVERT works
+    if (height > 2)
+    {
+        Nokia5110_Draw_VLine(x, y + 1, height - 2, mode);
+        if (width > 1)
+        {
+            Nokia5110_Draw_VLine(x + width - 1, y + 1, height - 2, mode);
+        }
+    }
+}
+
+void Nokia5110_Draw_Line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, Nokia5110_Pixel_Mode mode)
+{
+    int32_t dx;
+    int32_t dy;
+    int32_t step_y;
+    int32_t error;
+    int32_t error_2;
+    int32_t swap;
+    int32_t top;
+    int32_t bottom;
+    int32_t index;
+    uint8_t mask;
+
+    if (y0 == y1)
+    {
+        if (x0 > x1)
+        {
+            swap = x0;
+            x0 = x1;
+            x1 = swap;
+        }
+        Nokia5110_Draw_HLine(x0, y0, x1 - x0 + 1, mode);
+        return;
+    }
+
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+        {
+            swap = y0;
+            y0 = y1;
+            y1 = swap;
+        }
+        Nokia5110_Draw_VLine(x0, y0, y1 - y0 + 1, mode);
+        return;
+    }
+
+    // Always draw from left to right
+    if (x0 > x1)
+    {
+        swap = x0; x0 = x1; x1 = swap;
+        swap = y0; y0 = y1; y1 = swap;
+    }
+
+    dx = x1 - x0;
+    dy = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+    step_y = (y1 > y0) ? 1 : -1;
+    error = dx - dy;
+    top = (y1 > y0) ? y0 : y1;
+    bottom = (y1 > y0) ? y1 : y0;
+
+    // Index of the byte and mask of the bit of the current point.
+    // They are updated incrementally, and they are only used while the current point is on the screen.
+    index = SCREENW*(y0 >> 3) + x0;
+    mask = (uint8_t)(1 << (y0 & 0x07));
+
+    Nokia5110_Invalidate_Region(x0, top, x1, bottom);
+
+    while (1)
+    {
+        if ((x0 >= 0) && (x0 < SCREENW) && (y0 >= 0) && (y0 < SCREENH))
+        {
+            Screen[index] = Graphics_Apply(Screen[index], mask, mode);
+        }
+
+        if ((x0 == x1) && (y0 == y1)) break;
+
+        error_2 = 2 * error;
+        if (error_2 > -dy)
+        {
+            // Move one column to the right
+            error = error - dy;
+            x0 = x0 + 1;
+            index = index + 1;
+        }
+        if (error_2 < dx)
+        {
+            // Move one row up or down, and to the next bank when the mask leaves the byte
+            error = error + dx;
+            y0 = y0 + step_y;
+            if (step_y > 0)
+            {
+                mask = (uint8_t)(mask << 1);
+                if (mask == 0)
+                {
+                    mask = 0x01;
+                    index = index + SCREENW;
+                }
+            }
+            else
+            {
+                mask = (uint8_t)(mask >> 1);
+                if (mask == 0)
+                {
+                    mask = 0x80;
+                    index = index - SCREENW;
+                }
+            }
+        }
+    }
+}
+
+void Nokia5110_Draw_Circle(int32_t x_center, int32_t y_center, int32_t radius, Nokia5110_Pixel_Mode mode)
+{
+    int32_t x = radius;
+    int32_t y = 0;
+    int32_t error = 1 - radius;
+
+    if (radius < 0) return;
+
+    // Midpoint circle algorithm: draw the eight symmetric points of each step
+    while (x >= y)
+    {
+        Nokia5110_Draw_Pixel(x_center + x, y_center + y, mode);
+        Nokia5110_Draw_Pixel(x_center - x, y_center + y, mode);
+        Nokia5110_Draw_Pixel(x_center + x, y_center - y, mode);
+        Nokia5110_Draw_Pixel(x_center - x, y_center - y, mode);
+        Nokia5110_Draw_Pixel(x_center + y, y_center + x, mode);
+        Nokia5110_Draw_Pixel(x_center - y, y_center + x, mode);
+        Nokia5110_Draw_Pixel(x_center + y, y_center - x, mode);
+        Nokia5110_Draw_Pixel(x_center - y, y_center - x, mode);
+
+        y = y + 1;
+        if (error < 0)
+        {
+            error = error + 2 * y + 1;
+        }
+        else
+        {
+            x = x - 1;
+            error = error + 2 * (y - x) + 1;
+        }
+    }
+}
+
+void Nokia5110_Fill_Circle(int32_t x_center, int32_t y_center, int32_t radius, Nokia5110_Pixel_Mode mode)
+{
+    int32_t dx;
+    int32_t dy = radius;
+    int32_t radius_squared = radius * radius;
+
+    if (radius < 0) return;
+
+    // For each column offset, find the largest row offset that is inside the circle.
+    // The row offset only decreases as the column offset increases, so it is found without a square root.
+    for (dx = 0; dx <= radius; dx = dx + 1)
+    {
+        while ((dx * dx + dy * dy) > radius_squared)
+        {
+            dy = dy - 1;
+        }
+
+        Nokia5110_Draw_VLine(x_center + dx, y_center - dy, 2 * dy + 1, mode);
+        if (dx != 0)
+        {
+            Nokia5110_Draw_VLine(x_center - dx, y_center - dy, 2 * dy + 1, mode);
+        }
+    }
+}
+
+void Nokia5110_Blit(int32_t x, int32_t y, const uint8_t *bitmap, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode)
+{
+    int32_t num_source_banks = (height + 7) >> 3;
+    int32_t first_bank = y >> 3;
+    int32_t shift = y & 0x07;
+    int32_t source_bank;
+    int32_t destination_bank;
+    int32_t column;
+    int32_t column_start = (x < 0) ? -x : 0;
+    int32_t column_end = ((x + width) > SCREENW) ? (SCREENW - x) : width;
+    uint16_t source_mask;
+    uint16_t source_bits;
+    uint8_t *destination;
+
+    if ((width <= 0) || (height <= 0)) return;
+
+    for (source_bank = 0; source_bank < num_source_banks; source_bank = source_bank + 1)
+    {
+        // Ignore the rows of the last bank that are below the bitmap
+        source_mask = 0xFF;
+        if ((source_bank == (num_source_banks - 1)) && ((height & 0x07) != 0))
+        {
+            source_mask = 0xFF >> (8 - (height & 0x07));
+        }
+        source_mask = source_mask << shift;
+
+        destination_bank = first_bank + source_bank;
+
+        for (column = column_start; column < column_end; column = column + 1)
+        {
+            source_bits = (uint16_t)((bitmap[width*source_bank + column] << shift) & source_mask);
+
+            // The low byte of the shifted column goes to the destination bank, and the high byte to the bank below it
+            if ((destination_bank >= 0) && (destination_bank < NOKIA5110_NUM_BANKS))
+            {
+                destination = &Screen[SCREENW*destination_bank + x + column];
+                if (mode == NOKIA5110_PIXEL_COPY)
+                {
+                    *destination = (*destination & ~(uint8_t)source_mask) | (uint8_t)source_bits;
+                }
+                else
+                {
+                    *destination = Graphics_Apply(*destination, (uint8_t)source_bits, mode);
+                }
+            }
+
+            if ((shift != 0) && ((destination_bank + 1) >= 0) && ((destination_bank + 1) < NOKIA5110_NUM_BANKS))
+            {
+                destination = &Screen[SCREENW*(destination_bank + 1) + x + column];
+                if (mode == NOKIA5110_PIXEL_COPY)
+                {
+                    *destination = (*destination & ~(uint8_t)(source_mask >> 8)) | (uint8_t)(source_bits >> 8);
+                }
+                else
+                {
+                    *destination = Graphics_Apply(*destination, (uint8_t)(source_bits >> 8), mode);
+                }
+            }
+        }
+    }
+
+    Nokia5110_Invalidate_Region(x, y, x + width - 1, y + height - 1);
+}
+
+void Nokia5110_Draw_String(int32_t x, int32_t y, const char *ptr, Nokia5110_Pixel_Mode mode)
+{
+    uint8_t columns[(SCREENW / NOKIA5110_CHAR_WIDTH) * NOKIA5110_CHAR_WIDTH];
+    uint32_t num_chars;
+
+    while ((*ptr != 0) && (x < SCREENW))
+    {
+        num_chars = Nokia5110_Text_Columns(ptr, columns, SCREENW / NOKIA5110_CHAR_WIDTH);
+
+        Nokia5110_Blit(x, y, columns, num_chars * NOKIA5110_CHAR_WIDTH, 8, mode);
+
+        x = x + num_chars * NOKIA5110_CHAR_WIDTH;
+        ptr = ptr + num_chars;
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Nokia5110_Image.c
+ * @brief Source code for the Nokia5110_Image driver.
+ *
+ * This file contains the function definitions for the Nokia5110_Image driver.
+ * It draws raw or run-length encoded bank-major images into the screen buffer of the Nokia5110_LCD driver.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Nokia5110_Image.h"
+
+uint8_t Nokia5110_Draw_Image(int32_t x, int32_t y, const Nokia5110_Image *image, Nokia5110_Pixel_Mode mode)
+{
+    uint8_t bank_buffer[NOKIA5110_IMAGE_MAX_RLE_WIDTH];
+    int32_t num_banks = (image->height + 7) >> 3;
+    int32_t bank;
+    int32_t bank_height;
+    int32_t column;
+    int32_t index = 0;
+    int32_t run_length = 0;
+    uint8_t run_repeat = 0;
+    uint8_t header;
+
+    if (image->encoding == NOKIA5110_IMAGE_RAW)
+    {
+        Nokia5110_Blit(x, y, image->data, image->width, image->height, mode);
+        return 1;
+    }
+
+    if ((image->encoding != NOKIA5110_IMAGE_RLE) || (image->width > NOKIA5110_IMAGE_MAX_RLE_WIDTH)) return 0;
+
+    for (bank = 0; bank < num_banks; bank = bank + 1)
+    {
+        // Decode one bank. A packet can continue from the previous bank.
+        for (column = 0; column < image->width; column = column + 1)
+        {
+            if (run_length == 0)
+            {
+                if ((index + 1) >= image->size) return 0;
+
+                header = image->data[index];
+                index = index + 1;
+                run_repeat = header & 0x80;
+                run_length = (header & 0x7F) + 1;
+            }
+
+            bank_buffer[column] = image->data[index];
+            run_length = run_length - 1;
+
+            // A repeated packet only moves to the next byte when it ends
+            if ((run_repeat == 0) || (run_length == 0))
+            {
+                index = index + 1;
+            }
+
+            if ((run_repeat == 0) && (run_length != 0) && (index >= image->size)) return 0;
+        }
+
+        bank_height = image->height - 8 * bank;
+        if (bank_height > 8) bank_height = 8;
+
+        Nokia5110_Blit(x, y + 8 * bank, bank_buffer, image->width, bank_height, mode);
+    }
+
+    return 1;
+}
@@ -136,7 +136,34 @@ const uint8_t ASCII[][5] = {
   ,{0x1f, 0x24, 0x7c, 0x24, 0x1f} // 7f UT sign
 };
 
-void Nokia5110_SPI_Init()
+// First and last column of each bank that changed since the last flush.
+// A bank is unmodified when its first column is greater than its last column.
+static uint8_t Dirty_First_Column[NOKIA5110_NUM_BANKS];
+static uint8_t Dirty_Last_Column[NOKIA5110_NUM_BANKS];
+
+// Set while a transfer started by Nokia5110_DisplayBuffer_DMA is in progress
+static volatile uint8_t Flush_Active = 0;
+
+// User-defined task executed when the transfer of the screen buffer completes
+static void (*Flush_Done_Task)(void) = 0;
+
+// Column bytes of the string sent by Nokia5110_OutString_DMA
+static uint8_t Text_DMA_Buffer[NOKIA5110_TEXT_DMA_MAX_CHARS * NOKIA5110_CHAR_WIDTH];
+
+// Return the font entry of a character, using a space for characters outside the font
+static const uint8_t *Nokia5110_Glyph(char data)
+{
+    uint8_t character = (uint8_t)data;
+
+    if ((character < 0x20) || (character > 0x7F))
+    {
+        character = ' ';
+    }
+
+    return ASCII[character - 0x20];
+}
+
+void Nokia5110_SPI_Init(uint32_t bit_rate)
 {
     // Hold the EUSCI_A3 module in reset mode
     EUSCI_A3->CTLW0 |= 0x01;
@@ -158,10 +185,9 @@ void Nokia5110_SPI_Init()
 //   0          UCSWRST      0x1        eUSCI logic held in reset state
     EUSCI_A3->CTLW0 |= 0xAD83;
 
-    // Set the baud rate. The clock frequency used is 1 MHz.
-    // N = (Clock Frequency) / (Baud Rate) = (12,000,000 / 1,000,000)
-    // N = 3
-    EUSCI_A3->BRW |= 12;
+    // Set the bit rate from the current SMCLK frequency
+    // N = (Clock Frequency) / (Bit Rate) = (12,000,000 / 4,000,000) = 3 by default
+    EUSCI_A3->BRW = EUSCI_A3_SPI_Prescaler(bit_rate);
 
     // Configure P9.4, P9.5, and P9.7 pins as primary module function
     P9->SEL0 |= 0xB0;
@@ -248,13 +274,19 @@ void Nokia5110_Config()
 
 void Nokia5110_Init()
 {
-    Nokia5110_SPI_Init();
+    Nokia5110_SPI_Init(NOKIA5110_SPI_BIT_RATE);
     Nokia5110_Reset();
     Nokia5110_Config();
+
+    // The contents of the LCD are unknown after a reset
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
 }
 
 void Nokia5110_Command_Write(uint8_t command)
 {
+    // Wait until the uDMA transfer of the screen buffer has finished
+    while(Flush_Active);
+
     // UCBUSY - Wait until SPI is not busy
     while((EUSCI_A3->STATW & 0x0001) == 0x0001);
 
@@ -270,6 +302,9 @@ void Nokia5110_Command_Write(uint8_t command)
 
 void Nokia5110_Data_Write(uint8_t data)
 {
+    // Wait until the uDMA transfer of the screen buffer has finished
+    while(Flush_Active);
+
     // Wait until UCA3TXBUF is empty
     while((EUSCI_A3->IFG & 0x0002) == 0x0000);
 
@@ -282,6 +317,9 @@ void Nokia5110_Data_Write(uint8_t data)
 
 void Nokia5110_OutChar(char data)
 {
+    // The LCD no longer matches the screen buffer
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
+
     // Blank vertical line padding
     Nokia5110_Data_Write(0x00);
     for(int i = 0; i < 5; i = i + 1)
@@ -294,154 +332,112 @@ void Nokia5110_OutChar(char data)
 
 void Nokia5110_OutString(char *ptr)
 {
+    const uint8_t *glyph;
+    int i;
+
+    if (*ptr == 0) return;
+
+    // The LCD no longer matches the screen buffer
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
+
+    // Wait until the uDMA transfer of the screen buffer has finished
+    while(Flush_Active);
+
+    // Commands are fully shifted out by Nokia5110_Command_Write, so the Data/Command pin can be set once for the whole string
+    Nokia5110_SPI_Data_Command_Bit_Out(0x01);
+
     while(*ptr)
     {
-        Nokia5110_OutChar((unsigned char)*ptr);
+        glyph = Nokia5110_Glyph(*ptr);
+
+        // Blank vertical line padding, five glyph columns, and blank vertical line padding
+        while((EUSCI_A3->IFG & 0x0002) == 0x0000);
+        EUSCI_A3->TXBUF = 0x00;
+        for (i = 0; i < 5; i = i + 1)
+        {
+            while((EUSCI_A3->IFG & 0x0002) == 0x0000);
+            EUSCI_A3->TXBUF = glyph[i];
+        }
+        while((EUSCI_A3->IFG & 0x0002) == 0x0000);
+        EUSCI_A3->TXBUF = 0x00;
+
         ptr = ptr + 1;
     }
 }
 
-void Nokia5110_OutUDec(uint16_t n)
+uint32_t Nokia5110_Text_Columns(const char *ptr, uint8_t *columns, uint32_t max_chars)
 {
-    if (n < 10)
-    {
-        Nokia5110_OutString("    ");
-        Nokia5110_OutChar(n + '0'); /* n is between 0 and 9 */
-    }
-    else if (n < 100)
-    {
-        Nokia5110_OutString("   ");
-        Nokia5110_OutChar(n/10 + '0'); /* tens digit */
-        Nokia5110_OutChar(n%10 + '0'); /* ones digit */
-    }
-    else if (n < 1000)
-    {
-        Nokia5110_OutString("  ");
-        Nokia5110_OutChar(n/100 + '0'); /* hundreds digit */
-        n = n%100;
-        Nokia5110_OutChar(n/10 + '0'); /* tens digit */
-        Nokia5110_OutChar(n%10 + '0'); /* ones digit */
-    }
-    else if (n < 10000)
-    {
-        Nokia5110_OutChar(' ');
-        Nokia5110_OutChar(n/1000 + '0'); /* thousands digit */
-        n = n%1000;
-        Nokia5110_OutChar(n/100 + '0'); /* hundreds digit */
-        n = n%100;
-        Nokia5110_OutChar(n/10 + '0'); /* tens digit */
-        Nokia5110_OutChar(n%10 + '0'); /* ones digit */
-    }
-    else
+    const uint8_t *glyph;
+    uint32_t num_chars = 0;
+    int i;
+
+    while ((*ptr != 0) && (num_chars < max_chars))
     {
-        Nokia5110_OutChar(n/10000 + '0'); /* ten-thousands digit */
-        n = n%10000;
-        Nokia5110_OutChar(n/1000 + '0'); /* thousands digit */
-        n = n%1000;
-        Nokia5110_OutChar(n/100 + '0'); /* hundreds digit */
-        n = n%100;
-        Nokia5110_OutChar(n/10 + '0'); /* tens digit */
-        Nokia5110_OutChar(n%10 + '0'); /* ones digit */
+        glyph = Nokia5110_Glyph(*ptr);
+
+        columns[0] = 0x00;
+        for (i = 0; i < 5; i = i + 1)
+        {
+            columns[i + 1] = glyph[i];
+        }
+        columns[6] = 0x00;
+
+        columns = columns + NOKIA5110_CHAR_WIDTH;
+        num_chars = num_chars + 1;
+        ptr = ptr + 1;
     }
+
+    return num_chars;
+}
+
+void Nokia5110_OutUDec(uint16_t n)
+{
+    char message[FORMAT_BUFFER_SIZE];
+
+    // Five right-justified digits
+    Format_UDec_Width(message, n, 5);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_OutSDec(int16_t n)
 {
-  char sign=' ';
-  if(n<0){
-    sign = '-';
-    n =  -n; // positive now
-  }
-  if(n < 10){
-    Nokia5110_OutString("    ");
-    Nokia5110_OutChar(sign);
-    Nokia5110_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    Nokia5110_OutString("   ");
-    Nokia5110_OutChar(sign);
-    Nokia5110_OutChar(n/10+'0'); /* tens digit */
-    Nokia5110_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-    Nokia5110_OutString("  ");
-    Nokia5110_OutChar(sign);
-    Nokia5110_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    Nokia5110_OutChar(n/10+'0'); /* tens digit */
-    Nokia5110_OutChar(n%10+'0'); /* ones digit */
-  }
-  else if(n<10000){
-    Nokia5110_OutChar(' ');
-    Nokia5110_OutChar(sign);
-    Nokia5110_OutChar(n/1000+'0'); /* thousands digit */
-    n = n%1000;
-    Nokia5110_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    Nokia5110_OutChar(n/10+'0'); /* tens digit */
-    Nokia5110_OutChar(n%10+'0'); /* ones digit */
-  }
-  else {
-    Nokia5110_OutChar(sign);
-    Nokia5110_OutChar(n/10000+'0'); /* ten-thousands digit */
-    n = n%10000;
-    Nokia5110_OutChar(n/1000+'0'); /* thousands digit */
-    n = n%1000;
-    Nokia5110_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    Nokia5110_OutChar(n/10+'0'); /* tens digit */
-    Nokia5110_OutChar(n%10+'0'); /* ones digit */
-  }
+    char message[FORMAT_BUFFER_SIZE];
+
+    // Sign and five right-justified digits
+    Format_SDec_Width(message, n, 6);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_OutUFix1(uint16_t n)
 {
-  char message[5];
-  if(n>999)n=999;
-  if(n>=100){  // 100 to 999
-    message[0] = (n/100+'0'); /* tens digit */
-    n = n%100; //the rest
-  }else { // 0 to 99
-    message[0] = ' '; /* n is between 0.0 and 9.9 */
-  }
-  message[1] = (n/10+'0'); /* ones digit */
-  n = n%10; //the rest
-  message[2] = '.';
-  message[3] = (n+'0'); /* tenths digit */
-  message[4] = 0;
-  Nokia5110_OutString(message);
+    char message[FORMAT_BUFFER_SIZE];
+
+    if (n > 999) n = 999;
+
+    // " 0.0" to "99.9"
+    Format_UFix(message, n, 1, 4);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_OutSFix1(int32_t n)
 {
-  char message[8];
-  if(n<-9999) n=-9999;
-  if(n>9999)  n=9999;
-  if(n<0){
-    message[0] = '-';
-    n = -n; // now positive
-  }else{
-    message[0] = ' ';
-  }
-  if(n>=1000){  // 1000 to 9999
-    message[1] = (n/1000+'0'); /* hundreds digit */
-    n = n%1000; // the rest
-    message[2] = (n/100+'0'); /* tens digit */
-    n = n%100;  // the rest
-  }else{
-    if(n>=100){  // 100 to 999
-      message[1] = ' '; /* n is between 0.0 and 9.9 */
-      message[2] = (n/100+'0'); /* tens digit */
-      n = n%100; //the rest
-    }else { // 0 to 99
-      message[1] = ' '; /* n is between 0.0 and 9.9 */
-      message[2] = ' ';
+    char message[FORMAT_BUFFER_SIZE];
+
+    if (n < -9999) n = -9999;
+    if (n > 9999) n = 9999;
+
+    // The sign is always in the first column, followed by "  0.0" to "999.9"
+    if (n < 0)
+    {
+        message[0] = '-';
+        n = -n;
     }
-  }
-  message[3] = (n/10+'0'); /* ones digit */
-  n = n%10; //the rest
-  message[4] = '.';
-  message[5] = (n+'0'); /* tenths digit */
-  message[6] = 0;
-  Nokia5110_OutString(message);
+    else
+    {
+        message[0] = ' ';
+    }
+    Format_UFix(&message[1], n, 1, 5);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_OutHex7(uint8_t n)
@@ -466,38 +462,27 @@ void Nokia5110_OutUHex7(uint8_t n)
 
 void Nokia5110_OutUDec16(uint32_t n)
 {
-  Nokia5110_OutChar(' ');
-  if(n>=100){
-    Nokia5110_OutChar(n/100+'0'); /* 100 digit */
-    n = n%100;
-    Nokia5110_OutChar(n/10+'0'); /* 10 digit */
-    Nokia5110_OutChar(n%10+'0'); /* ones digit */
-  }else{
-    Nokia5110_OutChar(' ');
-    if(n>=10){
-      Nokia5110_OutChar(n/10+'0'); /* 10 digit */
-      Nokia5110_OutChar(n%10+'0'); /* ones digit */
-    }else{
-      Nokia5110_OutChar(' ');
-      Nokia5110_OutChar(n+'0'); /* ones digit */
-    }
-  }
+    char message[FORMAT_BUFFER_SIZE];
+
+    // A space followed by three right-justified digits
+    message[0] = ' ';
+    Format_UDec_Width(&message[1], n, 3);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_OutUDec2(uint32_t n)
 {
-  if(n>=100){
-    Nokia5110_OutChar(' ');  /* 100 digit */
-    Nokia5110_OutChar('*'); /* illegal */
-  }else{
-    if(n>=10){
-      Nokia5110_OutChar(n/10+'0'); /* 10 digit */
-      Nokia5110_OutChar(n%10+'0'); /* ones digit */
-    }else{
-      Nokia5110_OutChar(' ');
-      Nokia5110_OutChar(n+'0'); /* ones digit */
+    char message[FORMAT_BUFFER_SIZE];
+
+    if (n >= 100)
+    {
+        Nokia5110_OutString(" *"); /* illegal */
+        return;
     }
-  }
+
+    // Two right-justified digits
+    Format_UDec_Width(message, n, 2);
+    Nokia5110_OutString(message);
 }
 
 void Nokia5110_SetCursor(uint8_t newX, uint8_t newY)
@@ -518,6 +503,8 @@ void Nokia5110_SetCursor(uint8_t newX, uint8_t newY)
 
 void Nokia5110_Clear()
 {
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
+
     for (int i = 0; i < (MAX_X*MAX_Y/8); i = i + 1)
     {
         Nokia5110_Data_Write(0x00);
@@ -527,6 +514,8 @@ void Nokia5110_Clear()
 
 void Nokia5110_DrawFullImage(const uint8_t *ptr)
 {
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
+
     Nokia5110_SetCursor(0, 0);
     for (int i = 0; i < (MAX_X*MAX_Y/8); i = i + 1)
     {
@@ -535,6 +524,36 @@ void Nokia5110_DrawFullImage(const uint8_t *ptr)
 }
 uint8_t Screen[SCREENW*SCREENH/8]; // buffer stores the next image to be printed on the screen
 
+// Mark every bank of the screen buffer as unmodified
+static void Nokia5110_Clear_Dirty()
+{
+    int bank;
+
+    for (bank = 0; bank < NOKIA5110_NUM_BANKS; bank = bank + 1)
+    {
+        Dirty_First_Column[bank] = SCREENW;
+        Dirty_Last_Column[bank] = 0;
+    }
+}
+
+void Nokia5110_Invalidate_Region(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    int32_t bank;
+
+    // Clip the region to the screen
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > (SCREENW - 1)) x1 = SCREENW - 1;
+    if (y1 > (SCREENH - 1)) y1 = SCREENH - 1;
+    if ((x0 > x1) || (y0 > y1)) return;
+
+    for (bank = (y0 >> 3); bank <= (y1 >> 3); bank = bank + 1)
+    {
+        if (x0 < Dirty_First_Column[bank]) Dirty_First_Column[bank] = x0;
+        if (x1 > Dirty_Last_Column[bank]) Dirty_Last_Column[bank] = x1;
+    }
+}
+
 void Nokia5110_PrintBMP(uint8_t xpos, uint8_t ypos, const uint8_t *ptr, uint8_t threshold){
   int32_t width = ptr[18], height = ptr[22], i, j;
   uint16_t screenx, screeny;
@@ -550,6 +569,7 @@ void Nokia5110_PrintBMP(uint8_t xpos, uint8_t ypos, const uint8_t *ptr, uint8_t
   if(threshold > 14){
     threshold = 14;             // only full 'on' turns pixel on
   }
+  Nokia5110_Invalidate_Region(xpos, ypos - height + 1, xpos + width - 1, ypos);
   // bitmaps are encoded backwards, so start at the bottom left corner of the image
   screeny = ypos/8;
   screenx = xpos + SCREENW*screeny;
@@ -598,11 +618,110 @@ void Nokia5110_ClearBuffer()
     {
         Screen[i] = 0;              // clear buffer
     }
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
 }
 
 void Nokia5110_DisplayBuffer()
 {
   Nokia5110_DrawFullImage(Screen);
+  Nokia5110_Clear_Dirty();
+}
+
+uint16_t Nokia5110_DisplayBuffer_Dirty()
+{
+    uint16_t bytes_sent = 0;
+    int bank;
+    int column;
+
+    for (bank = 0; bank < NOKIA5110_NUM_BANKS; bank = bank + 1)
+    {
+        if (Dirty_First_Column[bank] > Dirty_Last_Column[bank]) continue;
+
+        // Move the cursor to the first modified column of the bank
+        Nokia5110_Command_Write(0x80 | Dirty_First_Column[bank]);
+        Nokia5110_Command_Write(0x40 | bank);
+
+        for (column = Dirty_First_Column[bank]; column <= Dirty_Last_Column[bank]; column = column + 1)
+        {
+            Nokia5110_Data_Write(Screen[SCREENW*bank + column]);
+        }
+
+        bytes_sent = bytes_sent + 2 + (Dirty_Last_Column[bank] - Dirty_First_Column[bank] + 1);
+    }
+
+    Nokia5110_Clear_Dirty();
+
+    return bytes_sent;
+}
+
+// Called from DMA_INT0_IRQHandler when the last byte of the screen buffer has been written to the transmit buffer
+static void Nokia5110_Flush_Done()
+{
+    Flush_Active = 0;
+
+    if (Flush_Done_Task != 0)
+    {
+        (*Flush_Done_Task)();
+    }
+}
+
+uint8_t Nokia5110_DisplayBuffer_DMA(void (*done_task)(void))
+{
+    if (Flush_Active) return 0;
+
+    Nokia5110_SetCursor(0, 0);
+
+    // Wait until the cursor commands have been shifted out, then select data for the whole transfer
+    while((EUSCI_A3->STATW & 0x0001) == 0x0001);
+    Nokia5110_SPI_Data_Command_Bit_Out(0x01);
+
+    Flush_Done_Task = done_task;
+    Flush_Active = 1;
+    Nokia5110_Clear_Dirty();
+
+    if (DMA_Transfer_To_Peripheral(NOKIA5110_DMA_CHANNEL, NOKIA5110_DMA_SOURCE, Screen,
+                                   &EUSCI_A3->TXBUF, SCREENW*SCREENH/8, &Nokia5110_Flush_Done) == 0)
+    {
+        Flush_Active = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+uint8_t Nokia5110_OutString_DMA(const char *ptr, void (*done_task)(void))
+{
+    uint32_t num_chars;
+
+    if (Flush_Active) return 0;
+
+    // Reject strings that do not fit in the buffer instead of printing part of them
+    num_chars = Nokia5110_Text_Columns(ptr, Text_DMA_Buffer, NOKIA5110_TEXT_DMA_MAX_CHARS);
+    if ((num_chars == 0) || (ptr[num_chars] != 0)) return 0;
+
+    // The LCD no longer matches the screen buffer
+    Nokia5110_Invalidate_Region(0, 0, SCREENW - 1, SCREENH - 1);
+
+    // Wait until the previous bytes have been shifted out, then select data for the whole transfer
+    while((EUSCI_A3->STATW & 0x0001) == 0x0001);
+    Nokia5110_SPI_Data_Command_Bit_Out(0x01);
+
+    Flush_Done_Task = done_task;
+    Flush_Active = 1;
+
+    if (DMA_Transfer_To_Peripheral(NOKIA5110_DMA_CHANNEL, NOKIA5110_DMA_SOURCE, Text_DMA_Buffer,
+                                   &EUSCI_A3->TXBUF, num_chars * NOKIA5110_CHAR_WIDTH, &Nokia5110_Flush_Done) == 0)
+    {
+        Flush_Active = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+uint8_t Nokia5110_Flush_Busy()
+{
+    return Flush_Active;
 }
 
 const unsigned char Masks[8]={0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80};
@@ -610,9 +729,11 @@ const unsigned char Masks[8]={0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80};
 void Nokia5110_ClrPxl(uint32_t i, uint32_t j)
 {
   Screen[84*(i>>3) + j] &= ~Masks[i&0x07];
+  Nokia5110_Invalidate_Region(j, i, j, i);
 }
 
 void Nokia5110_SetPxl(uint32_t i, uint32_t j)
 {
   Screen[84*(i>>3) + j] |= Masks[i&0x07];
+  Nokia5110_Invalidate_Region(j, i, j, i);
 }
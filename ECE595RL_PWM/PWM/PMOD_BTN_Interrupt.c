@@ -23,6 +23,10 @@
  */
 
 #include "../inc/PMOD_BTN_Interrupt.h"
+#include "../inc/Cycle_Counter.h"
+
+// Pointer to the user-defined task executed by PORT6_IRQHandler
+void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
 
 void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t))
 {
@@ -74,9 +78,13 @@ uint8_t PMOD_BTN_Read(void)
 
 void PORT6_IRQHandler(void)
 {
+    ISR_PROFILE_BEGIN();
+
     // Clear the interrupt flags for P6.0 - P6.3
     P6->IFG &= ~0x0F;
 
     // Execute the user-defined task
     (*PMOD_BTN_Task)(PMOD_BTN_Read());
+
+    ISR_PROFILE_END(ISR_PROFILE_PORT6);
 }
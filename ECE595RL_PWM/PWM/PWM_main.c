@@ -7,7 +7,7 @@
  * Then, it uses the edge-triggered interrupts from the bump sensors to detect a collision,
  * which should immediately stop the motors from running.
  *
- * Timer A1 is used to generate periodic interrupts at a rate of 10 Hz, while Timer A2
+ * Timer A1 is used by the task scheduler to generate periodic interrupts at a rate of 1 kHz, while Timer A2
  * is used to generate PWM signals to drive two servos.
  *
  * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include "msp.h"
 #include "../inc/Clock.h"
 #include "../inc/CortexM.h"
@@ -25,6 +26,20 @@
 #include "../inc/Timer_A1_Interrupt.h"
 #include "../inc/Timer_A2_PWM.h"
 #include "../inc/Motor.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/Benchmark.h"
+#include "../inc/Binary_Log.h"
+#include "../inc/Command_Protocol.h"
+#include "../inc/Motion_Sequencer.h"
+#include "../inc/Task_Scheduler.h"
+#include "../inc/Servo_Trajectory.h"
+#include "../inc/Servo_Angle.h"
+#include "../inc/Servo_Mux.h"
+#include "../inc/Telemetry.h"
+
+// Set to 1 to back away from an obstacle with the collision handling sequence (see Handle_Collision).
+// When set to 0, a collision is only reported, and the collision flag stays set as in the original program.
+#define COLLISION_HANDLING_ENABLED 0
 
 // Global variable used to store the current state of the bumper sensors when an interrupt
 // occurs (Bumper_Sensors_Handler). It will get updated on each interrupt event.
@@ -34,14 +49,32 @@ uint8_t bumper_sensor_value;
 // This is used to detect if any collisions occurred
 uint8_t collision_detected = 0;
 
+// Global variable that gets set in Bumper_Sensors_Handler when a new collision is detected.
+// Motion_100_Hz_Task clears it and starts the collision handling sequence.
+volatile uint8_t collision_handling_requested = 0;
+
+// Global variable that gets set in Servo_Sweep_Task after each full sweep.
+// The main loop uses it to print the benchmark reports.
+volatile uint8_t sweep_completed = 0;
+
+void Handle_Collision();
+
 
 /**
  * @brief Bumper sensor interrupt handler function.
  *
- * This is the interrupt handler for the bumper sensor interrupts. It is called when a falling edge event is detected on
- * any of the bumper sensor pins. The function checks if a collision has already been detected; if not, it prints a collision
+ * This is the interrupt handler for the bumper sensor interrupts. It is called when a bumper switch is pressed
+ * (falling edge event), once per press. The function checks if a collision has already been detected; if not, it prints a collision
  * detection message along with the bumper sensor state and sets a collision flag to prevent further detections.
  *
+ * When COLLISION_HANDLING_ENABLED is set to 1, a new collision also requests the collision handling sequence,
+ * which is started by Motion_100_Hz_Task. Further presses are ignored until the sequence has completed and the
+ * collision flag has been cleared. Otherwise, the collision flag is never cleared.
+ * The motors are stopped before this handler is called (see BUMPER_SENSORS_EMERGENCY_STOP_ENABLED).
+ *
+ * The message is stored with BINARY_LOG1 instead of printf, so the handler does not wait for the UART.
+ * It is transmitted later by Binary_Log_Drain in Log_100_Hz_Task.
+ *
  * @param bumper_sensor_state An 8-bit unsigned integer representing the bump sensor states at the time of the interrupt.
  *
  * @return None
@@ -50,22 +83,26 @@ void Bumper_Sensors_Handler(uint8_t bumper_sensor_state)
 {
     if (collision_detected == 0)
     {
-        printf("Collision Detected! Bumper Sensor State: 0x%02X\n", bumper_sensor_state);
+        BINARY_LOG1("Collision Detected! Bumper Sensor State: 0x%02X\n", bumper_sensor_state);
         collision_detected = 1;
+
+#if (COLLISION_HANDLING_ENABLED)
+        // Back away from the obstacle. The sequence is started from Motion_100_Hz_Task instead of the interrupt.
+        collision_handling_requested = 1;
+#endif
     }
 }
 
 /**
- * @brief User-defined function executed by Timer A1 using a periodic interrupt at a rate of 10 Hz.
+ * @brief User-defined task executed by the task scheduler at a rate of 10 Hz.
  *
- * This task is executed by Timer A1 every time a periodic interrupt occurs at a rate of 10 Hz.
- * When an interrupt occurs and a collision has not been detected, it turns off the
+ * When the task runs and a collision has not been detected, it turns off the
  * back red LEDs and toggles the front yellow LEDs. But if a collision has been detected,
  * it turns off the front yellow LEDs and toggles the back red LEDs.
  *
  * @return None
  */
-void Timer_A1_10_Hz_Task(void)
+void LED_10_Hz_Task(void)
 {
     if (collision_detected == 0)
     {
@@ -80,103 +117,231 @@ void Timer_A1_10_Hz_Task(void)
 }
 
 /**
- * @brief Execute a predefined drive pattern using the motors.
+ * @brief User-defined task executed by the task scheduler at a rate of 100 Hz.
  *
- * This function executes a predefined drive pattern using the motors. It involves a sequence of motor commands
- * to create specific movements. The sequence consists of:
+ * This task starts the collision handling sequence when it has been requested by Bumper_Sensors_Handler
+ * (only when COLLISION_HANDLING_ENABLED is set to 1), then it advances the motion sequencer by one period (10 ms).
  *
- * 1. Setting both motors to move forward with a 50% duty cycle for a duration of 2 seconds.
- * 2. Stopping the motors for 2 seconds.
- * 3. Setting both motors to move left with a 30% duty cycle for 2 seconds.
- * 4. Stopping the motors for 2 seconds.
- * 5. Setting both motors to move right with a 30% duty cycle for 2 seconds.
- * 6. Stopping the motors for 2 seconds.
- * 7. Setting both motors to move backward with a 30% duty cycle for 2 seconds.
- * 8. Stopping the motors for 2 seconds.
+ * @return None
+ */
+void Motion_100_Hz_Task(void)
+{
+    if (collision_handling_requested)
+    {
+        collision_handling_requested = 0;
+        Handle_Collision();
+    }
+
+    Motion_Sequencer_Tick(10);
+}
+
+/**
+ * @brief User-defined task executed by the task scheduler at a rate of 100 Hz.
  *
- * @note This function assumes that the Motor_Forward, Motor_Left, Motor_Right, Motor_Backward,
- * and Motor_Stop functions are properly implemented and configured.
+ * This task transmits the binary log records stored by the interrupt service routines over UART.
+ * It runs 5 ms after Motion_100_Hz_Task so that the two tasks never share a tick.
+ *
+ * @return None
+ */
+void Log_100_Hz_Task(void)
+{
+    Binary_Log_Drain();
+}
+
+/**
+ * @brief User-defined task executed by the task scheduler at a rate of 200 Hz.
  *
- * @note The Clock_Delay1ms function is used to introduce delays between motor actions.
+ * This task ends the lockout of the bumper switches whose edges have settled and logs each debounced
+ * press and release with the time since the previous event of the same switch.
  *
  * @return None
  */
-void Drive_Pattern_1()
+void Bumper_Event_Task(void)
+{
+    Bumper_Event event;
+
+    Bumper_Sensors_Process();
+
+    while (Bumper_Sensors_Get_Event(&event))
+    {
+        BINARY_LOG3("BUMP_%u pressed=%u after %lu cycles\n", event.bumper, event.pressed, event.duration_cycles);
+    }
+}
+
+/**
+ * @brief Console line handler called by Command_Protocol_Process from the main loop.
+ *
+ * The "stats" command prints the fraction of time spent sleeping, the number of scheduler overruns,
+ * the number of received characters that were dropped, and the command frame counters.
+ * Any other line prints the list of commands.
+ *
+ * @param line Pointer to the NULL-terminated line.
+ * @param length The number of characters in the line.
+ *
+ * @return None
+ */
+void Console_Line_Task(char *line, uint16_t length)
+{
+    Command_Protocol_Stats protocol_stats;
+
+    if (strcmp(line, "stats") == 0)
+    {
+        Command_Protocol_Get_Stats(&protocol_stats);
+
+        printf("Sleep: %lu permille, Overruns: %lu, RX dropped: %lu\n",
+               (unsigned long)Task_Scheduler_Get_Sleep_Permille(),
+               (unsigned long)Task_Scheduler_Get_Overrun_Count(),
+               (unsigned long)EUSCI_A0_UART_Get_RX_Dropped_Count());
+        printf("Frames: %lu, CRC errors: %lu, Timeouts: %lu\n",
+               (unsigned long)protocol_stats.frame_count,
+               (unsigned long)protocol_stats.crc_error_count,
+               (unsigned long)protocol_stats.timeout_count);
+    }
+    else if (length > 0)
+    {
+        printf("Commands: stats\n");
+    }
+}
+
+/**
+ * @brief User-defined task executed by the task scheduler every 5 seconds.
+ *
+ * This task alternately rotates both servos to 0 degrees and 180 degrees.
+ * The moves are non-blocking: the Servo_Trajectory driver ramps the servos to the target
+ * over the following PWM frames while the scheduler keeps running the other tasks.
+ * The RGB LED is set to red at 0 degrees and blue at 180 degrees.
+ *
+ * @return None
+ */
+void Servo_Sweep_Task(void)
+{
+    static uint8_t servo_at_180 = 1;
+
+    if (servo_at_180)
+    {
+        // Rotate to 0
+        Servo_Angle_Move(SERVO_TRAJECTORY_SERVO_1, 0);
+        Servo_Angle_Move(SERVO_TRAJECTORY_SERVO_2, 0);
+        LED2_Output(RGB_LED_RED);
+        servo_at_180 = 0;
+    }
+    else
+    {
+        // Rotate to 180
+        Servo_Angle_Move(SERVO_TRAJECTORY_SERVO_1, 180000);
+        Servo_Angle_Move(SERVO_TRAJECTORY_SERVO_2, 180000);
+        LED2_Output(RGB_LED_BLUE);
+        servo_at_180 = 1;
+        sweep_completed = 1;
+    }
+}
+
+// Drive pattern executed by Drive_Pattern_1
+static const Motion_Step Drive_Pattern_1_Steps[] =
 {
     // Set PWM to 50% Duty Cycle
-    Motor_Forward(7500, 7500);
-    Clock_Delay1ms(2000);
+    {MOTION_FORWARD, 7500, 7500, 2000},
 
     // Stop the motors
-    Motor_Stop();
-    Clock_Delay1ms(2000);
+    {MOTION_STOP, 0, 0, 2000},
 
     // Set PWM to 30% Duty Cycle
-    Motor_Left(4500, 4500);
-    Clock_Delay1ms(2000);
+    {MOTION_LEFT, 4500, 4500, 2000},
 
     // Stop the motors
-    Motor_Stop();
-    Clock_Delay1ms(2000);
+    {MOTION_STOP, 0, 0, 2000},
 
     // Set PWM to 30% Duty Cycle
-    Motor_Right(4500, 4500);
-    Clock_Delay1ms(2000);
+    {MOTION_RIGHT, 4500, 4500, 2000},
 
     // Stop the motors
-    Motor_Stop();
-    Clock_Delay1ms(2000);
+    {MOTION_STOP, 0, 0, 2000},
 
     // Set PWM to 30% Duty Cycle
-    Motor_Backward(4500, 4500);
-    Clock_Delay1ms(2000);
+    {MOTION_BACKWARD, 4500, 4500, 2000},
 
     // Stop the motors
-    Motor_Stop();
-    Clock_Delay1ms(2000);
-}
+    {MOTION_STOP, 0, 0, 2000}
+};
 
-void Handle_Collision()
+// Collision handling sequence executed by Handle_Collision
+static const Motion_Step Collision_Steps[] =
 {
     // Stop the motors
-    Motor_Stop();
-
-    // Make a function call to Clock_Delay1ms(2000)
-    Clock_Delay1ms(2000);
+    {MOTION_STOP, 0, 0, 2000},
 
     // Move the motors backward with 30% duty cycle
-    Motor_Backward(4500, 4500);
-
-    // Make a function call to Clock_Delay1ms(3000)
-    Clock_Delay1ms(3000);
+    {MOTION_BACKWARD, 4500, 4500, 3000},
 
     // Stop the motors
-    Motor_Stop();
-
-    // Make a function call to Clock_Delay1ms(1000)
-    Clock_Delay1ms(1000);
+    {MOTION_STOP, 0, 0, 1000},
 
     // Make the robot turn to the right with 10% duty cycle
-    Motor_Right(1500, 1500);
-
-    // Make a function call to Clock_Delay1ms(5000)
-    Clock_Delay1ms(5000);
+    {MOTION_RIGHT, 1500, 1500, 5000},
 
     // Stop the motors
-    Motor_Stop();
+    {MOTION_STOP, 0, 0, 2000}
+};
 
-    // Make a function call to Clock_Delay1ms(2000)
-    Clock_Delay1ms(2000);
+/**
+ * @brief Start a predefined drive pattern using the motors.
+ *
+ * This function starts a predefined drive pattern using the motion sequencer. The sequence consists of:
+ *
+ * 1. Setting both motors to move forward with a 50% duty cycle for a duration of 2 seconds.
+ * 2. Stopping the motors for 2 seconds.
+ * 3. Setting both motors to move left with a 30% duty cycle for 2 seconds.
+ * 4. Stopping the motors for 2 seconds.
+ * 5. Setting both motors to move right with a 30% duty cycle for 2 seconds.
+ * 6. Stopping the motors for 2 seconds.
+ * 7. Setting both motors to move backward with a 30% duty cycle for 2 seconds.
+ * 8. Stopping the motors for 2 seconds.
+ *
+ * @note The function returns immediately. The steps are advanced by Motion_Sequencer_Tick,
+ * which is called from Motion_100_Hz_Task.
+ *
+ * @return None
+ */
+void Drive_Pattern_1()
+{
+    Motion_Sequencer_Start(Drive_Pattern_1_Steps, sizeof(Drive_Pattern_1_Steps) / sizeof(Motion_Step), 0);
+}
 
+/**
+ * @brief Called by the motion sequencer when the collision handling sequence has completed.
+ *
+ * @return None
+ */
+void Collision_Done_Handler(void)
+{
     // Set the collision_detected flag to 0
     collision_detected = 0;
 }
 
+/**
+ * @brief Start the collision handling sequence.
+ *
+ * This function preempts any running drive pattern. The robot stops for 2 seconds, moves backward
+ * with a 30% duty cycle for 3 seconds, stops for 1 second, turns right with a 10% duty cycle for 5 seconds,
+ * and stops for 2 seconds. Then, the collision_detected flag is cleared by Collision_Done_Handler.
+ *
+ * @note The function returns immediately. It is called from Motion_100_Hz_Task after a collision.
+ *
+ * @return None
+ */
+void Handle_Collision()
+{
+    Motion_Sequencer_Start(Collision_Steps, sizeof(Collision_Steps) / sizeof(Motion_Step), &Collision_Done_Handler);
+}
+
 int main(void)
 {
     // Initialize the 48 MHz Clock
     Clock_Init48MHz();
 
+    // Initialize the DWT cycle counter used to profile the interrupt service routines
+    Cycle_Counter_Init();
+
     // Initialize the built-in red LED
     LED1_Init();
     LED2_Init();
@@ -188,52 +353,110 @@ int main(void)
     Buttons_Init();
 
     // Initialize EUSCI_A0_UART
+    // Command frames are executed in the main loop, and the other received lines are passed to Console_Line_Task
     EUSCI_A0_UART_Init_Printf();
+    EUSCI_A0_UART_Set_Line_Task(&Console_Line_Task);
+    Command_Protocol_Init();
 
     // Initialize the bumper sensors which will be used to generate external I/O-triggered interrupts
     Bumper_Sensors_Init(&Bumper_Sensors_Handler);
 
-    // Initialize Timer A1 with interrupts enabled
-    // Default frequency is set to 10 Hz
-    Timer_A1_Interrupt_Init(&Timer_A1_10_Hz_Task, TIMER_A1_INT_CCR0_VALUE);
+    // Initialize the task scheduler, which uses Timer A1 to generate a 1 kHz tick
+    // Then, register the periodic tasks with their period and phase offset in ticks
+    Task_Scheduler_Init();
+    Task_Scheduler_Add(&LED_10_Hz_Task, 100, 0);
+    Task_Scheduler_Add(&Motion_100_Hz_Task, 10, 0);
+    Task_Scheduler_Add(&Log_100_Hz_Task, 10, 5);
+    Task_Scheduler_Add(&Servo_Sweep_Task, 5000, 0);
+    Task_Scheduler_Add(&Bumper_Event_Task, 5, 1);
+
+#if (TELEMETRY_ENABLED)
+    // Stream the telemetry frames at 100 Hz with DMA channel 0, 2 ms after Motion_100_Hz_Task
+    DMA_Init();
+    Telemetry_Init(2);
+#endif
 
     // Initialize Timer A2 with a period of 50 Hz
     // Timer A2 is used to drive two servos
     Timer_A2_PWM_Init(60000, 0, 0);
 
+    // Start the servos at 0 degrees and limit their velocity and acceleration
+    Servo_Trajectory_Init(Servo_Angle_To_Counts(SERVO_TRAJECTORY_SERVO_1, 0), Servo_Angle_To_Counts(SERVO_TRAJECTORY_SERVO_2, 0));
+
+#if (SERVO_MUX_ENABLED)
+    // Initialize the multiplexed servo outputs on Timer A3 and center all channels (1.5 ms)
+    Servo_Mux_Init();
+    for (int channel = 0; channel < SERVO_MUX_NUM_CHANNELS; channel = channel + 1)
+    {
+        Servo_Mux_Set_Pulse_Us(channel, 1500);
+    }
+#endif
+
     // Initialize the motors
     Motor_Init();
 
+    // Initialize the motion sequencer used by Drive_Pattern_1 and Handle_Collision
+    Motion_Sequencer_Init();
+
     // Initialize collision_detected flag
     collision_detected = 0;
 
     // Enable the interrupts used by the bumper sensors and Timer A1
     EnableInterrupts();
 
+#if (BENCHMARK_ENABLED)
+    // Print the accuracy of the servo angle conversion once, since it does not change at run time
+    Benchmark_Print_Servo_Angle_Table();
+
+    // Compare the cost of drawing the LCD screen buffer with and without the uDMA controller
+    Nokia5110_Init();
+    DMA_Init();
+    Benchmark_Print_LCD_Flush_Table();
+    Benchmark_Print_LCD_Dirty_Table();
+    Benchmark_Print_SPI_Rate_Table();
+    Benchmark_Print_Graphics_Table();
+    Benchmark_Print_LCD_Text_Table();
+    Benchmark_Print_Format_Table();
+
+    // Measure the time taken by PORT4_IRQHandler to stop the motors after a press
+    Benchmark_Print_Emergency_Stop_Table();
+#endif
+
     while(1)
     {
-//        Drive_Pattern_1();
+//        if (Motion_Sequencer_Is_Busy() == 0)
+//        {
+//            Drive_Pattern_1();
+//        }
 
-        // Rotate to 0
-        Timer_A2_Update_Duty_Cycle_1(1700);
-        Timer_A2_Update_Duty_Cycle_2(1700);
-        LED2_Output(RGB_LED_RED);
-        Clock_Delay1ms(5000);
+        // Sleep until the next interrupt. The servos are driven by Servo_Sweep_Task.
+        Task_Scheduler_Idle();
 
-        // Rotate to 180
-        Timer_A2_Update_Duty_Cycle_1(7000);
-        Timer_A2_Update_Duty_Cycle_2(7000);
-        LED2_Output(RGB_LED_BLUE);
-        Clock_Delay1ms(5000);
+        // Execute the command frames and edit the console line with the characters received while sleeping
+        Command_Protocol_Process();
+
+#if (BENCHMARK_ENABLED)
+        if (sweep_completed == 1)
+        {
+            sweep_completed = 0;
+
+            // Print the execution time statistics of the interrupt service routines
+            Benchmark_Print_ISR_Table();
 
-//        if (collision_detected == 0)
+            // Print the execution time statistics of the scheduled tasks
+            Benchmark_Print_Task_Table();
+
+#if (SERVO_MUX_ENABLED)
+            // Print the timing statistics of the multiplexed servo outputs
+            Benchmark_Print_Servo_Mux_Table();
+#endif
+        }
+#endif
+
+//        if ((collision_detected == 0) && (Motion_Sequencer_Is_Busy() == 0))
 //        {
 //            // Move forward for an indefinite amount of time with 50% duty cycle
 //            Motor_Forward(7500, 7500);
-//        }
-//        else
-//        {
-//            Handle_Collision();
 //        }
     }
 }
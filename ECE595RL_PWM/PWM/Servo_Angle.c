@@ -0,0 +1,46 @@
+/**
+ * @file Servo_Angle.c
+ * @brief Source code for the Servo_Angle driver.
+ *
+ * This file contains the function definitions for the Servo_Angle driver.
+ * It converts servo angles in millidegrees to Timer A2 compare register counts
+ * using a calibration table that is computed at compile time.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Servo_Angle.h"
+
+// Calibration table stored in flash, indexed by Servo_Trajectory_ID
+static const Servo_Angle_Calibration Servo_Calibration[SERVO_TRAJECTORY_NUM_SERVOS] =
+{
+    {SERVO_1_MIN_COUNTS, SERVO_1_MAX_COUNTS, SERVO_ANGLE_SCALE(SERVO_1_MIN_COUNTS, SERVO_1_MAX_COUNTS)},
+    {SERVO_2_MIN_COUNTS, SERVO_2_MAX_COUNTS, SERVO_ANGLE_SCALE(SERVO_2_MIN_COUNTS, SERVO_2_MAX_COUNTS)}
+};
+
+uint16_t Servo_Angle_To_Counts(Servo_Trajectory_ID servo, uint32_t millidegrees)
+{
+    const Servo_Angle_Calibration *calibration = &Servo_Calibration[servo];
+
+    if (millidegrees > SERVO_ANGLE_MAX_MILLIDEGREES) millidegrees = SERVO_ANGLE_MAX_MILLIDEGREES;
+
+    // Add half of the least significant bit to round to the nearest count
+    return (uint16_t)(calibration->min_counts +
+        ((millidegrees * calibration->scale + (1 << (SERVO_ANGLE_SCALE_SHIFT - 1))) >> SERVO_ANGLE_SCALE_SHIFT));
+}
+
+const Servo_Angle_Calibration *Servo_Angle_Get_Calibration(Servo_Trajectory_ID servo)
+{
+    return &Servo_Calibration[servo];
+}
+
+void Servo_Angle_Move(Servo_Trajectory_ID servo, uint32_t millidegrees)
+{
+    Servo_Trajectory_Move(servo, Servo_Angle_To_Counts(servo, millidegrees));
+}
+
+void Servo_Angle_Move_Blocking(Servo_Trajectory_ID servo, uint32_t millidegrees)
+{
+    Servo_Trajectory_Move_Blocking(servo, Servo_Angle_To_Counts(servo, millidegrees));
+}
@@ -0,0 +1,229 @@
+/**
+ * @file Servo_Mux.c
+ * @brief Source code for the Servo_Mux driver.
+ *
+ * This file contains the function definitions for the Servo_Mux driver.
+ * It uses Timer A3 to generate the pulses of several servos one after another within each 20 ms frame.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Servo_Mux.h"
+
+// Output pin of a channel
+typedef struct
+{
+    volatile uint8_t *out;
+    volatile uint8_t *dir;
+    volatile uint8_t *sel0;
+    volatile uint8_t *sel1;
+    uint8_t mask;
+} Servo_Mux_Pin;
+
+#define SERVO_MUX_PIN(port, pin_mask)   {&(port)->OUT, &(port)->DIR, &(port)->SEL0, &(port)->SEL1, (pin_mask)}
+
+// Output pins, indexed by channel
+static const Servo_Mux_Pin Servo_Mux_Pins[SERVO_MUX_NUM_CHANNELS] =
+{
+    SERVO_MUX_PIN(P7, 0x01),
+    SERVO_MUX_PIN(P7, 0x02),
+    SERVO_MUX_PIN(P7, 0x04),
+    SERVO_MUX_PIN(P7, 0x08),
+    SERVO_MUX_PIN(P7, 0x10),
+    SERVO_MUX_PIN(P7, 0x20),
+    SERVO_MUX_PIN(P7, 0x40),
+    SERVO_MUX_PIN(P7, 0x80)
+};
+
+// Requested pulse width of each channel, in counts. A value of 0 disables the channel.
+static volatile uint16_t Pulse_Counts[SERVO_MUX_NUM_CHANNELS];
+
+static volatile Servo_Mux_Stats Channel_Stats[SERVO_MUX_NUM_CHANNELS];
+
+// Channel whose slot starts at the next CCR0 compare event
+static uint8_t Next_Channel = 0;
+
+// Channel whose pulse is currently high, and the requested width and start time of that pulse
+static uint8_t Active_Channel = 0;
+static uint16_t Active_Pulse_Counts = 0;
+static uint16_t Active_Rise_Time = 0;
+
+// Update the latency statistics of a channel
+static void Servo_Mux_Record_Latency(volatile Servo_Mux_Stats *stats, uint16_t latency)
+{
+    if (latency < stats->min_latency)
+    {
+        stats->min_latency = latency;
+    }
+
+    if (latency > stats->max_latency)
+    {
+        stats->max_latency = latency;
+    }
+}
+
+void Servo_Mux_Init(void)
+{
+    int i;
+
+    // Stop Timer A3 while it is being configured
+    TIMER_A3->CTL &= ~0x0030;
+
+    for (i = 0; i < SERVO_MUX_NUM_CHANNELS; i = i + 1)
+    {
+        // Configure the pin as GPIO output, driven low
+        *Servo_Mux_Pins[i].sel0 &= ~Servo_Mux_Pins[i].mask;
+        *Servo_Mux_Pins[i].sel1 &= ~Servo_Mux_Pins[i].mask;
+        *Servo_Mux_Pins[i].dir |= Servo_Mux_Pins[i].mask;
+        *Servo_Mux_Pins[i].out &= ~Servo_Mux_Pins[i].mask;
+
+        Pulse_Counts[i] = 0;
+    }
+
+    Servo_Mux_Reset_Stats();
+    Next_Channel = 0;
+
+    // Configure the Timer A3 expansion register to divide the clock frequency by 1
+    TIMER_A3->EX0 = 0x0000;
+
+    // Select SMCLK = 12 MHz as timer clock source
+    // Set ID = 0 (Divide timer clock by 1)
+    // Clear the timer counter with the TACLR bit
+    TIMER_A3->CTL = 0x0204;
+
+    // CCR0 marks the start of each slot. The first slot starts one slot length from now.
+    TIMER_A3->CCR[0] = SERVO_MUX_SLOT_COUNTS;
+    TIMER_A3->CCTL[0] = 0x0010;
+
+    // CCR1 marks the end of each pulse. Its interrupt is enabled only while a pulse is high.
+    TIMER_A3->CCTL[1] = 0x0000;
+
+    // Set interrupt priority level to 1 for TA3_0 (IRQ 14) and TA3_N (IRQ 15)
+    NVIC->IP[3] = (NVIC->IP[3] & 0x0000FFFF) | 0x20200000;
+
+    // Enable Interrupt 14 and Interrupt 15 in NVIC
+    NVIC->ISER[0] = 0x0000C000;
+
+    // Set MC = 2 (Continuous Mode)
+    TIMER_A3->CTL |= 0x0020;
+}
+
+void Servo_Mux_Set_Pulse(uint8_t channel, uint16_t pulse_counts)
+{
+    if (channel >= SERVO_MUX_NUM_CHANNELS) return;
+
+    if (pulse_counts > SERVO_MUX_MAX_PULSE_COUNTS)
+    {
+        pulse_counts = SERVO_MUX_MAX_PULSE_COUNTS;
+    }
+
+    Pulse_Counts[channel] = pulse_counts;
+}
+
+void Servo_Mux_Set_Pulse_Us(uint8_t channel, uint16_t pulse_us)
+{
+    uint32_t pulse_counts = (uint32_t)pulse_us * SERVO_MUX_COUNTS_PER_US;
+
+    if (pulse_counts > SERVO_MUX_MAX_PULSE_COUNTS)
+    {
+        pulse_counts = SERVO_MUX_MAX_PULSE_COUNTS;
+    }
+
+    Servo_Mux_Set_Pulse(channel, (uint16_t)pulse_counts);
+}
+
+void Servo_Mux_Get_Stats(uint8_t channel, Servo_Mux_Stats *stats)
+{
+    long sr;
+
+    sr = StartCritical();
+    stats->pulse_count = Channel_Stats[channel].pulse_count;
+    stats->min_latency = Channel_Stats[channel].min_latency;
+    stats->max_latency = Channel_Stats[channel].max_latency;
+    stats->max_width_error = Channel_Stats[channel].max_width_error;
+    EndCritical(sr);
+
+    if (stats->pulse_count == 0)
+    {
+        stats->min_latency = 0;
+    }
+}
+
+void Servo_Mux_Reset_Stats(void)
+{
+    int i;
+    long sr;
+
+    sr = StartCritical();
+    for (i = 0; i < SERVO_MUX_NUM_CHANNELS; i = i + 1)
+    {
+        Channel_Stats[i].pulse_count = 0;
+        Channel_Stats[i].min_latency = 0xFFFF;
+        Channel_Stats[i].max_latency = 0;
+        Channel_Stats[i].max_width_error = 0;
+    }
+    EndCritical(sr);
+}
+
+void TA3_0_IRQHandler(void)
+{
+    uint8_t channel = Next_Channel;
+    uint16_t pulse_counts = Pulse_Counts[channel];
+    uint16_t slot_start = TIMER_A3->CCR[0];
+    uint16_t rise_time;
+
+    // Acknowledge Capture/Compare interrupt and clear it
+    TIMER_A3->CCTL[0] &= ~0x0001;
+
+    if (pulse_counts != 0)
+    {
+        // Start the pulse, then record when it actually started
+        *Servo_Mux_Pins[channel].out |= Servo_Mux_Pins[channel].mask;
+        rise_time = TIMER_A3->R;
+
+        // Schedule the end of the pulse relative to the compare event, not the time at which the pin was written
+        TIMER_A3->CCR[1] = slot_start + pulse_counts;
+        TIMER_A3->CCTL[1] = 0x0010;
+
+        Active_Channel = channel;
+        Active_Pulse_Counts = pulse_counts;
+        Active_Rise_Time = rise_time;
+        Servo_Mux_Record_Latency(&Channel_Stats[channel], (uint16_t)(rise_time - slot_start));
+    }
+
+    // Schedule the start of the next slot. The 16-bit addition wraps around with the counter.
+    TIMER_A3->CCR[0] = slot_start + SERVO_MUX_SLOT_COUNTS;
+
+    Next_Channel = (channel + 1 < SERVO_MUX_NUM_CHANNELS) ? (channel + 1) : 0;
+}
+
+void TA3_N_IRQHandler(void)
+{
+    uint8_t channel = Active_Channel;
+    volatile Servo_Mux_Stats *stats = &Channel_Stats[channel];
+    uint16_t fall_time;
+    uint16_t width;
+    uint16_t width_error;
+
+    // Only CCR1 is enabled. Reading the interrupt vector register clears the highest pending flag.
+    if (TIMER_A3->IV != 0x0002) return;
+
+    // End the pulse, then record when it actually ended
+    *Servo_Mux_Pins[channel].out &= ~Servo_Mux_Pins[channel].mask;
+    fall_time = TIMER_A3->R;
+
+    // Disable the CCR1 interrupt until the next pulse
+    TIMER_A3->CCTL[1] = 0x0000;
+
+    Servo_Mux_Record_Latency(stats, (uint16_t)(fall_time - TIMER_A3->CCR[1]));
+
+    width = fall_time - Active_Rise_Time;
+    width_error = (width > Active_Pulse_Counts) ? (width - Active_Pulse_Counts) : (Active_Pulse_Counts - width);
+    if (width_error > stats->max_width_error)
+    {
+        stats->max_width_error = width_error;
+    }
+
+    stats->pulse_count = stats->pulse_count + 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file Servo_Trajectory.c
+ * @brief Source code for the Servo_Trajectory driver.
+ *
+ * This file contains the function definitions for the Servo_Trajectory driver.
+ * It moves the two servos connected to Timer A2 along a trapezoidal velocity profile,
+ * which is advanced once per PWM frame by the Timer A2 CCR0 interrupt.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Servo_Trajectory.h"
+
+// Number of fractional bits used for positions and velocities
+#define Q8_SHIFT    8
+
+// Trajectory state of a single servo. Positions and velocities are stored in Q8 format.
+typedef struct
+{
+    int32_t position;
+    int32_t velocity;
+    int32_t target;
+    int32_t max_velocity;
+    int32_t max_acceleration;
+    uint8_t done;
+} Servo_Trajectory_State;
+
+static volatile Servo_Trajectory_State Servo_States[SERVO_TRAJECTORY_NUM_SERVOS];
+
+// Distance traveled while decelerating from the given speed to zero, in Q8 format
+static uint32_t Servo_Trajectory_Stopping_Distance(uint32_t speed, uint32_t acceleration)
+{
+    // (speed^2 / 2a) is in Q16 / Q8 = Q8. The speed is limited so that its square fits in 32 bits.
+    return (speed * speed) / (2 * acceleration);
+}
+
+// Advance the trajectory of one servo by a single frame
+static void Servo_Trajectory_Step(volatile Servo_Trajectory_State *state)
+{
+    int32_t error;
+    int32_t direction;
+    uint32_t distance;
+    int32_t speed;
+    int32_t accelerated_speed;
+    int32_t acceleration = state->max_acceleration;
+
+    if (state->done) return;
+
+    error = state->target - state->position;
+    direction = (error >= 0) ? 1 : -1;
+    distance = (uint32_t)(error * direction);
+
+    // Speed along the direction of the target. It is negative if the servo is moving away from the target.
+    speed = state->velocity * direction;
+
+    if (speed < 0)
+    {
+        // Brake before reversing direction
+        speed = speed + acceleration;
+        if (speed > 0) speed = 0;
+    }
+    else
+    {
+        accelerated_speed = speed + acceleration;
+        if (accelerated_speed > state->max_velocity) accelerated_speed = state->max_velocity;
+
+        if ((Servo_Trajectory_Stopping_Distance(accelerated_speed, acceleration) + accelerated_speed) <= distance)
+        {
+            // Accelerate, or cruise at the maximum velocity
+            speed = accelerated_speed;
+        }
+        else if ((Servo_Trajectory_Stopping_Distance(speed, acceleration) + speed) > distance)
+        {
+            // Decelerate, but keep a minimum speed so that the servo always reaches the target
+            speed = speed - acceleration;
+            if (speed < acceleration) speed = acceleration;
+        }
+        else if (speed == 0)
+        {
+            // The remaining distance is too short to accelerate and brake again
+            speed = acceleration;
+        }
+
+        if ((uint32_t)speed >= distance)
+        {
+            // The target is reached within this frame
+            state->position = state->target;
+            state->velocity = 0;
+            state->done = 1;
+            return;
+        }
+    }
+
+    state->velocity = speed * direction;
+    state->position = state->position + state->velocity;
+}
+
+// Task registered with Timer_A2_PWM_Set_Period_Task. It runs once per 20 ms frame.
+static void Servo_Trajectory_Frame_Task(void)
+{
+    Servo_Trajectory_Step(&Servo_States[SERVO_TRAJECTORY_SERVO_1]);
+    Servo_Trajectory_Step(&Servo_States[SERVO_TRAJECTORY_SERVO_2]);
+
+    // Round the Q8 positions to the nearest count
+    Timer_A2_Update_Duty_Cycle_1((uint16_t)((Servo_States[SERVO_TRAJECTORY_SERVO_1].position + (1 << (Q8_SHIFT - 1))) >> Q8_SHIFT));
+    Timer_A2_Update_Duty_Cycle_2((uint16_t)((Servo_States[SERVO_TRAJECTORY_SERVO_2].position + (1 << (Q8_SHIFT - 1))) >> Q8_SHIFT));
+}
+
+void Servo_Trajectory_Init(uint16_t initial_position_1, uint16_t initial_position_2)
+{
+    int i;
+
+    Servo_States[SERVO_TRAJECTORY_SERVO_1].position = (int32_t)initial_position_1 << Q8_SHIFT;
+    Servo_States[SERVO_TRAJECTORY_SERVO_2].position = (int32_t)initial_position_2 << Q8_SHIFT;
+
+    for (i = 0; i < SERVO_TRAJECTORY_NUM_SERVOS; i = i + 1)
+    {
+        Servo_States[i].target = Servo_States[i].position;
+        Servo_States[i].velocity = 0;
+        Servo_States[i].done = 1;
+        Servo_Trajectory_Set_Limits((Servo_Trajectory_ID)i, SERVO_TRAJECTORY_DEFAULT_MAX_VELOCITY, SERVO_TRAJECTORY_DEFAULT_MAX_ACCELERATION);
+    }
+
+    Timer_A2_Update_Duty_Cycle_1(initial_position_1);
+    Timer_A2_Update_Duty_Cycle_2(initial_position_2);
+
+    Timer_A2_PWM_Set_Period_Task(&Servo_Trajectory_Frame_Task);
+}
+
+void Servo_Trajectory_Set_Limits(Servo_Trajectory_ID servo, uint16_t max_velocity, uint16_t max_acceleration)
+{
+    long sr;
+
+    if (max_velocity > SERVO_TRAJECTORY_VELOCITY_LIMIT) max_velocity = SERVO_TRAJECTORY_VELOCITY_LIMIT;
+    if (max_velocity == 0) max_velocity = 1;
+    if (max_acceleration == 0) max_acceleration = 1;
+
+    sr = StartCritical();
+    Servo_States[servo].max_velocity = (int32_t)max_velocity << Q8_SHIFT;
+    Servo_States[servo].max_acceleration = (int32_t)max_acceleration << Q8_SHIFT;
+    EndCritical(sr);
+}
+
+void Servo_Trajectory_Move(Servo_Trajectory_ID servo, uint16_t target_position)
+{
+    long sr;
+
+    sr = StartCritical();
+    Servo_States[servo].target = (int32_t)target_position << Q8_SHIFT;
+    if ((Servo_States[servo].target != Servo_States[servo].position) || (Servo_States[servo].velocity != 0))
+    {
+        Servo_States[servo].done = 0;
+    }
+    EndCritical(sr);
+}
+
+void Servo_Trajectory_Move_Blocking(Servo_Trajectory_ID servo, uint16_t target_position)
+{
+    Servo_Trajectory_Move(servo, target_position);
+
+    while (Servo_Trajectory_Is_Done(servo) == 0)
+    {
+        WaitForInterrupt();
+    }
+}
+
+uint8_t Servo_Trajectory_Is_Done(Servo_Trajectory_ID servo)
+{
+    return Servo_States[servo].done;
+}
+
+uint16_t Servo_Trajectory_Get_Position(Servo_Trajectory_ID servo)
+{
+    return (uint16_t)((Servo_States[servo].position + (1 << (Q8_SHIFT - 1))) >> Q8_SHIFT);
+}
@@ -0,0 +1,289 @@
+/**
+ * @file Task_Scheduler.c
+ * @brief Source code for the Task_Scheduler driver.
+ *
+ * This file contains the function definitions for the Task_Scheduler driver.
+ * It runs multiple periodic tasks from the TA1_0 interrupt.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Task_Scheduler.h"
+
+// A registered task
+typedef struct
+{
+    void (*task)(void);
+    uint16_t period_ticks;
+    uint16_t countdown;
+    uint32_t run_count;
+    uint32_t overrun_count;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+} Task_Scheduler_Entry;
+
+static Task_Scheduler_Entry Tasks[TASK_SCHEDULER_MAX_TASKS];
+static uint8_t Num_Tasks = 0;
+
+static volatile uint32_t Tick_Count = 0;
+static volatile uint32_t Scheduler_Overrun_Count = 0;
+
+// Number of CPU clock cycles in a single tick
+static uint32_t Cycles_Per_Tick = 0;
+
+// Number of ticks between the previous interrupt and the next one
+static uint16_t Ticks_Per_Interrupt = 1;
+
+// Timer A1 counts accumulated at each interrupt, and Timer A1 counts spent sleeping in Task_Scheduler_Idle
+static volatile uint64_t Elapsed_Counts = 0;
+static uint64_t Sleep_Counts = 0;
+
+void Task_Scheduler_Init(void)
+{
+    Num_Tasks = 0;
+    Tick_Count = 0;
+    Scheduler_Overrun_Count = 0;
+    Cycles_Per_Tick = Clock_GetFreq() / TASK_SCHEDULER_TICK_HZ;
+    Ticks_Per_Interrupt = 1;
+    Elapsed_Counts = 0;
+    Sleep_Counts = 0;
+
+    Timer_A1_Interrupt_Init(&Task_Scheduler_Tick, TASK_SCHEDULER_CCR0_VALUE);
+}
+
+int8_t Task_Scheduler_Add(void(*task)(void), uint16_t period_ticks, uint16_t phase_ticks)
+{
+    Task_Scheduler_Entry *entry;
+    int8_t task_id;
+    long sr;
+
+    if ((task == 0) || (period_ticks == 0)) return -1;
+
+    sr = StartCritical();
+    if (Num_Tasks >= TASK_SCHEDULER_MAX_TASKS)
+    {
+        EndCritical(sr);
+        return -1;
+    }
+
+    task_id = Num_Tasks;
+    entry = &Tasks[task_id];
+    entry->task = task;
+    entry->period_ticks = period_ticks;
+    entry->countdown = phase_ticks + 1;
+    entry->run_count = 0;
+    entry->overrun_count = 0;
+    entry->last_cycles = 0;
+    entry->max_cycles = 0;
+    entry->sum_cycles = 0;
+
+    // Publish the task only after it has been fully initialized
+    Num_Tasks = Num_Tasks + 1;
+    EndCritical(sr);
+
+    return task_id;
+}
+
+void Task_Scheduler_Set_Period(int8_t task_id, uint16_t period_ticks)
+{
+    if ((task_id < 0) || (task_id >= Num_Tasks) || (period_ticks == 0)) return;
+
+    Tasks[task_id].period_ticks = period_ticks;
+}
+
+uint32_t Task_Scheduler_Get_Ticks(void)
+{
+    return Tick_Count;
+}
+
+uint32_t Task_Scheduler_Get_Overrun_Count(void)
+{
+    return Scheduler_Overrun_Count;
+}
+
+uint8_t Task_Scheduler_Get_Num_Tasks(void)
+{
+    return Num_Tasks;
+}
+
+void Task_Scheduler_Get_Stats(int8_t task_id, Task_Scheduler_Stats *stats)
+{
+    Task_Scheduler_Entry *entry;
+    uint64_t sum_cycles;
+    long sr;
+
+    if ((task_id < 0) || (task_id >= Num_Tasks)) return;
+
+    entry = &Tasks[task_id];
+
+    sr = StartCritical();
+    stats->run_count = entry->run_count;
+    stats->overrun_count = entry->overrun_count;
+    stats->last_cycles = entry->last_cycles;
+    stats->max_cycles = entry->max_cycles;
+    sum_cycles = entry->sum_cycles;
+    EndCritical(sr);
+
+    stats->mean_cycles = (stats->run_count == 0) ? 0 : (uint32_t)(sum_cycles / stats->run_count);
+}
+
+// Return the number of Timer A1 counts elapsed since Task_Scheduler_Init was called
+// This function must be called with interrupts disabled
+static uint64_t Task_Scheduler_Now(void)
+{
+    uint16_t pending_before;
+    uint16_t pending_after;
+    uint32_t counts;
+
+    // Read the counter between two reads of the CCR0 interrupt flag, so that a
+    // period that ended while interrupts are disabled is not lost
+    do
+    {
+        pending_before = TIMER_A1->CCTL[0] & 0x0001;
+        counts = TIMER_A1->R;
+        pending_after = TIMER_A1->CCTL[0] & 0x0001;
+    } while (pending_before != pending_after);
+
+    // The flag is set when the counter reaches CCR0, and the counter returns to 0 on the next count
+    if (pending_after && (counts != TIMER_A1->CCR[0]))
+    {
+        counts = counts + TIMER_A1->CCR[0] + 1;
+    }
+
+    return (Elapsed_Counts + counts);
+}
+
+void Task_Scheduler_Idle(void)
+{
+    uint64_t start_counts;
+    long sr;
+
+    // With interrupts disabled, a pending interrupt still wakes up the CPU,
+    // but its handler only runs after the sleep time has been recorded
+    sr = StartCritical();
+    start_counts = Task_Scheduler_Now();
+    WaitForInterrupt();
+    Sleep_Counts = Sleep_Counts + (Task_Scheduler_Now() - start_counts);
+    EndCritical(sr);
+}
+
+uint32_t Task_Scheduler_Get_Sleep_Permille(void)
+{
+    uint64_t total_counts;
+    uint64_t sleep_counts;
+    long sr;
+
+    sr = StartCritical();
+    total_counts = Task_Scheduler_Now();
+    sleep_counts = Sleep_Counts;
+    EndCritical(sr);
+
+    if (total_counts == 0) return 0;
+
+    return (uint32_t)((sleep_counts * 1000) / total_counts);
+}
+
+void Task_Scheduler_Tick(void)
+{
+    Task_Scheduler_Entry *entry;
+    uint32_t start_cycles;
+    uint32_t cycles;
+    uint16_t elapsed_ticks;
+    uint16_t next_ticks;
+    uint16_t min_ticks;
+    uint16_t counts;
+    long sr;
+    int i;
+
+    // Account for the ticks that were skipped since the previous interrupt
+    elapsed_ticks = Ticks_Per_Interrupt;
+    Tick_Count = Tick_Count + elapsed_ticks;
+    Elapsed_Counts = Elapsed_Counts + TIMER_A1->CCR[0] + 1;
+
+    for (i = 0; i < Num_Tasks; i = i + 1)
+    {
+        entry = &Tasks[i];
+
+        if (entry->countdown > elapsed_ticks)
+        {
+            entry->countdown = entry->countdown - elapsed_ticks;
+            continue;
+        }
+
+        entry->countdown = entry->period_ticks;
+
+        // Execute the task and measure its execution time
+        start_cycles = Cycle_Counter_Read();
+        (*entry->task)();
+        cycles = Cycle_Counter_Elapsed(start_cycles);
+
+        entry->run_count = entry->run_count + 1;
+        entry->last_cycles = cycles;
+        entry->sum_cycles = entry->sum_cycles + cycles;
+        if (cycles > entry->max_cycles)
+        {
+            entry->max_cycles = cycles;
+        }
+
+        // The task took longer than its own period
+        if (cycles > (entry->period_ticks * Cycles_Per_Tick))
+        {
+            entry->overrun_count = entry->overrun_count + 1;
+        }
+    }
+
+    // Find the number of ticks until the next task is due
+    next_ticks = 1;
+#if (TASK_SCHEDULER_TICKLESS)
+    next_ticks = TASK_SCHEDULER_MAX_IDLE_TICKS;
+    for (i = 0; i < Num_Tasks; i = i + 1)
+    {
+        if (Tasks[i].countdown < next_ticks)
+        {
+            next_ticks = Tasks[i].countdown;
+        }
+    }
+#endif
+
+    // The counter is read and the period is changed without interruption, so that the counter cannot pass the new value in between
+    sr = StartCritical();
+
+    // The next tick is already pending, so at least one tick will be processed late.
+    // The counter has already restarted with the current period, so the period is left unchanged.
+    // It is reprogrammed by the pending interrupt, which accounts for the period that has just ended.
+    if (TIMER_A1->CCTL[0] & 0x0001)
+    {
+        Scheduler_Overrun_Count = Scheduler_Overrun_Count + 1;
+        EndCritical(sr);
+        return;
+    }
+
+    // The counter restarted from 0 at the start of this period, so the new value applies to the current period.
+    // If the tasks took longer than next_ticks, the counter is already past that deadline. In up mode, a CCR0 value
+    // below the counter makes the timer roll to zero at once, after at most one additional count (see "Changing
+    // Period Register TAxCCR0" in the Technical Reference Manual). The period would end early and be shorter than
+    // next_ticks, but the interrupt would still account for next_ticks. Instead, the period is extended to the next
+    // tick boundary that is still ahead of the counter (with a margin of 2 counts), and the deadline is late.
+    counts = TIMER_A1->R;
+    min_ticks = ((counts + 3) / TASK_SCHEDULER_CCR0_VALUE) + 1;
+    if (min_ticks > (65536 / TASK_SCHEDULER_CCR0_VALUE))
+    {
+        min_ticks = 65536 / TASK_SCHEDULER_CCR0_VALUE;
+    }
+    if (next_ticks < min_ticks)
+    {
+        next_ticks = min_ticks;
+        Scheduler_Overrun_Count = Scheduler_Overrun_Count + 1;
+    }
+
+    // Program the Timer A1 period so that the next interrupt occurs at the deadline
+    if (next_ticks != Ticks_Per_Interrupt)
+    {
+        Ticks_Per_Interrupt = next_ticks;
+        TIMER_A1->CCR[0] = (next_ticks * TASK_SCHEDULER_CCR0_VALUE) - 1;
+    }
+
+    EndCritical(sr);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file Telemetry.c
+ * @brief Source code for the Telemetry driver.
+ *
+ * This file contains the function definitions for the Telemetry driver.
+ * It packs a snapshot of the robot state into a binary frame and transmits it over EUSCI_A0 with the uDMA controller.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include "../inc/Telemetry.h"
+
+// Frame being transmitted. It is only written while Frame_In_Flight is 0.
+static uint8_t Frame[TELEMETRY_FRAME_SIZE];
+static volatile uint8_t Frame_In_Flight = 0;
+
+static uint16_t Sequence = 0;
+static int8_t Task_ID = -1;
+
+// Cleared by Telemetry_Set_Period(0) to stop sending frames
+static volatile uint8_t Enabled = 1;
+
+static volatile Telemetry_Stats Stats;
+
+// Write little-endian values to a byte array and return the position after them
+static uint8_t *Write_U8(uint8_t *data, uint8_t value)
+{
+    data[0] = value;
+    return data + 1;
+}
+
+static uint8_t *Write_U16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    return data + 2;
+}
+
+static uint8_t *Write_U32(uint8_t *data, uint32_t value)
+{
+    data = Write_U16(data, (uint16_t)value);
+    return Write_U16(data, (uint16_t)(value >> 16));
+}
+
+// Called from DMA_INT0_IRQHandler once the frame has been written to the UART
+static void Telemetry_Done_Task(void)
+{
+    Frame_In_Flight = 0;
+}
+
+// Executed by the task scheduler every Period_Ticks ticks
+static void Telemetry_Task(void)
+{
+    uint8_t *position;
+    uint16_t crc;
+    uint16_t skipped;
+
+    if (Enabled == 0) return;
+
+    // The previous frame is still waiting for the UART, so skip this one instead of modifying it
+    if (Frame_In_Flight)
+    {
+        Stats.skipped_count = Stats.skipped_count + 1;
+        return;
+    }
+
+    skipped = (Stats.skipped_count > 0xFFFF) ? 0xFFFF : (uint16_t)Stats.skipped_count;
+
+    position = Frame;
+    position = Write_U8(position, TELEMETRY_SYNC);
+    position = Write_U8(position, TELEMETRY_PAYLOAD_SIZE);
+    position = Write_U16(position, Sequence);
+    position = Write_U32(position, Task_Scheduler_Get_Ticks());
+
+    // Duty cycles and pins as applied by the hardware. A commit that has not been latched yet at the next
+    // PWM period boundary is not included, unlike the duty cycles returned by Motor_Get_Duty_Cycles.
+    position = Write_U16(position, TIMER_A0->CCR[4]);
+    position = Write_U16(position, TIMER_A0->CCR[3]);
+    position = Write_U8(position, (P5->OUT & 0x30) | (P3->OUT & 0xC0));
+    position = Write_U8(position, Bumper_Read());
+
+    position = Write_U16(position, TIMER_A2->CCR[1]);
+    position = Write_U16(position, TIMER_A2->CCR[2]);
+
+    position = Write_U8(position, (P1->OUT & 0x01) | ((P2->OUT & 0x07) << 1));
+    position = Write_U8(position, P8->OUT & 0xE1);
+
+    position = Write_U16(position, (uint16_t)Task_Scheduler_Get_Sleep_Permille());
+    position = Write_U32(position, Task_Scheduler_Get_Overrun_Count());
+    position = Write_U16(position, skipped);
+
+    // The CRC covers the Length field through the Skipped frames field
+    crc = CRC16_Update(CRC16_INIT, &Frame[1], TELEMETRY_PAYLOAD_SIZE + 1);
+    Write_U16(position, crc);
+
+    Frame_In_Flight = 1;
+    if (EUSCI_A0_UART_Write_DMA(Frame, TELEMETRY_FRAME_SIZE, &Telemetry_Done_Task) == 0)
+    {
+        Frame_In_Flight = 0;
+        Stats.skipped_count = Stats.skipped_count + 1;
+        return;
+    }
+
+    Sequence = Sequence + 1;
+    Stats.frame_count = Stats.frame_count + 1;
+}
+
+uint8_t Telemetry_Init(uint16_t phase_ticks)
+{
+    Frame_In_Flight = 0;
+    Sequence = 0;
+    Stats.frame_count = 0;
+    Stats.skipped_count = 0;
+
+    Enabled = 1;
+
+    Task_ID = Task_Scheduler_Add(&Telemetry_Task, TELEMETRY_DEFAULT_PERIOD, phase_ticks);
+
+    return (Task_ID >= 0);
+}
+
+void Telemetry_Set_Period(uint16_t period_ticks)
+{
+    if (Task_ID < 0) return;
+
+    if (period_ticks == 0)
+    {
+        // Keep the task registered, but stop sending frames
+        Enabled = 0;
+    }
+    else
+    {
+        Task_Scheduler_Set_Period(Task_ID, period_ticks);
+        Enabled = 1;
+    }
+}
+
+void Telemetry_Get_Stats(Telemetry_Stats *stats)
+{
+    stats->frame_count = Stats.frame_count;
+    stats->skipped_count = Stats.skipped_count;
+}
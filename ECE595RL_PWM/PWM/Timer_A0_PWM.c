@@ -14,6 +14,14 @@
 
 #include "../inc/Timer_A0_PWM.h"
 
+// Pending duty cycle values that are latched by TA0_0_IRQHandler at the next period boundary
+static volatile uint16_t Pending_Duty_Cycle_1 = 0;
+static volatile uint16_t Pending_Duty_Cycle_2 = 0;
+static volatile uint8_t Commit_Pending = 0;
+
+// Pointer to the user-defined task executed by TA0_0_IRQHandler when a commit is latched
+static void (*Timer_A0_Commit_Task)(void) = 0;
+
 void Timer_A0_PWM_Init(uint16_t period, uint16_t duty_cycle_1, uint16_t duty_cycle_2)
 {
     // Return immediately if either duty cycle values are greater than
@@ -51,6 +59,16 @@ void Timer_A0_PWM_Init(uint16_t period, uint16_t duty_cycle_1, uint16_t duty_cyc
     // Duty Cycle %: duty_cycle_1 / period
     TIMER_A0->CCR[4] = duty_cycle_2;
 
+    // Disable the CCR0 interrupt until a commit is requested
+    Commit_Pending = 0;
+    TIMER_A0->CCTL[0] &= ~0x0011;
+
+    // Set interrupt priority level to 1, above Timer A1 so that a commit is not delayed by the scheduled tasks
+    NVIC->IP[2] = (NVIC->IP[2] & 0xFFFFFF00) | 0x00000020;
+
+    // Enable Interrupt 8 in NVIC
+    NVIC->ISER[0] = 0x00000100;
+
     // Select SMCLK = 12 MHz as timer clock source
     // Set ID = 3 (Divide timer clock by 8)
     // Set MC = 3 (Up/Down Mode)
@@ -74,3 +92,71 @@ void Timer_A0_Update_Duty_Cycle_2(uint16_t duty_cycle_2)
     // Otherwise, update the duty cycle
     TIMER_A0->CCR[4] = duty_cycle_2;
 }
+
+void Timer_A0_PWM_Set_Commit_Task(void(*task)(void))
+{
+    Timer_A0_Commit_Task = task;
+}
+
+uint8_t Timer_A0_PWM_Commit(uint16_t duty_cycle_1, uint16_t duty_cycle_2)
+{
+    long sr;
+
+    // Immediately return if either duty cycle is greater than the given period
+    if (duty_cycle_1 >= TIMER_A0->CCR[0]) return 0;
+    if (duty_cycle_2 >= TIMER_A0->CCR[0]) return 0;
+
+    sr = StartCritical();
+
+    // A commit that has not been latched yet is replaced by the new one
+    Pending_Duty_Cycle_1 = duty_cycle_1;
+    Pending_Duty_Cycle_2 = duty_cycle_2;
+    Commit_Pending = 1;
+
+    // Clear the stale CCR0 interrupt flag from earlier periods, then enable the CCR0 interrupt
+    TIMER_A0->CCTL[0] &= ~0x0001;
+    TIMER_A0->CCTL[0] |= 0x0010;
+
+    EndCritical(sr);
+
+    return 1;
+}
+
+void Timer_A0_PWM_Cancel_Commit(void)
+{
+    long sr;
+
+    sr = StartCritical();
+    Commit_Pending = 0;
+    TIMER_A0->CCTL[0] &= ~0x0010;
+    EndCritical(sr);
+}
+
+uint8_t Timer_A0_PWM_Commit_Pending(void)
+{
+    return Commit_Pending;
+}
+
+void TA0_0_IRQHandler(void)
+{
+    // Acknowledge Capture/Compare interrupt and clear it
+    TIMER_A0->CCTL[0] &= ~0x0001;
+
+    // The counter is at the top of the up/down period, where both PWM outputs are low,
+    // so the new values take effect together at the start of the next pulse
+    if (Commit_Pending)
+    {
+        // Execute the user-defined task first (for example, to update the motor direction pins)
+        if (Timer_A0_Commit_Task != 0)
+        {
+            (*Timer_A0_Commit_Task)();
+        }
+
+        TIMER_A0->CCR[3] = Pending_Duty_Cycle_1;
+        TIMER_A0->CCR[4] = Pending_Duty_Cycle_2;
+        Commit_Pending = 0;
+    }
+
+    // The commit is a one-shot event, so disable the CCR0 interrupt
+    TIMER_A0->CCTL[0] &= ~0x0010;
+}
@@ -11,6 +11,10 @@
  */
 
 #include "../inc/Timer_A1_Interrupt.h"
+#include "../inc/Cycle_Counter.h"
+
+// Pointer to the user-defined task executed by TA1_0_IRQHandler
+void (*Timer_A1_Task)(void);
 
 void Timer_A1_Interrupt_Init(void(*task)(void), uint16_t period)
 {
@@ -57,9 +61,13 @@ void TimerA1_Stop(void)
 
 void TA1_0_IRQHandler(void)
 {
+    ISR_PROFILE_BEGIN();
+
     // Acknowledge Capture/Compare interrupt and clear it
     TIMER_A1->CCTL[0] &= ~0x0001;
 
     // Execute the user-defined task
     (*Timer_A1_Task)();
+
+    ISR_PROFILE_END(ISR_PROFILE_TA1_0);
 }
@@ -10,6 +10,10 @@
  */
 
 #include "../inc/Timer_A2_PWM.h"
+#include "../inc/Cycle_Counter.h"
+
+// Pointer to the user-defined task executed by TA2_0_IRQHandler once per PWM period
+static void (*Timer_A2_Period_Task)(void) = 0;
 
 void Timer_A2_PWM_Init(uint16_t period, uint16_t duty_cycle_1, uint16_t duty_cycle_2)
 {
@@ -71,3 +75,44 @@ void Timer_A2_Update_Duty_Cycle_2(uint16_t duty_cycle_2)
     // Otherwise, update the duty cycle
     TIMER_A2->CCR[2] = duty_cycle_2;
 }
+
+void Timer_A2_PWM_Set_Period_Task(void(*task)(void))
+{
+    // Disable the CCR0 interrupt while the task is being changed
+    TIMER_A2->CCTL[0] &= ~0x0010;
+
+    Timer_A2_Period_Task = task;
+
+    if (task == 0)
+    {
+        // Disable Interrupt 12 in NVIC
+        NVIC->ICER[0] = 0x00001000;
+        return;
+    }
+
+    // Set interrupt priority level to 2
+    NVIC->IP[3] = (NVIC->IP[3] & 0xFFFFFF00) | 0x00000040;
+
+    // Enable Interrupt 12 in NVIC
+    NVIC->ISER[0] = 0x00001000;
+
+    // Clear the stale CCR0 interrupt flag, then enable the CCR0 interrupt
+    TIMER_A2->CCTL[0] &= ~0x0001;
+    TIMER_A2->CCTL[0] |= 0x0010;
+}
+
+void TA2_0_IRQHandler(void)
+{
+    ISR_PROFILE_BEGIN();
+
+    // Acknowledge Capture/Compare interrupt and clear it
+    TIMER_A2->CCTL[0] &= ~0x0001;
+
+    // Execute the user-defined task
+    if (Timer_A2_Period_Task != 0)
+    {
+        (*Timer_A2_Period_Task)();
+    }
+
+    ISR_PROFILE_END(ISR_PROFILE_TA2_0);
+}
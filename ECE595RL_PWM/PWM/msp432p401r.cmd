@@ -84,6 +84,9 @@ SECTIONS
     .init_array   :     > MAIN
     .binit        : {}  > MAIN
 
+    /* Format strings of the Binary_Log driver, read by tools/binary_log_decode.py */
+    .log_fmt      :     > MAIN
+
     /* The following sections show the usage of the INFO flash memory        */
     /* INFO flash memory is intended to be used for the following            */
     /* device specific purposes:                                             */
@@ -0,0 +1,208 @@
+/**
+ * @file Benchmark.h
+ * @brief Header file for the Benchmark module.
+ *
+ * This file contains the function definitions for the Benchmark module.
+ * It reports cycle counts measured with the Cycle_Counter driver over UART (EUSCI_A0) using printf.
+ * The reports are printed as fixed-width tables so that the output of two builds can be compared
+ * line by line with a text diff tool.
+ *
+ * @note EUSCI_A0_UART_Init_Printf and Cycle_Counter_Init must be called before using this module.
+ * @note tools/host/bench_isr prints the ISR and task tables on a Linux host, with the cycle counts
+ *       of the simulator model (see tools/host/Simulator.h).
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "msp.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/Task_Scheduler.h"
+#include "../inc/Servo_Angle.h"
+#include "../inc/Servo_Mux.h"
+#include "../inc/Clock.h"
+#include "../inc/Nokia5110_LCD.h"
+#include "../inc/Nokia5110_Graphics.h"
+#include "../inc/Format.h"
+#include "../inc/Bumper_Sensors.h"
+
+// Set to 1 to build the benchmark configuration of the main program.
+// In this configuration, the benchmark reports are printed periodically from the main loop.
+#define BENCHMARK_ENABLED 0
+
+// Number of frames drawn by Benchmark_Print_LCD_Flush_Table for each method
+#define BENCHMARK_LCD_NUM_FRAMES 32
+
+// Angle step used by Benchmark_Print_Servo_Angle_Table, in millidegrees
+#define BENCHMARK_SERVO_ANGLE_STEP 10
+
+// Number of simulated presses measured by Benchmark_Print_Emergency_Stop_Table
+#define BENCHMARK_EMERGENCY_STOP_NUM_SAMPLES 16
+
+// Maximum time that Benchmark_Print_Emergency_Stop_Table waits for the end of the lockout of BUMP_0, in ms
+#define BENCHMARK_EMERGENCY_STOP_TIMEOUT_MS 100
+
+/**
+ * @brief Print the execution time statistics of the profiled interrupt service routines.
+ *
+ * This function prints one row for each interrupt service routine listed in ISR_Profile_ID.
+ * Each row contains the number of samples and the minimum, mean, 99th percentile, and worst-case
+ * execution time in clock cycles. The execution time is measured from the first instruction of the
+ * interrupt service routine to the return of the user-defined task (for example, Timer_A1_Task,
+ * Bumper_Task, or PMOD_BTN_Task), so it includes the function pointer call. The 12-cycle exception entry of the
+ * Cortex-M4 is not included.
+ *
+ * @note ISR_PROFILING_ENABLED must be set to 1 in Cycle_Counter.h. Otherwise, every row reports zero samples.
+ *
+ * @return None
+ */
+void Benchmark_Print_ISR_Table(void);
+
+/**
+ * @brief Print the execution time statistics of the tasks registered with the task scheduler.
+ *
+ * This function prints one row for each registered task, in the order in which the tasks were registered.
+ * Each row contains the number of executions, the number of overruns, and the last, mean, and worst-case
+ * execution time in clock cycles. The last two rows report the number of scheduler overruns and
+ * the fraction of time spent sleeping in Task_Scheduler_Idle, in parts per thousand.
+ *
+ * @return None
+ */
+void Benchmark_Print_Task_Table(void);
+
+/**
+ * @brief Print the accuracy and cost of the angle to pulse width conversion of each servo.
+ *
+ * This function converts every angle from 0 to SERVO_ANGLE_MAX_MILLIDEGREES in steps of
+ * BENCHMARK_SERVO_ANGLE_STEP millidegrees with Servo_Angle_To_Counts, and it compares the resulting
+ * pulse width with the ideal pulse width of the calibrated servo, computed exactly with 64-bit integers.
+ * Each row contains the maximum and mean absolute error in nanoseconds, and the mean number of clock cycles
+ * taken by a single conversion.
+ *
+ * @return None
+ */
+void Benchmark_Print_Servo_Angle_Table(void);
+
+/**
+ * @brief Print the timing statistics of the channels of the Servo_Mux driver.
+ *
+ * This function prints one row for each channel. Each row contains the number of pulses, the minimum and maximum
+ * latency of the pulse edges, and the maximum pulse width error (jitter), in nanoseconds. The statistics are
+ * cleared after they are printed, so each report covers the interval since the previous report.
+ *
+ * @note The Servo_Mux_Init function must be called before using this function.
+ *
+ * @return None
+ */
+void Benchmark_Print_Servo_Mux_Table(void);
+
+/**
+ * @brief Print the cost of drawing the screen buffer of the Nokia 5110 LCD with and without the uDMA controller.
+ *
+ * This function draws BENCHMARK_LCD_NUM_FRAMES frames with Nokia5110_DisplayBuffer, then with Nokia5110_DisplayBuffer_DMA.
+ * Each row contains the number of frames, the number of clock cycles per frame during which the CPU is busy,
+ * the total number of clock cycles per frame until the last byte has been shifted out, and the resulting
+ * frame rate. For the uDMA method, the CPU cycles include the setup time and the mean execution time
+ * of DMA_INT0_IRQHandler.
+ *
+ * @note Nokia5110_Init and DMA_Init must be called, and interrupts must be enabled, before using this function.
+ *       The LCD does not need to be connected.
+ *
+ * @return None
+ */
+void Benchmark_Print_LCD_Flush_Table(void);
+
+/**
+ * @brief Print the cost of updating a small region of the Nokia 5110 LCD with and without dirty-region tracking.
+ *
+ * This function models a dashboard that changes three characters per frame: for each of BENCHMARK_LCD_NUM_FRAMES
+ * frames, it redraws an 18x8 pixel region of the screen buffer with Nokia5110_SetPxl and Nokia5110_ClrPxl, then it
+ * draws the buffer with Nokia5110_DisplayBuffer or Nokia5110_DisplayBuffer_Dirty. Each row contains the number of
+ * frames, the number of bytes sent to the LCD per frame, and the number of clock cycles per frame.
+ *
+ * @note Nokia5110_Init must be called before using this function. The LCD does not need to be connected.
+ *
+ * @return None
+ */
+void Benchmark_Print_LCD_Dirty_Table(void);
+
+/**
+ * @brief Print the throughput of the EUSCI_A3 SPI module at each supported bit rate.
+ *
+ * For each bit rate from 1 MHz to NOKIA5110_SPI_BIT_RATE in steps of 1 MHz, this function changes the bit rate with
+ * EUSCI_A3_SPI_Set_Bit_Rate and draws BENCHMARK_LCD_NUM_FRAMES frames with Nokia5110_DisplayBuffer. Each row contains
+ * the requested and actual bit rate, the measured throughput in bytes per second, and the full-frame latency
+ * in microseconds. The bit rate is set back to NOKIA5110_SPI_BIT_RATE at the end.
+ *
+ * @note Nokia5110_Init must be called before using this function. The LCD does not need to be connected.
+ *
+ * @return None
+ */
+void Benchmark_Print_SPI_Rate_Table(void);
+
+/**
+ * @brief Print the cost of the Nokia5110_Graphics primitives compared to drawing the same shapes one pixel at a time.
+ *
+ * Each row contains the number of clock cycles taken to draw a shape into the screen buffer with a loop of
+ * Nokia5110_SetPxl and Nokia5110_ClrPxl calls, the number of clock cycles taken by the corresponding
+ * Nokia5110_Graphics function, and the speedup in tenths. The LCD itself is not accessed.
+ *
+ * @note Cycle_Counter_Init must be called before using this function.
+ *
+ * @return None
+ */
+void Benchmark_Print_Graphics_Table(void);
+
+/**
+ * @brief Print the cost of printing a 12-character string on the Nokia 5110 LCD with each text function.
+ *
+ * The string is printed BENCHMARK_LCD_NUM_FRAMES times with a loop of Nokia5110_OutChar calls, with Nokia5110_OutString,
+ * with Nokia5110_OutString_DMA, and into the screen buffer with Nokia5110_Draw_String. Each row contains the number of
+ * strings, the number of clock cycles that the CPU spent per string, the total number of clock cycles per string
+ * (including the time to shift the last byte out), and the number of strings per second.
+ *
+ * @note Nokia5110_Init and DMA_Init must be called before using this function. The LCD does not need to be connected.
+ *
+ * @return None
+ */
+void Benchmark_Print_LCD_Text_Table(void);
+
+/**
+ * @brief Print the cost of converting integers into decimal strings with each method.
+ *
+ * For each test value, this function measures the number of clock cycles taken to convert the value with a recursive
+ * division by 10 (the method previously used by EUSCI_A0_UART_OutUDec), with Format_UDec, and with sprintf.
+ * It also measures the fixed-width and fixed-point variants used by the Nokia5110_LCD driver (Format_SDec_Width and Format_SFix).
+ * No characters are transmitted.
+ *
+ * @note Cycle_Counter_Init must be called before using this function.
+ *
+ * @return None
+ */
+void Benchmark_Print_Format_Table(void);
+
+/**
+ * @brief Print the latency of the emergency stop performed by PORT4_IRQHandler when a bumper switch is pressed.
+ *
+ * A press of BUMP_0 is simulated BENCHMARK_EMERGENCY_STOP_NUM_SAMPLES times by setting its interrupt flag (P4.0) in software.
+ * The latency is the number of clock cycles from the write of the flag to the end of Motor_Stop in PORT4_IRQHandler,
+ * at which point the enable pins (P3.6 and P3.7) are low and the duty cycles (CCR3 and CCR4) are 0. It includes the
+ * exception entry. The row reports the number of samples, the number of skipped samples, and the minimum, mean, and maximum
+ * latency in clock cycles. A sample is skipped if the interrupt of BUMP_0 is not enabled again within
+ * BENCHMARK_EMERGENCY_STOP_TIMEOUT_MS, if BUMP_0 is pressed, or if PORT4_IRQHandler does not stop the motors.
+ * The user-defined Bumper_Task is not called during the benchmark.
+ *
+ * @note BUMPER_SENSORS_EMERGENCY_STOP_ENABLED must be set to 1. Bumper_Sensors_Init and Motor_Init must be called,
+ *       interrupts must be enabled, and Bumper_Sensors_Process must run from a scheduled task, since it ends the lockout
+ *       of BUMP_0 after each sample. Each sample is reported as a press and a release event of BUMP_0.
+ *
+ * @return None
+ */
+void Benchmark_Print_Emergency_Stop_Table(void);
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,128 @@
+/**
+ * @file Binary_Log.h
+ * @brief Header file for the Binary_Log driver.
+ *
+ * This file contains the function definitions for the Binary_Log driver.
+ * It provides a deferred logging mechanism that can be used from any interrupt service routine.
+ * Instead of formatting a message with printf, a log call stores a compact record in a RAM ring buffer:
+ *  - The address of the format string (format ID)
+ *  - A timestamp from the DWT cycle counter
+ *  - Up to 4 arguments of 32 bits each
+ *
+ * The cost of a log call does not depend on the length of the message. The records are later
+ * transmitted over UART (EUSCI_A0) by Binary_Log_Drain, which runs outside of interrupt context.
+ *
+ * The format strings are placed in the ".log_fmt" section of the executable. The host-side decoder
+ * (tools/binary_log_decode.py) reads that section from the .out file and turns each record back into text.
+ *
+ * Each record is transmitted as the following frame (multi-byte fields are little-endian):
+ *  - Sync byte (0xA5)
+ *  - Number of arguments (0 to 4)
+ *  - Format ID (4 bytes)
+ *  - Timestamp in clock cycles (4 bytes)
+ *  - Arguments (4 bytes each)
+ *  - CRC-16/CCITT-FALSE (see CRC16.h) of the Number of arguments field through the last argument (2 bytes)
+ *
+ * The CRC lets the decoder reject a sync byte found in the middle of console text or of another frame,
+ * and resynchronize on the next one.
+ *
+ * @note EUSCI_A0_UART_Init and Cycle_Counter_Init must be called before using this driver.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef BINARY_LOG_H_
+#define BINARY_LOG_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/CRC16.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/EUSCI_A0_UART.h"
+
+// The number of records that can be stored in the ring buffer. It must be a power of two.
+#define BINARY_LOG_BUFFER_SIZE 64
+
+// The maximum number of arguments that can be stored in a record
+#define BINARY_LOG_MAX_ARGS 4
+
+// The sync byte that starts each transmitted record
+#define BINARY_LOG_SYNC_BYTE 0xA5
+
+// The size of a transmitted record, in bytes: sync byte, number of arguments, format ID, timestamp, arguments, and CRC
+#define BINARY_LOG_FRAME_SIZE(num_args) (12 + (4 * (num_args)))
+
+/**
+ * @brief Define a format string in the ".log_fmt" section.
+ *
+ * The format string is only used by the host-side decoder. It uses printf syntax,
+ * and each conversion consumes one 32-bit argument.
+ */
+#define BINARY_LOG_FORMAT(name, fmt) \
+    static const char name[] __attribute__((section(".log_fmt"))) = fmt
+
+/**
+ * @brief Log a message with 0 to 4 arguments.
+ */
+#define BINARY_LOG0(fmt) \
+    do { BINARY_LOG_FORMAT(binary_log_fmt, fmt); \
+         Binary_Log_Write(binary_log_fmt, 0, 0, 0, 0, 0); } while (0)
+
+#define BINARY_LOG1(fmt, a0) \
+    do { BINARY_LOG_FORMAT(binary_log_fmt, fmt); \
+         Binary_Log_Write(binary_log_fmt, 1, (uint32_t)(a0), 0, 0, 0); } while (0)
+
+#define BINARY_LOG2(fmt, a0, a1) \
+    do { BINARY_LOG_FORMAT(binary_log_fmt, fmt); \
+         Binary_Log_Write(binary_log_fmt, 2, (uint32_t)(a0), (uint32_t)(a1), 0, 0); } while (0)
+
+#define BINARY_LOG3(fmt, a0, a1, a2) \
+    do { BINARY_LOG_FORMAT(binary_log_fmt, fmt); \
+         Binary_Log_Write(binary_log_fmt, 3, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), 0); } while (0)
+
+#define BINARY_LOG4(fmt, a0, a1, a2, a3) \
+    do { BINARY_LOG_FORMAT(binary_log_fmt, fmt); \
+         Binary_Log_Write(binary_log_fmt, 4, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3)); } while (0)
+
+/**
+ * @brief Store a log record in the ring buffer.
+ *
+ * This function copies the format ID, the current cycle count, and the arguments into the next free
+ * record in constant time. If the ring buffer is full, the record is discarded and the dropped record
+ * counter is incremented. It is safe to call this function from any interrupt service routine.
+ *
+ * @note Use the BINARY_LOG0 to BINARY_LOG4 macros instead of calling this function directly.
+ *
+ * @param fmt Pointer to the format string, which must be located in the ".log_fmt" section.
+ * @param num_args The number of valid arguments (0 to 4).
+ * @param a0 The first argument.
+ * @param a1 The second argument.
+ * @param a2 The third argument.
+ * @param a3 The fourth argument.
+ *
+ * @return None
+ */
+void Binary_Log_Write(const char *fmt, uint8_t num_args, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/**
+ * @brief Transmit the stored log records over UART (EUSCI_A0).
+ *
+ * This function moves records from the log ring buffer to the UART transmit ring buffer as long as
+ * there is enough room for a whole record. Each record is added in a single critical section, so it
+ * is never mixed with the bytes written by an interrupt. It never waits for the UART, so it can be called
+ * periodically from the main loop or from a low-priority periodic task.
+ *
+ * @return The number of records transmitted.
+ */
+uint32_t Binary_Log_Drain(void);
+
+/**
+ * @brief Return the number of records discarded because the log ring buffer was full.
+ *
+ * @return The number of dropped records.
+ */
+uint32_t Binary_Log_Get_Dropped_Count(void);
+
+#endif /* BINARY_LOG_H_ */
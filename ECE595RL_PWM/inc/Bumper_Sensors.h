@@ -23,6 +23,18 @@
  * @note The Bumper Switches are configured with negative logic as the default setting.
  * When the switches are active, they connect to GND.
  *
+ * Switch bounce is handled with a per-switch lockout. PORT4_IRQHandler disables the interrupt of each switch
+ * that fired and stores the interrupt flags, the edge direction, and a cycle counter timestamp in a lock-free
+ * single-producer, single-consumer queue. Bumper_Sensors_Process, called from a periodic task, turns the
+ * queued edges into press and release events. It enables the interrupt of a switch again once
+ * BUMPER_SENSORS_LOCKOUT_MS has elapsed since its edge, with the edge select (IES) bit set to detect the
+ * opposite transition of the current level. The events are read with Bumper_Sensors_Get_Event.
+ *
+ * When BUMPER_SENSORS_EMERGENCY_STOP_ENABLED is set to 1, PORT4_IRQHandler stops the motors with Motor_Stop as soon as
+ * a press is detected, before the user-defined task runs. The enable pins of the DRV8838 motor drivers (P3.6 and P3.7)
+ * are driven low and the duty cycles (Timer A0 CCR3 and CCR4) are set to 0 within the interrupt, so the motors do not
+ * keep running until a task or the main loop reacts to the collision.
+ *
  * @author Aaron Nanas
  *
  */
@@ -32,13 +44,67 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/Motor.h"
+
+// Set to 1 to stop the motors in PORT4_IRQHandler when a bumper switch is pressed
+#define BUMPER_SENSORS_EMERGENCY_STOP_ENABLED   1
+
+// Number of bumper switches
+#define BUMPER_SENSORS_NUM_SWITCHES     6
+
+// Time during which the edges of a switch are ignored after an edge
+#define BUMPER_SENSORS_LOCKOUT_MS       10
+
+// Number of entries of the edge queue filled by PORT4_IRQHandler. It must be a power of two.
+#define BUMPER_SENSORS_EDGE_QUEUE_SIZE  16
+
+// Number of entries of the event queue filled by Bumper_Sensors_Process. It must be a power of two.
+#define BUMPER_SENSORS_EVENT_QUEUE_SIZE 16
+
+/**
+ * @brief A debounced press or release of a bumper switch.
+ *
+ * - bumper: The index of the switch, from 0 (BUMP_0) to 5 (BUMP_5).
+ * - pressed: 1 for a press, 0 for a release.
+ * - timestamp_cycles: Value of Cycle_Counter_Read when the edge was detected.
+ * - duration_cycles: Number of cycles since the previous event of the same switch. For a release,
+ *   this is how long the switch was pressed. It is 0 for the first event of a switch.
+ */
+typedef struct
+{
+    uint8_t bumper;
+    uint8_t pressed;
+    uint32_t timestamp_cycles;
+    uint32_t duration_cycles;
+} Bumper_Event;
+
+/**
+ * @brief Statistics of the Bumper_Sensors driver.
+ *
+ * - edge_count: Number of edges stored by PORT4_IRQHandler.
+ * - edge_dropped_count: Number of edges lost because the edge queue was full.
+ * - event_dropped_count: Number of events lost because the event queue was full.
+ * - emergency_stop_count: Number of times PORT4_IRQHandler stopped the motors.
+ * - emergency_stop_cycles: Cycle counter value right after the last emergency stop.
+ */
+typedef struct
+{
+    uint32_t edge_count;
+    uint32_t edge_dropped_count;
+    uint32_t event_dropped_count;
+    uint32_t emergency_stop_count;
+    uint32_t emergency_stop_cycles;
+} Bumper_Sensors_Stats;
 
 /**
  * @brief User-defined task function for handling Bumper Sensor interrupt events.
  *
  * This is a user-defined function that can be assigned to the Bumper_Task pointer during initialization.
- * When a falling edge event is detected on any of the Bump Sensor pins (P4.7, P4.6, P4.5, P4.3, P4.2, or P4.0),
- * this function will be called, and the bumper_sensor_state parameter will indicate which specific bumper switch triggered the interrupt.
+ * When a falling edge event (press) is detected on any of the Bump Sensor pins (P4.7, P4.6, P4.5, P4.3, P4.2, or P4.0),
+ * this function will be called from PORT4_IRQHandler, and the bumper_sensor_state parameter will indicate which specific bumper switch triggered the interrupt.
  *
  * @param bumper_sensor_state An 8-bit unsigned integer representing the Bump Sensor that triggered the interrupt.
  *                   The bit positions correspond to the following sensors:
@@ -53,14 +119,17 @@
  *
  * @return None
  */
-void (*Bumper_Task)(uint8_t bumper_sensor_state);
+extern void (*Bumper_Task)(uint8_t bumper_sensor_state);
 
 /**
  * @brief Initialize the Bumper Sensors and set up interrupt handling.
  *
  * This function initializes the bumper sensors and sets up the necessary configurations for interrupt handling.
- * The specified task function will be called when a falling edge event is detected on any of the following pins
- * used by the bumper sensors.
+ * The specified task function will be called from PORT4_IRQHandler when a falling edge event (a press) is detected on
+ * any of the following pins used by the bumper sensors. It is called at most once per press, since the interrupt of the
+ * switch stays disabled during the lockout.
+ *
+ * @note Clock_Init48MHz and Cycle_Counter_Init must be called first, and Bumper_Sensors_Process must be called periodically.
  *
  * The specified task function should take a single uint8_t parameter.
  *
@@ -85,4 +154,43 @@ void Bumper_Sensors_Init(void(*task)(uint8_t));
  */
 uint8_t Bumper_Read(void);
 
+/**
+ * @brief Convert the queued edges into events and end the lockout of the switches.
+ *
+ * This function should be called from a periodic task, every few milliseconds. The timestamps of the events are
+ * taken by PORT4_IRQHandler, so they do not depend on the period of the task. The period only adds to the time
+ * after which an event can be read and to the lockout.
+ *
+ * If a switch changed state during its lockout (for example, a tap shorter than BUMPER_SENSORS_LOCKOUT_MS),
+ * the edge that was missed is detected when the lockout ends and reported with the time at which it was detected.
+ *
+ * @return None
+ */
+void Bumper_Sensors_Process(void);
+
+/**
+ * @brief Remove the oldest event from the event queue.
+ *
+ * @param event Pointer to the structure that will hold the event.
+ *
+ * @return 1 if an event was removed, or 0 if the event queue was empty.
+ */
+uint8_t Bumper_Sensors_Get_Event(Bumper_Event *event);
+
+/**
+ * @brief Return the debounced state of the bumper switches.
+ *
+ * @return A 6-bit value in the format of Bumper_Read, updated by Bumper_Sensors_Process.
+ */
+uint8_t Bumper_Sensors_Get_State(void);
+
+/**
+ * @brief Return the statistics of the Bumper_Sensors driver.
+ *
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void Bumper_Sensors_Get_Stats(Bumper_Sensors_Stats *stats);
+
 #endif /* BUMPER_SENSORS_H_ */
@@ -0,0 +1,40 @@
+/**
+ * @file CRC16.h
+ * @brief Header file for the CRC16 driver.
+ *
+ * This file contains the function definitions for the CRC16 driver.
+ * It computes the CRC-16/CCITT-FALSE checksum (polynomial 0x1021, initial value 0xFFFF, no reflection, no final XOR)
+ * that protects the frames of the Command_Protocol driver.
+ *
+ * The checksum is computed four bits at a time with a 16-entry table, which is a compromise between the
+ * 8-iteration bitwise loop and a 512-byte table.
+ *
+ * The check value of the ASCII string "123456789" is 0x29B1.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+// Initial value of the checksum
+#define CRC16_INIT      0xFFFF
+
+/**
+ * @brief Update a checksum with a block of bytes.
+ *
+ * To compute the checksum of a message in several parts, call this function for each part and pass the result
+ * of the previous call as crc. The first call uses CRC16_INIT.
+ *
+ * @param crc The checksum of the previous bytes, or CRC16_INIT.
+ * @param data Pointer to the bytes.
+ * @param length The number of bytes.
+ *
+ * @return The updated checksum.
+ */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint16_t length);
+
+#endif /* CRC16_H_ */
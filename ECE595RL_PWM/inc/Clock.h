@@ -70,6 +70,17 @@ void Clock_Init48MHz(void);
 uint32_t Clock_GetFreq(void);
 
 
+/**
+ * Return the current subsystem clock (SMCLK) frequency
+ * @param none
+ * @return frequency of SMCLK in Hz
+ * @note  In this module, the return result will be 3000000 or 12000000
+ * @see Clock_Init48MHz()
+ * @brief Returns current SMCLK frequency in Hz
+ */
+uint32_t Clock_GetSMCLKFreq(void);
+
+
 /**
  * Simple delay function which delays about n milliseconds.
  * It is implemented with a nested for-loop and is very approximate.
@@ -0,0 +1,190 @@
+/**
+ * @file Command_Protocol.h
+ * @brief Header file for the Command_Protocol driver.
+ *
+ * This file contains the function definitions for the Command_Protocol driver.
+ * It receives binary command frames from a host over EUSCI_A0 to control the motors, the servos, and the rates of
+ * the scheduled tasks, and it sends a reply frame for each command.
+ *
+ * Frame format (all multi-byte fields are little-endian):
+ *
+ *      Offset      Size        Field           Description
+ *      ------      ----        -----           -----------
+ *      0           1           Sync            COMMAND_PROTOCOL_SYNC for commands, COMMAND_PROTOCOL_REPLY_SYNC for replies
+ *      1           1           Length          Number of payload bytes (0 to COMMAND_PROTOCOL_MAX_PAYLOAD)
+ *      2           1           Opcode          Command_Protocol_Opcode. Replies use (opcode | 0x80).
+ *      3           Length      Payload         Depends on the opcode. The first byte of a reply is a Command_Protocol_Status.
+ *      3 + Length  2           CRC             CRC-16/CCITT-FALSE (see CRC16.h) of the Length, Opcode, and Payload fields
+ *
+ * COMMAND_PROTOCOL_SET_SETPOINTS carries a list of 5-byte entries, so several setpoints can be changed in one frame:
+ *
+ *      Offset      Size        Field           Description
+ *      ------      ----        -----           -----------
+ *      0           1           Target          Command_Protocol_Target, plus the servo number or the task ID
+ *      1           4           Value           Signed value, in the unit of the target
+ *
+ * The entries are checked before any of them is applied, so a frame with an invalid entry has no effect. The motor entries
+ * of a frame are applied together with a single call to Motor_Forward, Motor_Backward, Motor_Left, or Motor_Right,
+ * depending on the signs of the duty cycles, so the left and right motors change in the same PWM period.
+ * Servo entries are applied with Servo_Angle_Move or Servo_Trajectory_Move, which update the Timer A2 duty cycles
+ * (Timer_A2_Update_Duty_Cycle_1 and Timer_A2_Update_Duty_Cycle_2) once per frame within the velocity and acceleration limits.
+ *
+ * Command frames start with a byte that is not ASCII, so the same port can also be used for the text console:
+ * Command_Protocol_Process passes the bytes received outside of a frame to EUSCI_A0_UART_Process_Char.
+ * The reply sync byte differs from the sync byte of the Binary_Log records, which share the transmit ring buffer.
+ *
+ * A frame that is not completed within COMMAND_PROTOCOL_TIMEOUT_MS of its sync byte is discarded.
+ *
+ * tools/robot_command.py builds the frames and decodes the replies on the host.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef COMMAND_PROTOCOL_H_
+#define COMMAND_PROTOCOL_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/CRC16.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Motor.h"
+#include "../inc/Motion_Sequencer.h"
+#include "../inc/Servo_Angle.h"
+#include "../inc/Servo_Trajectory.h"
+#include "../inc/Task_Scheduler.h"
+
+// First byte of a command frame
+#define COMMAND_PROTOCOL_SYNC               0xA5
+
+// First byte of a reply frame
+#define COMMAND_PROTOCOL_REPLY_SYNC         0xA6
+
+// Version reported by COMMAND_PROTOCOL_PING
+#define COMMAND_PROTOCOL_VERSION            1
+
+// Maximum number of payload bytes (12 setpoint entries)
+#define COMMAND_PROTOCOL_MAX_PAYLOAD        60
+
+// Size of one entry of COMMAND_PROTOCOL_SET_SETPOINTS
+#define COMMAND_PROTOCOL_SETPOINT_SIZE      5
+
+// Maximum time between the sync byte and the last byte of a frame
+#define COMMAND_PROTOCOL_TIMEOUT_MS         20
+
+// Maximum magnitude of a motor duty cycle, in Timer A0 counts.
+// Timer_A0_PWM_Commit rejects a duty cycle equal to the PWM period, so the limit is one count below it.
+#define COMMAND_PROTOCOL_MAX_MOTOR_DUTY     (MOTOR_PWM_PERIOD - 1)
+
+/**
+ * @brief Commands sent by the host.
+ *
+ * - COMMAND_PROTOCOL_PING: No payload. The reply payload is the status and COMMAND_PROTOCOL_VERSION.
+ * - COMMAND_PROTOCOL_STOP: No payload. Aborts the motion sequence and calls Motor_Stop.
+ * - COMMAND_PROTOCOL_SET_SETPOINTS: A list of setpoint entries. The reply payload is the status.
+ *   COMMAND_PROTOCOL_COMMIT_FAILED is returned if the motor command was rejected by the Motor driver.
+ *   The other entries of the frame have been applied in that case.
+ * - COMMAND_PROTOCOL_GET_STATE: No payload. The reply payload is the status followed by a Command_Protocol_State.
+ */
+typedef enum
+{
+    COMMAND_PROTOCOL_PING           = 0x01,
+    COMMAND_PROTOCOL_STOP           = 0x02,
+    COMMAND_PROTOCOL_SET_SETPOINTS  = 0x10,
+    COMMAND_PROTOCOL_GET_STATE      = 0x20
+} Command_Protocol_Opcode;
+
+/**
+ * @brief Targets of the setpoint entries.
+ *
+ * - COMMAND_PROTOCOL_MOTOR_LEFT, COMMAND_PROTOCOL_MOTOR_RIGHT: Duty cycle in Timer A0 counts, from
+ *   -COMMAND_PROTOCOL_MAX_MOTOR_DUTY (backward) to COMMAND_PROTOCOL_MAX_MOTOR_DUTY (forward).
+ * - COMMAND_PROTOCOL_SERVO_ANGLE + servo: Target angle in millidegrees, from 0 to SERVO_ANGLE_MAX_MILLIDEGREES.
+ * - COMMAND_PROTOCOL_SERVO_COUNTS + servo: Target pulse width in Timer A2 counts, within the calibrated range of the servo.
+ * - COMMAND_PROTOCOL_TASK_PERIOD + task ID: Period of a scheduled task in ticks, from 1 to 65535.
+ *   The task ID is the value returned by Task_Scheduler_Add, from 0 to 15.
+ */
+typedef enum
+{
+    COMMAND_PROTOCOL_MOTOR_LEFT     = 0x00,
+    COMMAND_PROTOCOL_MOTOR_RIGHT    = 0x01,
+    COMMAND_PROTOCOL_SERVO_ANGLE    = 0x10,
+    COMMAND_PROTOCOL_SERVO_COUNTS   = 0x20,
+    COMMAND_PROTOCOL_TASK_PERIOD    = 0x30
+} Command_Protocol_Target;
+
+/**
+ * @brief Status returned in the first payload byte of each reply.
+ */
+typedef enum
+{
+    COMMAND_PROTOCOL_OK = 0,
+    COMMAND_PROTOCOL_UNKNOWN_OPCODE,
+    COMMAND_PROTOCOL_BAD_LENGTH,
+    COMMAND_PROTOCOL_BAD_SETPOINT,
+    COMMAND_PROTOCOL_COMMIT_FAILED
+} Command_Protocol_Status;
+
+/**
+ * @brief State reported by COMMAND_PROTOCOL_GET_STATE, in the order of the reply payload.
+ *
+ * servo_done holds one bit per servo, set when the servo has reached its target.
+ */
+typedef struct
+{
+    uint32_t ticks;
+    int16_t left_duty_cycle;
+    int16_t right_duty_cycle;
+    uint16_t servo_position[SERVO_TRAJECTORY_NUM_SERVOS];
+    uint8_t servo_done;
+    uint16_t sleep_permille;
+    uint16_t crc_error_count;
+} Command_Protocol_State;
+
+/**
+ * @brief Receive statistics of the Command_Protocol driver.
+ */
+typedef struct
+{
+    uint32_t frame_count;
+    uint32_t crc_error_count;
+    uint32_t timeout_count;
+} Command_Protocol_Stats;
+
+/**
+ * @brief Initialize the Command_Protocol driver.
+ *
+ * This function resets the frame parser and the statistics.
+ *
+ * @note EUSCI_A0_UART_Init (or EUSCI_A0_UART_Init_Printf) and Cycle_Counter_Init must be called before
+ *       Command_Protocol_Process is used.
+ *
+ * @return None
+ */
+void Command_Protocol_Init(void);
+
+/**
+ * @brief Process the received bytes and execute each complete command frame.
+ *
+ * This function removes every byte from the EUSCI_A0 receive ring buffer with EUSCI_A0_UART_Try_InChar.
+ * Bytes that are part of a frame are parsed, and the command is executed and answered as soon as its CRC has been checked.
+ * Other bytes are passed to EUSCI_A0_UART_Process_Char. It never waits for input, so it should be called from the main loop
+ * after each wake-up instead of EUSCI_A0_UART_Process_Input.
+ *
+ * @return None
+ */
+void Command_Protocol_Process(void);
+
+/**
+ * @brief Return the receive statistics.
+ *
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void Command_Protocol_Get_Stats(Command_Protocol_Stats *stats);
+
+#endif /* COMMAND_PROTOCOL_H_ */
@@ -0,0 +1,148 @@
+/**
+ * @file Cycle_Counter.h
+ * @brief Header file for the Cycle_Counter driver.
+ *
+ * This file contains the function definitions for the Cycle_Counter driver.
+ * It uses the Data Watchpoint and Trace (DWT) unit of the Cortex-M4 to count processor clock cycles,
+ * and it records the execution time of the interrupt service routines used in this lab.
+ *
+ * The DWT cycle counter (CYCCNT) is a free-running 32-bit counter that increments once per
+ * processor clock cycle. At 48 MHz, it overflows approximately every 89 seconds. Differences
+ * between two readings are computed with unsigned arithmetic, so a single overflow between
+ * the two readings does not affect the result.
+ *
+ * For more information regarding the DWT unit, refer to the ARMv7-M Architecture Reference Manual (Section C1.8)
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+
+// Set to 1 to record the execution time of the profiled interrupt service routines.
+// Set to 0 to remove the instrumentation from the interrupt service routines entirely.
+#define ISR_PROFILING_ENABLED 1
+
+// The number of recent samples kept for each profiled interrupt service routine.
+// These samples are used to compute the 99th percentile execution time.
+#define ISR_PROFILE_NUM_SAMPLES 256
+
+/**
+ * @brief Identifiers for the interrupt service routines that are profiled.
+ */
+typedef enum
+{
+    ISR_PROFILE_TA1_0 = 0,
+    ISR_PROFILE_PORT4,
+    ISR_PROFILE_PORT6,
+    ISR_PROFILE_TA2_0,
+    ISR_PROFILE_DMA_INT0,
+    ISR_PROFILE_EUSCIA0,
+    ISR_PROFILE_EUSCIA2,
+    ISR_PROFILE_COUNT
+} ISR_Profile_ID;
+
+/**
+ * @brief Execution time statistics for a single profiled interrupt service routine, in clock cycles.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t mean_cycles;
+    uint32_t p99_cycles;
+} ISR_Profile_Stats;
+
+/**
+ * @brief Read the current value of the DWT cycle counter.
+ */
+#define Cycle_Counter_Read()    (DWT->CYCCNT)
+
+#if (ISR_PROFILING_ENABLED)
+/**
+ * @brief Mark the start of a profiled interrupt service routine.
+ *
+ * This macro must be placed at the beginning of the interrupt service routine body.
+ * It declares a local variable that stores the cycle count on entry.
+ */
+#define ISR_PROFILE_BEGIN()     uint32_t isr_profile_start_cycles = Cycle_Counter_Read()
+
+/**
+ * @brief Mark the end of a profiled interrupt service routine.
+ *
+ * This macro must be placed at the end of the interrupt service routine body,
+ * after the user-defined task has been executed.
+ *
+ * @param id The ISR_Profile_ID of the interrupt service routine.
+ */
+#define ISR_PROFILE_END(id)     ISR_Profile_Record((id), Cycle_Counter_Read() - isr_profile_start_cycles)
+#else
+#define ISR_PROFILE_BEGIN()
+#define ISR_PROFILE_END(id)
+#endif
+
+/**
+ * @brief Initialize the DWT cycle counter.
+ *
+ * This function enables the trace subsystem (TRCENA bit in DEMCR), clears the cycle counter,
+ * and enables it. It also measures the overhead of a single pair of Cycle_Counter_Read calls,
+ * which is subtracted from every recorded sample. The statistics of all profiled interrupt
+ * service routines are cleared.
+ *
+ * @note The Cycle_Counter_Init function should be called before enabling interrupts.
+ *
+ * @return None
+ */
+void Cycle_Counter_Init(void);
+
+/**
+ * @brief Return the number of clock cycles elapsed since a previous reading of the cycle counter.
+ *
+ * @param start_cycles A value previously returned by Cycle_Counter_Read.
+ *
+ * @return The number of clock cycles elapsed since start_cycles was read.
+ */
+uint32_t Cycle_Counter_Elapsed(uint32_t start_cycles);
+
+/**
+ * @brief Record one execution time sample for a profiled interrupt service routine.
+ *
+ * This function is called by the ISR_PROFILE_END macro. It updates the minimum, maximum, and
+ * running sum of the execution time, and it stores the sample in a ring of the most recent
+ * ISR_PROFILE_NUM_SAMPLES samples. The measurement overhead is subtracted from the sample.
+ *
+ * @param id The ISR_Profile_ID of the interrupt service routine.
+ * @param cycles The measured execution time, in clock cycles.
+ *
+ * @return None
+ */
+void ISR_Profile_Record(ISR_Profile_ID id, uint32_t cycles);
+
+/**
+ * @brief Compute the execution time statistics of a profiled interrupt service routine.
+ *
+ * This function copies the recorded samples inside a critical section, then sorts the copy
+ * to find the 99th percentile. It should be called from the main loop, not from an interrupt
+ * service routine.
+ *
+ * @param id The ISR_Profile_ID of the interrupt service routine.
+ * @param stats Pointer to the structure that will hold the computed statistics.
+ *
+ * @return None
+ */
+void ISR_Profile_Get_Stats(ISR_Profile_ID id, ISR_Profile_Stats *stats);
+
+/**
+ * @brief Clear the recorded statistics of all profiled interrupt service routines.
+ *
+ * @return None
+ */
+void ISR_Profile_Reset(void);
+
+#endif /* CYCLE_COUNTER_H_ */
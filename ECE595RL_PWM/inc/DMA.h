@@ -0,0 +1,76 @@
+/**
+ * @file DMA.h
+ * @brief Header file for the DMA driver.
+ *
+ * This file contains the function definitions for the DMA driver.
+ * It configures the micro Direct Memory Access (uDMA) controller of the MSP432 to move a block of bytes
+ * from memory to the transmit buffer of a peripheral, one byte per peripheral request.
+ *
+ * Each channel is connected to one of several peripheral triggers, which is selected with a source number.
+ * For example, channel 0 with source 1 is triggered by the EUSCI_A0 transmit interrupt flag, and channel 6 with
+ * source 1 is triggered by the EUSCI_A3 transmit interrupt flag. Since the transmit interrupt flag stays set while
+ * the transmit buffer is empty, the first byte is transferred as soon as the channel is enabled.
+ *
+ * The completion of all channels is reported through the DMA_INT0 interrupt (IRQ 34). DMA_INT0_IRQHandler clears
+ * the completion flag of each finished channel and calls the callback that was given when the transfer was started.
+ *
+ * For more information regarding the uDMA controller, refer to the MSP432Pxx Microcontrollers Technical Reference Manual (Chapter 11)
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+
+// Number of uDMA channels of the MSP432P401R
+#define DMA_NUM_CHANNELS            8
+
+// Maximum number of items in a single basic mode transfer
+#define DMA_MAX_TRANSFER_SIZE       1024
+
+/**
+ * @brief Initialize the uDMA controller.
+ *
+ * This function sets the base address of the channel control table, enables the controller, and enables
+ * the DMA_INT0 interrupt in the NVIC with priority 3. It can be called more than once.
+ *
+ * @return None
+ */
+void DMA_Init(void);
+
+/**
+ * @brief Start a transfer of bytes from memory to a peripheral register.
+ *
+ * This function configures the primary control structure of the channel in basic mode with a source
+ * address that is incremented by one byte and a destination address that is not incremented.
+ * Then, it selects the trigger source of the channel and enables the channel. The function returns
+ * immediately, and the transfer proceeds at the rate of the peripheral requests.
+ *
+ * @param channel The uDMA channel, from 0 to DMA_NUM_CHANNELS - 1.
+ * @param source The trigger source number of the channel.
+ * @param source_buffer Pointer to the first byte to transfer. It must not be modified until the transfer completes.
+ * @param destination_register Pointer to the peripheral register that receives the bytes (for example, &EUSCI_A3->TXBUF).
+ * @param size The number of bytes to transfer, from 1 to DMA_MAX_TRANSFER_SIZE.
+ * @param done_task A pointer to the function that is called from DMA_INT0_IRQHandler when the transfer completes, or 0.
+ *
+ * @return 1 if the transfer was started, or 0 if the channel is busy or a parameter is invalid.
+ */
+uint8_t DMA_Transfer_To_Peripheral(uint8_t channel, uint8_t source, const uint8_t *source_buffer,
+                                   volatile void *destination_register, uint16_t size, void (*done_task)(void));
+
+/**
+ * @brief Check whether a transfer is in progress on a channel.
+ *
+ * @param channel The uDMA channel, from 0 to DMA_NUM_CHANNELS - 1.
+ *
+ * @return 1 if a transfer was started and its completion has not been handled yet, 0 otherwise.
+ */
+uint8_t DMA_Is_Busy(uint8_t channel);
+
+#endif /* DMA_H_ */
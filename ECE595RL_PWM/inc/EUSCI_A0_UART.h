@@ -9,6 +9,9 @@
  *
  * @note The pins P1.2 and P1.3 are used for UART communication via USB.
  *
+ * The ring buffers and the interrupt service routine are implemented by the EUSCI_A_UART driver,
+ * which is shared with the EUSCI_A2_UART driver.
+ *
  * @author Aaron Nanas
  *
  */
@@ -20,6 +23,59 @@
 #include <stdio.h>
 #include "msp.h"
 #include "file.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/DMA.h"
+#include "../inc/EUSCI_A_UART.h"
+#include "../inc/Format.h"
+
+/**
+ * @brief Baud rate selected by EUSCI_A0_UART_Init, in bits per second.
+ */
+#define EUSCI_A0_UART_BAUD_RATE 115200
+
+/**
+ * @brief Size of the transmit ring buffer in bytes. It must be a power of two.
+ */
+#define EUSCI_A0_UART_TX_BUFFER_SIZE 256
+
+/**
+ * @brief Size of the receive ring buffer in bytes. It must be a power of two.
+ */
+#define EUSCI_A0_UART_RX_BUFFER_SIZE 64
+
+/**
+ * @brief uDMA channel and trigger source (EUSCI_A0 transmit interrupt flag) used by EUSCI_A0_UART_Write_DMA.
+ */
+#define EUSCI_A0_UART_DMA_CHANNEL   0
+#define EUSCI_A0_UART_DMA_SOURCE    1
+
+/**
+ * @brief Size of the line buffer used by EUSCI_A0_UART_Process_Input, including the NULL terminator.
+ */
+#define EUSCI_A0_UART_LINE_BUFFER_SIZE 64
+
+/**
+ * @brief Size of the stdout buffer set by EUSCI_A0_UART_Init_Printf.
+ *
+ * stdout is line buffered, so the C library hands a whole line to EUSCI_A0_UART_Write at a time instead of
+ * calling it once per character. A line longer than the buffer is written in several parts.
+ */
+#define EUSCI_A0_UART_PRINTF_BUFFER_SIZE 128
+
+/**
+ * @brief Behavior of EUSCI_A0_UART_OutChar when the transmit ring buffer is full.
+ *
+ * - EUSCI_A0_UART_TX_OVERFLOW_DROP: The character is discarded and the dropped byte counter is incremented.
+ * - EUSCI_A0_UART_TX_OVERFLOW_BLOCK: The caller waits until there is room in the buffer. From the main loop,
+ *   it waits for the transmit interrupt. From an interrupt service routine or with interrupts disabled,
+ *   it sends the oldest byte directly.
+ */
+typedef EUSCI_A_UART_TX_Overflow_Policy EUSCI_A0_UART_TX_Overflow_Policy;
+
+#define EUSCI_A0_UART_TX_OVERFLOW_DROP      EUSCI_A_UART_TX_OVERFLOW_DROP
+#define EUSCI_A0_UART_TX_OVERFLOW_BLOCK     EUSCI_A_UART_TX_OVERFLOW_BLOCK
 
 /**
  * @brief Carriage return character
@@ -55,38 +111,213 @@
  * - Parity: Disabled
  * - Stop bits: 1
  * - Data bits: 8
- * - Baud rate: 115200
+ * - Baud rate: EUSCI_A0_UART_BAUD_RATE (115200), generated from SMCLK with the fractional divider of the EUSCI_A_UART driver
  * - Mode: UART
  * - LSB first
  * - UART clock source: SMCLK
- * - Interrupts disabled
+ * - Receive interrupt (IRQ 16, priority 3) always enabled, including for characters with receive errors
+ * - Transmit interrupt (IRQ 16, priority 3) enabled while the transmit ring buffer holds data
  *
  * For more information regarding the registers used, refer to the eUSCI_A UART Registers section (24.4)
  * of the MSP432Pxx Microcontrollers Technical Reference Manual
  *
+ * @note Clock_Init48MHz must be called first, since the divider is computed from the value returned by Clock_GetSMCLKFreq.
+ *
  * @note Pins P1.2 and P1.3 are used for UART communication via USB.
  *
  * @return None
  */
 void EUSCI_A0_UART_Init();
 
+/**
+ * @brief Change the baud rate of EUSCI_A0.
+ *
+ * The characters already in the transmit ring buffer are sent at the previous baud rate before the change.
+ * With SMCLK = 12 MHz, rates such as 230400, 460800, and 921600 baud can be used for high-throughput transfers.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @param baud_rate The new baud rate in bits per second.
+ *
+ * @return 1 on success, or 0 if the baud rate cannot be generated from SMCLK or a DMA transfer is in progress.
+ */
+uint8_t EUSCI_A0_UART_Set_Baud_Rate(uint32_t baud_rate);
+
+/**
+ * @brief Select what EUSCI_A0_UART_OutChar does when the transmit ring buffer is full.
+ *
+ * The default policy is EUSCI_A0_UART_TX_OVERFLOW_BLOCK, so that no output is lost.
+ *
+ * @param policy The overflow policy to use.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Set_TX_Overflow_Policy(EUSCI_A0_UART_TX_Overflow_Policy policy);
+
+/**
+ * @brief Return the number of characters discarded because the transmit ring buffer was full.
+ *
+ * The counter is only incremented when the EUSCI_A0_UART_TX_OVERFLOW_DROP policy is selected.
+ * It is cleared by EUSCI_A0_UART_Init.
+ *
+ * @return The number of dropped characters.
+ */
+uint32_t EUSCI_A0_UART_Get_TX_Dropped_Count();
+
+/**
+ * @brief Return the number of characters that can be added to the transmit ring buffer without overflowing it.
+ *
+ * @return The number of free bytes in the transmit ring buffer.
+ */
+uint16_t EUSCI_A0_UART_Get_TX_Free_Space();
+
+/**
+ * @brief Wait until every character in the transmit ring buffer has been transmitted.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Flush();
+
+/**
+ * @brief Return the number of received characters discarded because the receive ring buffer was full.
+ *
+ * The counter is cleared by EUSCI_A0_UART_Init.
+ *
+ * @return The number of dropped characters.
+ */
+uint32_t EUSCI_A0_UART_Get_RX_Dropped_Count();
+
+/**
+ * @brief Copy the transmit and receive statistics of EUSCI_A0, including the overrun and receive error counters.
+ *
+ * The statistics are cleared by EUSCI_A0_UART_Init.
+ *
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Get_Stats(EUSCI_A_UART_Stats *stats);
+
+/**
+ * @brief Add a block of bytes to the transmit ring buffer.
+ *
+ * Unlike EUSCI_A0_UART_Write, which is used by printf, this function sends the bytes unchanged.
+ *
+ * @param data Pointer to the bytes to transmit.
+ * @param length The number of bytes to transmit.
+ *
+ * @return The number of bytes added to the ring buffer. It is less than length only with the
+ *         EUSCI_A0_UART_TX_OVERFLOW_DROP policy.
+ */
+uint16_t EUSCI_A0_UART_Write_Bytes(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Transmit a block of bytes with the uDMA controller.
+ *
+ * The block is sent by DMA channel EUSCI_A0_UART_DMA_CHANNEL as soon as the bytes already in the transmit ring buffer
+ * have been sent, so it is never mixed with the text or records written with EUSCI_A0_UART_OutChar. The CPU is only
+ * involved at the start and at the end of the transfer. Bytes written to the ring buffer during the transfer are sent after it.
+ *
+ * It is safe to call this function from an interrupt service routine.
+ *
+ * @note DMA_Init must be called first. The block must not be modified until done_task is called.
+ *
+ * @param data Pointer to the bytes to transmit.
+ * @param size The number of bytes to transmit, from 1 to DMA_MAX_TRANSFER_SIZE.
+ * @param done_task A pointer to the function that is called from DMA_INT0_IRQHandler when the last byte has been
+ *                  written to the transmit buffer (or when the DMA channel was found busy and the block was dropped),
+ *                  or 0. It is not called if the block is rejected.
+ *
+ * @return 1 if the block was accepted, or 0 if a previous block has not been sent yet or size is invalid.
+ */
+uint8_t EUSCI_A0_UART_Write_DMA(const uint8_t *data, uint16_t size, void (*done_task)(void));
+
+/**
+ * @brief Remove up to max bytes from the receive ring buffer without waiting.
+ *
+ * @param data Pointer to the buffer that will hold the bytes.
+ * @param max The maximum number of bytes to remove.
+ *
+ * @return The number of bytes removed.
+ */
+uint16_t EUSCI_A0_UART_Read_Bytes(uint8_t *data, uint16_t max);
+
 /**
  * @brief The EUSCI_A0_UART_InChar function reads a character from the UART receive buffer.
  *
- * This function waits until a character is available in the UART receive buffer (EUSCI_A0)
- * from the serial terminal input and returns the received character as a char type.
+ * Characters are moved from the UART receive buffer (EUSCI_A0) to the receive ring buffer by EUSCIA0_IRQHandler.
+ * This function waits until a character is available in the ring buffer, sleeping with WaitForInterrupt between
+ * interrupts, and returns the oldest received character as a char type.
  *
  * @param None
  *
  * @return The received character from the serial terminal as a char type.
+ *
+ * @note This function blocks the main loop until a character arrives, but interrupts, including the scheduled tasks, keep running.
  */
 char EUSCI_A0_UART_InChar();
 
+/**
+ * @brief Read a character from the receive ring buffer without waiting.
+ *
+ * @param letter Pointer to the location that will hold the received character.
+ *
+ * @return 1 if a character was read, or 0 if the receive ring buffer is empty.
+ */
+uint8_t EUSCI_A0_UART_Try_InChar(char *letter);
+
+/**
+ * @brief Set the function that is called by EUSCI_A0_UART_Process_Input when a full line has been received.
+ *
+ * The function receives a pointer to the NULL-terminated line (without the carriage return) and its length.
+ * The line buffer is reused for the next line after the function returns.
+ *
+ * @param line_task A pointer to the user-defined function, or 0 to discard the received lines.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Set_Line_Task(void (*line_task)(char *line, uint16_t length));
+
+/**
+ * @brief Process the received characters and call the line task for each complete line.
+ *
+ * This function removes every character from the receive ring buffer and edits the current line incrementally,
+ * in the same way as EUSCI_A0_UART_InString:
+ * - A backspace (BS, or DEL as sent by most terminals) removes the last character of the line, if any, and BS is echoed.
+ * - A carriage return (CR) ends the line. CR and LF are echoed, and the line task is called.
+ * - A line feed (LF) is ignored, so that CR LF line endings are accepted.
+ * - Any other character is added to the line and echoed, unless the line already holds (EUSCI_A0_UART_LINE_BUFFER_SIZE - 1) characters.
+ *
+ * It never waits for input, so it should be called from the main loop after each wake-up. The receive interrupt only copies
+ * each character into the ring buffer, so console input does not delay the higher-priority control interrupts.
+ *
+ * @note EUSCI_A0_UART_InChar and the functions that use it must not be used while input is processed by this function.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Process_Input();
+
+/**
+ * @brief Add a single received character to the current line, as described for EUSCI_A0_UART_Process_Input.
+ *
+ * This function is used by drivers that read the receive ring buffer themselves (for example, Command_Protocol)
+ * and pass the characters that they do not use to the line editor.
+ *
+ * @param character The received character.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Process_Char(char character);
+
 /**
  * @brief The EUSCI_A0_UART_OutChar function transmits a character via UART to the serial terminal.
  *
- * This function waits until the UART transmit buffer (EUSCI_A0) is ready to accept
- * a new character and then writes the specified character in the transmit buffer to the serial terminal.
+ * This function adds the specified character to the transmit ring buffer and enables the transmit interrupt.
+ * The character is written to the UART transmit buffer (EUSCI_A0) by EUSCIA0_IRQHandler, so the function
+ * returns immediately unless the ring buffer is full. In that case, the selected overflow policy applies.
+ * It is safe to call this function from an interrupt service routine.
  *
  * @param letter The character to be transmitted to the serial terminal.
  *
@@ -226,8 +457,8 @@ int EUSCI_A0_UART_Close(int dev_fd);
 /**
  * @brief The EUSCI_A0_UART_Read function reads data from the UART receive buffer.
  *
- * This function reads data from the UART receive buffer (EUSCI_A0) and stores it in the provided buffer (buf).
- * It reads a single character at a time and echoes it back to the UART for display.
+ * This function reads a single character with EUSCI_A0_UART_InChar, stores it in the provided buffer (buf),
+ * and echoes it back to the UART for display.
  *
  * @param dev_fd Device file descriptor.
  * @param buf Pointer to the buffer where the read data will be stored.
@@ -241,7 +472,8 @@ int EUSCI_A0_UART_Read(int dev_fd, char *buf, unsigned count);
  * @brief The EUSCI_A0_UART_Write function writes data to the UART transmit buffer.
  *
  * This function writes data from the provided buffer (buf) to the UART transmit buffer (EUSCI_A0) for transmission.
- * It transmits each character one by one and handles newline character ('\n') by sending a carriage return ('\r') first.
+ * The bytes between two newline characters ('\n') are added to the transmit ring buffer as a block with
+ * EUSCI_A0_UART_Write_Bytes, and each newline character is sent after a carriage return ('\r').
  *
  * @param dev_fd Device file descriptor.
  * @param buf Pointer to the buffer containing the data to be transmitted.
@@ -291,7 +523,11 @@ int EUSCI_A0_UART_Rename(const char *old_name, const char *new_name);
  * @brief The EUSCI_A0_UART_Init_Printf function initializes the UART communication for printf output.
  *
  * This function initializes the UART module (EUSCI_A0) for communication and configures it for printf output.
- * It adds the UART device to the device list, sets stdout to use the UART output, and turns off buffering for stdout.
+ * It adds the UART device to the device list, sets stdout to use the UART output, and makes stdout line buffered
+ * with a buffer of EUSCI_A0_UART_PRINTF_BUFFER_SIZE bytes.
+ *
+ * @note Since stdout is line buffered, text printed without a trailing newline is only sent when the buffer
+ * is full, when a newline is printed, or when fflush(stdout) is called.
  *
  * @param None
  *
@@ -3,6 +3,10 @@
  * @brief Header file for the EUSCI_A2_UART driver.
  *
  * This file contains the function definitions for the EUSCI_A2_UART driver.
+ * It is used for the link to a companion radio or coprocessor. Transmission and reception are interrupt-driven
+ * with ring buffers, so the main loop neither waits for each byte to be sent nor loses the bytes received
+ * while it is busy. The ring buffers and the interrupt service routine are implemented by the EUSCI_A_UART driver,
+ * which is shared with the EUSCI_A0_UART driver.
  *
  * @note Assumes that the necessary pin configurations for UART communication have been performed
  *       on the corresponding pins. P3.2 is used for UART RX while P3.3 is used for UART TX.
@@ -20,6 +24,25 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/EUSCI_A_UART.h"
+
+/**
+ * @brief Baud rate selected by EUSCI_A2_UART_Init, in bits per second.
+ */
+#define EUSCI_A2_UART_BAUD_RATE 115200
+
+/**
+ * @brief Size of the transmit ring buffer in bytes. It must be a power of two.
+ */
+#define EUSCI_A2_UART_TX_BUFFER_SIZE 128
+
+/**
+ * @brief Size of the receive ring buffer in bytes. It must be a power of two.
+ */
+#define EUSCI_A2_UART_RX_BUFFER_SIZE 128
 
 /**
  * @brief Initializes the UART module EUSCI_A2 for communication.
@@ -30,15 +53,20 @@
  * - Parity: Disabled
  * - Stop bits: 1
  * - Data bits: 8
- * - Baud rate: 115200
+ * - Baud rate: EUSCI_A2_UART_BAUD_RATE (115200), generated from SMCLK with the fractional divider of the EUSCI_A_UART driver
  * - Mode: UART
  * - MSB first
  * - UART clock source: SMCLK
- * - Interrupts disabled
+ * - Receive interrupt (IRQ 18, priority 3) always enabled, including for characters with receive errors
+ * - Transmit interrupt (IRQ 18, priority 3) enabled while the transmit ring buffer holds data
+ *
+ * The ring buffers are emptied, the statistics are cleared, and the EUSCI_A_UART_TX_OVERFLOW_BLOCK policy is selected.
  *
  * For more information regarding the registers used, refer to the eUSCI_A UART Registers section (24.4)
  * of the MSP432Pxx Microcontrollers Technical Reference Manual
  *
+ * @note Clock_Init48MHz must be called first, since the divider is computed from the value returned by Clock_GetSMCLKFreq.
+ *
  * @note This function assumes that the necessary pin configurations for UART communication have been performed
  *       on the corresponding pins. P3.2 is used for UART RX while P3.3 is used for UART TX.
  *
@@ -46,17 +74,42 @@
  */
 void EUSCI_A2_UART_Init();
 
+/**
+ * @brief Change the baud rate of EUSCI_A2.
+ *
+ * The characters already in the transmit ring buffer are sent at the previous baud rate before the change.
+ * With SMCLK = 12 MHz, rates such as 230400, 460800, and 921600 baud can be used for high-throughput transfers.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @param baud_rate The new baud rate in bits per second.
+ *
+ * @return 1 on success, or 0 if the baud rate cannot be generated from SMCLK.
+ */
+uint8_t EUSCI_A2_UART_Set_Baud_Rate(uint32_t baud_rate);
+
+/**
+ * @brief Select what EUSCI_A2_UART_OutChar and EUSCI_A2_UART_Write do when the transmit ring buffer is full.
+ *
+ * @param policy The overflow policy to use (see EUSCI_A_UART_TX_Overflow_Policy).
+ *
+ * @return None
+ */
+void EUSCI_A2_UART_Set_TX_Overflow_Policy(EUSCI_A_UART_TX_Overflow_Policy policy);
+
 /**
  * @brief Transmits a single character over UART using the EUSCI_A2 module.
  *
- * This function transmits a single character over UART using the EUSCI_A2 module.
- * It waits until the UART transmit buffer is ready to accept new data and then writes the provided data
- * to the transmit buffer for transmission. A character consists of the following bits:
+ * This function adds the character to the transmit ring buffer and enables the transmit interrupt,
+ * which writes it to the UART transmit buffer. It returns immediately unless the ring buffer is full.
+ * In that case, the selected overflow policy applies. A character consists of the following bits:
  *
  * - 1 Start Bit
  * - 8 Data Bits
  * - 1 Stop Bit
  *
+ * It is safe to call this function from an interrupt service routine.
+ *
  * @param data The unsigned 8-bit data to be transmitted over UART.
  *
  * @return None
@@ -66,16 +119,78 @@ void EUSCI_A2_UART_OutChar(uint8_t data);
 /**
  * @brief Receives a single character over UART using the EUSCI_A2 module.
  *
- * This function receives a single character over UART using the EUSCI_A2 module.
- * It waits until a character is available in the UART receive buffer and then reads
- * the received data. A character consists of the following bits:
- *
- * - 1 Start Bit
- * - 8 Data Bits
- * - 1 Stop Bit
+ * Characters are moved from the UART receive buffer to the receive ring buffer by EUSCIA2_IRQHandler.
+ * This function waits until a character is available in the ring buffer, sleeping with WaitForInterrupt
+ * between interrupts, and returns the oldest received character.
  *
  * @return The received unsigned 8-bit data from UART.
  */
 uint8_t EUSCI_A2_UART_InChar();
 
+/**
+ * @brief Read a character from the receive ring buffer without waiting.
+ *
+ * @param data Pointer to the location that will hold the received character.
+ *
+ * @return 1 if a character was read, or 0 if the receive ring buffer is empty.
+ */
+uint8_t EUSCI_A2_UART_Try_InChar(uint8_t *data);
+
+/**
+ * @brief Add a block of bytes to the transmit ring buffer.
+ *
+ * @param data Pointer to the bytes to transmit.
+ * @param length The number of bytes to transmit.
+ *
+ * @return The number of bytes added to the ring buffer. It is less than length only with the
+ *         EUSCI_A_UART_TX_OVERFLOW_DROP policy.
+ */
+uint16_t EUSCI_A2_UART_Write(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Remove up to max bytes from the receive ring buffer without waiting.
+ *
+ * @param data Pointer to the buffer that will hold the bytes.
+ * @param max The maximum number of bytes to remove.
+ *
+ * @return The number of bytes removed.
+ */
+uint16_t EUSCI_A2_UART_Read(uint8_t *data, uint16_t max);
+
+/**
+ * @brief Return the number of bytes waiting in the receive ring buffer.
+ *
+ * @return The number of received bytes that have not been read.
+ */
+uint16_t EUSCI_A2_UART_Get_RX_Available();
+
+/**
+ * @brief Return the number of bytes that can be added to the transmit ring buffer without overflowing it.
+ *
+ * @return The number of free bytes in the transmit ring buffer.
+ */
+uint16_t EUSCI_A2_UART_Get_TX_Free_Space();
+
+/**
+ * @brief Wait until every byte in the transmit ring buffer has been transmitted.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @return None
+ */
+void EUSCI_A2_UART_Flush();
+
+/**
+ * @brief Copy the transmit and receive statistics of EUSCI_A2.
+ *
+ * The statistics count the transmitted and received bytes, the bytes dropped because a ring buffer was full,
+ * the hardware overruns, and the characters discarded because of a framing, parity, or break error.
+ * They are cleared by EUSCI_A2_UART_Init.
+ *
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void EUSCI_A2_UART_Get_Stats(EUSCI_A_UART_Stats *stats);
+
 #endif /* EUSCI_A2_UART_H_ */
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Clock.h"
 
 /**
  * @brief Initializes the SPI module EUSCI_A3 for communication.
@@ -46,7 +47,7 @@
  *   1          UCSTEM       0x1        UCSTE pin is used to generate signal for 4-wire slave
  *   0          UCSWRST      0x1        eUSCI logic held in reset state
  *
- * - Clock Frequency: 1 MHz (refer to Page 20 of Nokia 5110 LCD datasheet)
+ * - Bit Rate: bit_rate, derived from the current SMCLK frequency (see EUSCI_A3_SPI_Prescaler)
  * - Interrupts disabled
  *
  * For more information regarding the registers used, refer to the eUSCI_A SPI Registers section (25.4)
@@ -58,9 +59,36 @@
  *       - P9.5 (SCLK)
  *       - P9.7 (MOSI, Master Out Slave In)
  *
+ * @param bit_rate The requested SPI bit rate, in bits per second.
+ *
  * @return None
  */
-void EUSCI_A3_SPI_Init();
+void EUSCI_A3_SPI_Init(uint32_t bit_rate);
+
+/**
+ * @brief Compute the EUSCI_A3 bit rate prescaler (BRW) for a requested bit rate.
+ *
+ * The prescaler is computed from the frequency returned by Clock_GetSMCLKFreq and rounded up, so the actual bit rate
+ * (SMCLK / prescaler) never exceeds the requested bit rate. With SMCLK = 12 MHz, the supported bit rates are
+ * 12 MHz / N, such as 4 MHz (N = 3), 3 MHz (N = 4), 2 MHz (N = 6), and 1 MHz (N = 12).
+ *
+ * @param bit_rate The requested SPI bit rate, in bits per second.
+ *
+ * @return The prescaler, from 1 to 65535.
+ */
+uint16_t EUSCI_A3_SPI_Prescaler(uint32_t bit_rate);
+
+/**
+ * @brief Change the bit rate of the EUSCI_A3 module.
+ *
+ * This function waits until the SPI is not busy, holds the EUSCI_A3 module in reset mode while the prescaler is written,
+ * and then enables the module again. The other settings of the module are not changed.
+ *
+ * @param bit_rate The requested SPI bit rate, in bits per second.
+ *
+ * @return The actual bit rate, in bits per second.
+ */
+uint32_t EUSCI_A3_SPI_Set_Bit_Rate(uint32_t bit_rate);
 
 /**
  * @brief The EUSCI_A3_SPI_Command_Write function writes a command byte to the SPI transmit buffer.
@@ -0,0 +1,325 @@
+/**
+ * @file EUSCI_A_UART.h
+ * @brief Header file for the EUSCI_A_UART driver.
+ *
+ * This file contains the function definitions for the EUSCI_A_UART driver.
+ * It implements the interrupt-driven transmit and receive ring buffers shared by the
+ * EUSCI_A0_UART and EUSCI_A2_UART drivers. Each of these drivers configures the pins and the
+ * registers of its eUSCI_A module, owns an EUSCI_A_UART_Port with the ring buffers, and calls
+ * EUSCI_A_UART_IRQ_Handler from its interrupt service routine.
+ *
+ * Each ring buffer has a single producer and a single consumer:
+ *
+ * - Transmit: Bytes are added by EUSCI_A_UART_Write_Byte or EUSCI_A_UART_Write and removed by the transmit interrupt.
+ *   The transmit interrupt is only enabled while the ring buffer holds data.
+ * - Receive: Bytes are added by the receive interrupt and removed by EUSCI_A_UART_Try_Read_Byte or EUSCI_A_UART_Read.
+ *
+ * A ring buffer is empty when its head and tail are equal, so it holds at most (size - 1) bytes.
+ *
+ * The transmitter can be handed off to another master, such as a DMA channel triggered by the transmit interrupt flag,
+ * with EUSCI_A_UART_Request_TX_Handoff. The handoff starts once the transmit ring buffer is empty, so a block sent by the
+ * other master never splits the messages written to the ring buffer. Until EUSCI_A_UART_Release_TX is called, bytes
+ * written to the ring buffer are held.
+ *
+ * The receive interrupt counts the following errors in EUSCI_A_UART_Stats:
+ *
+ * - Receive ring buffer full: The byte is discarded (rx_dropped_count).
+ * - Overrun (UCOE): A byte arrived before the previous one was read from RXBUF, so the previous one was lost (rx_overrun_count).
+ * - Framing, parity, or break (UCFE, UCPE, UCBRK): The byte is discarded (rx_error_count).
+ *   This requires the UCRXEIE bit of CTLW0, which passes erroneous bytes to the receive interrupt.
+ *
+ * The baud rate is generated from the clock with the fractional divider described in the Setting a Baud Rate section (24.3.10)
+ * of the Technical Reference Manual. For N = (Clock Frequency) / (Baud Rate):
+ *
+ * - N >= 16: Oversampling mode (UCOS16 = 1), UCBRx = INT(N / 16), UCBRFx = INT(N) mod 16
+ * - N < 16: Low-frequency mode (UCOS16 = 0), UCBRx = INT(N)
+ * - In both modes, UCBRSx is the modulation pattern of Table 24-4 for the fractional part of N.
+ *
+ * The recommended settings of Table 24-5 were found by searching for the lowest bit error, so some of them differ from
+ * this calculation (a different UCBRSx pattern, or the low-frequency mode for N slightly above 16). tools/host/test_baud_rate.c
+ * checks that the transmit bit error of each computed setting is within 0.5 percentage points of the recommended one.
+ * With SMCLK = 12 MHz, the worst-case
+ * transmit bit error at 115200 baud is -0.8%, against -1.6% for the integer divider alone (BRW = 104, no modulation).
+ * At 921600 baud with SMCLK = 12 MHz, N is 13.02, so the low-frequency mode is used.
+ *
+ * For more information regarding the Enhanced Universal Serial Communication Interface (eUSCI),
+ * refer to the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef EUSCI_A_UART_H_
+#define EUSCI_A_UART_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+
+/**
+ * @brief Behavior of EUSCI_A_UART_Write_Byte and EUSCI_A_UART_Write when the transmit ring buffer is full.
+ *
+ * - EUSCI_A_UART_TX_OVERFLOW_DROP: The bytes that do not fit are discarded and counted in tx_dropped_count.
+ * - EUSCI_A_UART_TX_OVERFLOW_BLOCK: The caller waits until there is room in the buffer. From the main loop,
+ *   it waits for the transmit interrupt. From an interrupt service routine or with interrupts disabled,
+ *   it sends the oldest byte directly.
+ */
+typedef enum
+{
+    EUSCI_A_UART_TX_OVERFLOW_DROP = 0,
+    EUSCI_A_UART_TX_OVERFLOW_BLOCK
+} EUSCI_A_UART_TX_Overflow_Policy;
+
+/**
+ * @brief Statistics of a UART port. They are cleared by EUSCI_A_UART_Init_Port.
+ */
+typedef struct
+{
+    uint32_t tx_count;
+    uint32_t rx_count;
+    uint32_t tx_dropped_count;
+    uint32_t rx_dropped_count;
+    uint32_t rx_overrun_count;
+    uint32_t rx_error_count;
+} EUSCI_A_UART_Stats;
+
+/**
+ * @brief Baud rate registers computed by EUSCI_A_UART_Compute_Baud_Rate.
+ *
+ * mctlw holds UCBRSx in bits 15-8, UCBRFx in bits 7-4, and UCOS16 in bit 0.
+ */
+typedef struct
+{
+    uint16_t brw;
+    uint16_t mctlw;
+} EUSCI_A_UART_Baud_Rate_Config;
+
+/**
+ * @brief State of a UART port. The fields are private to the EUSCI_A_UART driver.
+ */
+typedef struct
+{
+    EUSCI_A_Type *module;
+    uint8_t *tx_buffer;
+    uint16_t tx_mask;
+    volatile uint16_t tx_head;
+    volatile uint16_t tx_tail;
+    uint8_t *rx_buffer;
+    uint16_t rx_mask;
+    volatile uint16_t rx_head;
+    volatile uint16_t rx_tail;
+    EUSCI_A_UART_TX_Overflow_Policy tx_overflow_policy;
+    volatile uint8_t tx_handoff_state;
+    void (*tx_handoff_task)(void);
+    volatile EUSCI_A_UART_Stats stats;
+} EUSCI_A_UART_Port;
+
+/**
+ * @brief Attach the ring buffers to a UART port and enable its receive interrupt.
+ *
+ * This function empties the ring buffers, clears the statistics, selects the EUSCI_A_UART_TX_OVERFLOW_BLOCK policy,
+ * disables the transmit, start bit, and transmit complete interrupts, and enables the receive interrupt of the module.
+ *
+ * @note The module must already be configured and released from reset. The caller enables the interrupt in the NVIC.
+ *
+ * @param port Pointer to the port state.
+ * @param module Pointer to the eUSCI_A module, such as EUSCI_A0.
+ * @param tx_buffer Pointer to the transmit ring buffer.
+ * @param tx_size Size of the transmit ring buffer in bytes. It must be a power of two.
+ * @param rx_buffer Pointer to the receive ring buffer.
+ * @param rx_size Size of the receive ring buffer in bytes. It must be a power of two.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Init_Port(EUSCI_A_UART_Port *port, EUSCI_A_Type *module,
+                            uint8_t *tx_buffer, uint16_t tx_size,
+                            uint8_t *rx_buffer, uint16_t rx_size);
+
+/**
+ * @brief Compute the baud rate registers of an eUSCI_A module.
+ *
+ * @param clock_frequency Frequency of the UART clock source (BRCLK) in Hz, such as the value returned by Clock_GetSMCLKFreq.
+ * @param baud_rate The baud rate in bits per second.
+ * @param config Pointer to the structure that will hold the register values.
+ *
+ * @return 1 on success, or 0 if the baud rate is zero or higher than the clock frequency.
+ */
+uint8_t EUSCI_A_UART_Compute_Baud_Rate(uint32_t clock_frequency, uint32_t baud_rate, EUSCI_A_UART_Baud_Rate_Config *config);
+
+/**
+ * @brief Write the baud rate registers of an eUSCI_A module.
+ *
+ * @note The module must be held in reset (UCSWRST = 1).
+ *
+ * @param module Pointer to the eUSCI_A module, such as EUSCI_A0.
+ * @param clock_frequency Frequency of the UART clock source (BRCLK) in Hz.
+ * @param baud_rate The baud rate in bits per second.
+ *
+ * @return 1 on success, or 0 if the baud rate cannot be generated. The registers are not changed on failure.
+ */
+uint8_t EUSCI_A_UART_Set_Baud_Rate(EUSCI_A_Type *module, uint32_t clock_frequency, uint32_t baud_rate);
+
+/**
+ * @brief Change the baud rate of a running port.
+ *
+ * This function waits until the transmit ring buffer has been sent, holds the module in reset while the
+ * baud rate registers are written, and enables the receive interrupt again, since the reset clears it.
+ * The reset is done in a critical section once the transmitter is idle. Characters queued by an interrupt
+ * service routine after the buffer was sent are kept, and they are sent at the new baud rate.
+ * The receive ring buffer and the statistics are kept.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @param port Pointer to the port state.
+ * @param clock_frequency Frequency of the UART clock source (BRCLK) in Hz.
+ * @param baud_rate The new baud rate in bits per second.
+ *
+ * @return 1 on success, or 0 if the baud rate cannot be generated or the transmitter is handed off
+ *         (see EUSCI_A_UART_Request_TX_Handoff). The baud rate is not changed on failure.
+ */
+uint8_t EUSCI_A_UART_Change_Baud_Rate(EUSCI_A_UART_Port *port, uint32_t clock_frequency, uint32_t baud_rate);
+
+/**
+ * @brief Select what happens when the transmit ring buffer of a port is full.
+ *
+ * @param port Pointer to the port state.
+ * @param policy The overflow policy to use.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Set_TX_Overflow_Policy(EUSCI_A_UART_Port *port, EUSCI_A_UART_TX_Overflow_Policy policy);
+
+/**
+ * @brief Add a byte to the transmit ring buffer of a port.
+ *
+ * @param port Pointer to the port state.
+ * @param data The byte to transmit.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Write_Byte(EUSCI_A_UART_Port *port, uint8_t data);
+
+/**
+ * @brief Add a block of bytes to the transmit ring buffer of a port.
+ *
+ * The bytes are copied with the interrupts disabled once per block of free space instead of once per byte.
+ *
+ * @param port Pointer to the port state.
+ * @param data Pointer to the bytes to transmit.
+ * @param length The number of bytes to transmit.
+ *
+ * @return The number of bytes added to the ring buffer. It is less than length only with the
+ *         EUSCI_A_UART_TX_OVERFLOW_DROP policy.
+ */
+uint16_t EUSCI_A_UART_Write(EUSCI_A_UART_Port *port, const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Remove a byte from the receive ring buffer of a port without waiting.
+ *
+ * @param port Pointer to the port state.
+ * @param data Pointer to the location that will hold the byte.
+ *
+ * @return 1 if a byte was removed, 0 if the receive ring buffer was empty.
+ */
+uint8_t EUSCI_A_UART_Try_Read_Byte(EUSCI_A_UART_Port *port, uint8_t *data);
+
+/**
+ * @brief Remove up to max bytes from the receive ring buffer of a port without waiting.
+ *
+ * @param port Pointer to the port state.
+ * @param data Pointer to the buffer that will hold the bytes.
+ * @param max The maximum number of bytes to remove.
+ *
+ * @return The number of bytes removed.
+ */
+uint16_t EUSCI_A_UART_Read(EUSCI_A_UART_Port *port, uint8_t *data, uint16_t max);
+
+/**
+ * @brief Return the number of bytes waiting in the receive ring buffer of a port.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return The number of received bytes that have not been read.
+ */
+uint16_t EUSCI_A_UART_Get_RX_Available(EUSCI_A_UART_Port *port);
+
+/**
+ * @brief Return the number of bytes that can be added to the transmit ring buffer of a port without overflowing it.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return The number of free bytes in the transmit ring buffer.
+ */
+uint16_t EUSCI_A_UART_Get_TX_Free_Space(EUSCI_A_UART_Port *port);
+
+/**
+ * @brief Wait until every byte in the transmit ring buffer of a port has been transmitted and the transmitter is not handed off.
+ *
+ * @note This function must not be called with interrupts disabled or from an interrupt service routine.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Flush(EUSCI_A_UART_Port *port);
+
+/**
+ * @brief Request exclusive use of the transmitter of a port.
+ *
+ * If the transmit ring buffer is empty, start_task is called immediately. Otherwise, it is called from the interrupt
+ * service routine as soon as the last byte of the ring buffer has been written to TXBUF. The start task must start the
+ * other master, for example with DMA_Transfer_To_Peripheral, and EUSCI_A_UART_Release_TX must be called once it is done.
+ *
+ * While the transmitter is handed off, the ring buffer keeps accepting bytes. If it becomes full, the overflow policy
+ * applies, except that callers in an interrupt service routine or with interrupts disabled drop the byte instead of sending it.
+ *
+ * @param port Pointer to the port state.
+ * @param start_task Pointer to the function that starts the other master.
+ *
+ * @return 1 if the request was accepted, or 0 if a handoff is already pending or in progress.
+ */
+uint8_t EUSCI_A_UART_Request_TX_Handoff(EUSCI_A_UART_Port *port, void (*start_task)(void));
+
+/**
+ * @brief Return the transmitter of a port to the ring buffer after a handoff.
+ *
+ * It is safe to call this function from an interrupt service routine, such as the completion callback of a DMA transfer.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Release_TX(EUSCI_A_UART_Port *port);
+
+/**
+ * @brief Check whether a transmitter handoff is pending or in progress.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return 1 if a handoff is pending or in progress, 0 otherwise.
+ */
+uint8_t EUSCI_A_UART_Is_TX_Handoff_Busy(EUSCI_A_UART_Port *port);
+
+/**
+ * @brief Copy the statistics of a port.
+ *
+ * @param port Pointer to the port state.
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_Get_Stats(EUSCI_A_UART_Port *port, EUSCI_A_UART_Stats *stats);
+
+/**
+ * @brief Service the receive and transmit interrupts of a port.
+ *
+ * This function is called from the interrupt service routine of the eUSCI_A module. It moves a received byte
+ * to the receive ring buffer and sends the next byte of the transmit ring buffer.
+ *
+ * @param port Pointer to the port state.
+ *
+ * @return None
+ */
+void EUSCI_A_UART_IRQ_Handler(EUSCI_A_UART_Port *port);
+
+#endif /* EUSCI_A_UART_H_ */
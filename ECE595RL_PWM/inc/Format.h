@@ -0,0 +1,117 @@
+/**
+ * @file Format.h
+ * @brief Header file for the Format driver.
+ *
+ * This file contains the function definitions for the Format driver.
+ * It converts integers into decimal and hexadecimal ASCII strings for the EUSCI_A0_UART and Nokia5110_LCD drivers.
+ *
+ * The decimal conversion produces two digits per step instead of one:
+ *  - The quotient of the division by 100 is computed with a multiplication by a fixed-point reciprocal
+ *    ((n * 0x51EB851F) >> 37, which is exact for every 32-bit value) instead of a division instruction.
+ *  - The remainder (0 to 99) selects a pair of ASCII digits from a 200-byte table.
+ *
+ * A 32-bit value therefore takes at most five multiplications and no divisions, and no recursion is used.
+ * The digits are written from the end of a local buffer toward its start, then copied to the destination.
+ *
+ * All functions write a NULL-terminated string and return its length (without the terminator).
+ * FORMAT_BUFFER_SIZE bytes are enough for any value when the requested width is at most FORMAT_BUFFER_SIZE - 1.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+
+// Size of a buffer that holds any formatted 32-bit value, including the sign, the decimal point, and the terminator
+#define FORMAT_BUFFER_SIZE      16
+
+/**
+ * @brief Convert an unsigned number into a decimal string.
+ *
+ * @param buffer Pointer to the destination. It must hold at least 11 bytes.
+ * @param n The number to convert.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_UDec(char *buffer, uint32_t n);
+
+/**
+ * @brief Convert a signed number into a decimal string, with a leading '-' if the number is negative.
+ *
+ * @param buffer Pointer to the destination. It must hold at least 12 bytes.
+ * @param n The number to convert.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_SDec(char *buffer, int32_t n);
+
+/**
+ * @brief Convert an unsigned number into a right-justified decimal string of a fixed width.
+ *
+ * The digits are padded on the left with spaces. If the number has more digits than the width, all digits are written.
+ *
+ * @param buffer Pointer to the destination. It must hold at least (width + 1) bytes, and at least 11 bytes.
+ * @param n The number to convert.
+ * @param width The minimum number of characters to write.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_UDec_Width(char *buffer, uint32_t n, uint32_t width);
+
+/**
+ * @brief Convert a signed number into a right-justified decimal string of a fixed width.
+ *
+ * A '-' is written immediately before the first digit if the number is negative, and the result is padded
+ * on the left with spaces.
+ *
+ * @param buffer Pointer to the destination. It must hold at least (width + 1) bytes, and at least 12 bytes.
+ * @param n The number to convert.
+ * @param width The minimum number of characters to write.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_SDec_Width(char *buffer, int32_t n, uint32_t width);
+
+/**
+ * @brief Convert an unsigned fixed-point number into a right-justified decimal string.
+ *
+ * The number is interpreted as n / (10 ^ decimals). At least one digit is written before the decimal point,
+ * so with one decimal, 5 is written as "0.5" and 1234 as "123.4".
+ *
+ * @param buffer Pointer to the destination. It must hold at least (width + 1) bytes, and at least FORMAT_BUFFER_SIZE bytes.
+ * @param n The fixed-point number to convert.
+ * @param decimals The number of digits after the decimal point, from 0 to 9. No decimal point is written for 0.
+ * @param width The minimum number of characters to write. The result is padded on the left with spaces.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_UFix(char *buffer, uint32_t n, uint32_t decimals, uint32_t width);
+
+/**
+ * @brief Convert a signed fixed-point number into a right-justified decimal string.
+ *
+ * The number is formatted like Format_UFix, with a '-' immediately before the first digit if the number is negative.
+ *
+ * @param buffer Pointer to the destination. It must hold at least (width + 1) bytes, and at least FORMAT_BUFFER_SIZE bytes.
+ * @param n The fixed-point number to convert.
+ * @param decimals The number of digits after the decimal point, from 0 to 9.
+ * @param width The minimum number of characters to write.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_SFix(char *buffer, int32_t n, uint32_t decimals, uint32_t width);
+
+/**
+ * @brief Convert an unsigned number into an uppercase hexadecimal string without leading zeros.
+ *
+ * @param buffer Pointer to the destination. It must hold at least 9 bytes.
+ * @param n The number to convert.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+uint32_t Format_UHex(char *buffer, uint32_t n);
+
+#endif /* FORMAT_H_ */
@@ -0,0 +1,113 @@
+/**
+ * @file Motion_Sequencer.h
+ * @brief Header file for the Motion_Sequencer driver.
+ *
+ * This file contains the function definitions for the Motion_Sequencer driver.
+ * It executes a table of motor commands without blocking the CPU. Each step of the table
+ * specifies a motor command, the duty cycles for the left and right motors, and a duration.
+ *
+ * The sequencer is advanced by Motion_Sequencer_Tick, which should be called from a periodic
+ * interrupt (for example, the Timer A1 task) with the time elapsed since the previous call.
+ * Since the elapsed time is passed as a parameter, the sequencer does not depend on a specific
+ * timer and can be driven with virtual time. tools/host/test_motion_sequencer.c uses this to check
+ * the step timing on the host.
+ *
+ * Starting a new sequence preempts the sequence that is running, if any. For example, the bumper
+ * sensor handler can abort a drive pattern by starting a collision handling sequence.
+ *
+ * @note The Motor driver must be initialized with Motor_Init before using this driver.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef MOTION_SEQUENCER_H_
+#define MOTION_SEQUENCER_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/Motor.h"
+
+/**
+ * @brief Motor commands that can be used in a motion step.
+ */
+typedef enum
+{
+    MOTION_STOP = 0,
+    MOTION_FORWARD,
+    MOTION_BACKWARD,
+    MOTION_LEFT,
+    MOTION_RIGHT
+} Motion_Command;
+
+/**
+ * @brief A single step of a motion sequence.
+ *
+ * The duty cycles are given in Timer A0 ticks, as in the Motor driver.
+ * They are ignored for the MOTION_STOP command.
+ */
+typedef struct
+{
+    Motion_Command command;
+    uint16_t left_duty_cycle;
+    uint16_t right_duty_cycle;
+    uint16_t duration_ms;
+} Motion_Step;
+
+/**
+ * @brief Initialize the motion sequencer.
+ *
+ * This function clears the current sequence and stops the motors.
+ *
+ * @return None
+ */
+void Motion_Sequencer_Init(void);
+
+/**
+ * @brief Start executing a motion sequence.
+ *
+ * This function aborts the sequence that is running, if any, and applies the first step of the new
+ * sequence immediately. The remaining steps are applied by Motion_Sequencer_Tick. When the last step
+ * has completed, the motors are stopped and the done_task function is called from Motion_Sequencer_Tick.
+ *
+ * It is safe to call this function from an interrupt service routine.
+ *
+ * @param steps Pointer to the table of steps. The table must remain valid while the sequence runs.
+ * @param num_steps The number of steps in the table.
+ * @param done_task Pointer to a function called when the sequence completes. It can be 0.
+ *
+ * @return None
+ */
+void Motion_Sequencer_Start(const Motion_Step *steps, uint8_t num_steps, void(*done_task)(void));
+
+/**
+ * @brief Abort the running sequence and stop the motors.
+ *
+ * The done_task function of the aborted sequence is not called.
+ *
+ * @return None
+ */
+void Motion_Sequencer_Abort(void);
+
+/**
+ * @brief Check whether a sequence is running.
+ *
+ * @return 1 if a sequence is running. Otherwise, 0.
+ */
+uint8_t Motion_Sequencer_Is_Busy(void);
+
+/**
+ * @brief Advance the running sequence.
+ *
+ * This function subtracts the elapsed time from the duration of the current step and moves on to
+ * the next step when the current step has completed. If the elapsed time is longer than the rest of
+ * the current step, the excess is carried over to the following steps.
+ *
+ * @param elapsed_ms The time elapsed since the previous call, in milliseconds.
+ *
+ * @return None
+ */
+void Motion_Sequencer_Tick(uint16_t elapsed_ms);
+
+#endif /* MOTION_SEQUENCER_H_ */
@@ -6,6 +6,12 @@
  * It provides functions for initializing the motor driver, controlling motor movement in various directions,
  * adjusting motor speed with PWM, and stopping the motors.
  *
+ * Motor_Forward, Motor_Right, Motor_Left, and Motor_Backward do not change the outputs right away.
+ * The direction pins, the enable pins, and the duty cycles of both motors are committed together
+ * with Timer_A0_PWM_Commit, and they are applied at the next PWM period boundary. This ensures that
+ * the left and right motors never receive mismatched commands for a PWM period. Motor_Stop takes
+ * effect immediately.
+ *
  * @author Aaron Nanas
  *
  */
@@ -18,6 +24,9 @@
 #include "../inc/CortexM.h"
 #include "../inc/Timer_A0_PWM.h"
 
+// PWM period of the motors, in Timer A0 counts. A duty cycle must be less than this value.
+#define MOTOR_PWM_PERIOD 15000
+
 /**
  * @brief Initializes the DC motors.
  *
@@ -43,9 +52,9 @@ void Motor_Init();
  * @param left_duty_cycle The duty cycle for the left motor (0-99%).
  * @param right_duty_cycle The duty cycle for the right motor (0-99%).
  *
- * @return None
+ * @return 1 if the command was committed, or 0 if a duty cycle is not less than MOTOR_PWM_PERIOD.
  */
-void Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
+uint8_t Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
 
 /**
  * @brief Move the motors to turn right with specified duty cycles.
@@ -57,9 +66,9 @@ void Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
  * @param left_duty_cycle The duty cycle for the left motor (0-99%).
  * @param right_duty_cycle The duty cycle for the right motor (0-99%).
  *
- * @return None
+ * @return 1 if the command was committed, or 0 if a duty cycle is not less than MOTOR_PWM_PERIOD.
  */
-void Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
+uint8_t Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
 
 /**
  * @brief Move the motors to turn left with specified duty cycles.
@@ -71,9 +80,9 @@ void Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
  * @param left_duty_cycle The duty cycle for the left motor (0-99%).
  * @param right_duty_cycle The duty cycle for the right motor (0-99%).
  *
- * @return None
+ * @return 1 if the command was committed, or 0 if a duty cycle is not less than MOTOR_PWM_PERIOD.
  */
-void Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
+uint8_t Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
 
 /**
  * @brief Move the motors backward with specified duty cycles.
@@ -84,17 +93,33 @@ void Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
  * @param left_duty_cycle The duty cycle for the left motor (0-99%).
  * @param right_duty_cycle The duty cycle for the right motor (0-99%).
  *
- * @return None
+ * @return 1 if the command was committed, or 0 if a duty cycle is not less than MOTOR_PWM_PERIOD.
  */
-void Motor_Backward(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
+uint8_t Motor_Backward(uint16_t left_duty_cycle, uint16_t right_duty_cycle);
 
 /**
  * @brief Stop the motors and set the duty cycle to 0%.
  *
  * This function disables both motors, effectively stopping them, and sets the duty cycle for both motors to 0%.
+ * Unlike the other motor commands, it takes effect immediately, and it discards any command that has not
+ * been applied yet. It is safe to call this function from an interrupt service routine, and it is called by
+ * PORT4_IRQHandler when a bumper switch is pressed (see BUMPER_SENSORS_EMERGENCY_STOP_ENABLED).
  *
  * @return None
  */
 void Motor_Stop();
 
+/**
+ * @brief Return the duty cycles of the last motor command.
+ *
+ * The duty cycles are given in Timer A0 counts, with a negative value when the motor is commanded to move backward.
+ * After Motor_Stop, both duty cycles are 0. A command that has been committed but not yet applied is already reported.
+ *
+ * @param left_duty_cycle Pointer to the location that will hold the duty cycle of the left motor.
+ * @param right_duty_cycle Pointer to the location that will hold the duty cycle of the right motor.
+ *
+ * @return None
+ */
+void Motor_Get_Duty_Cycles(int16_t *left_duty_cycle, int16_t *right_duty_cycle);
+
 #endif /* MOTOR_H_ */
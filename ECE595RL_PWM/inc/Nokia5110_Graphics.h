@@ -0,0 +1,191 @@
+/**
+ * @file Nokia5110_Graphics.h
+ * @brief Header file for the Nokia5110_Graphics driver.
+ *
+ * This file contains the function definitions for the Nokia5110_Graphics driver.
+ * It draws lines, rectangles, circles, and bitmaps into the screen buffer of the Nokia5110_LCD driver.
+ *
+ * The screen buffer is stored in the bank-major layout of the LCD: each byte holds a vertical column of 8 pixels
+ * within a bank, and the banks are stored one after another. The functions in this driver use that layout
+ * directly instead of calling Nokia5110_SetPxl for every pixel:
+ *  - Horizontal spans are drawn by applying the same column mask to consecutive bytes, 4 bytes (one 32-bit word) at a time.
+ *  - Vertical spans are drawn 8 pixels (one byte) at a time.
+ *  - Bitmaps are copied one column byte at a time, shifted by the vertical offset within the bank.
+ *  - Text is rendered into column bytes with the font of the LCD, then copied like a bitmap.
+ *
+ * Every function clips its output to the screen, and it marks the modified region with Nokia5110_Invalidate_Region,
+ * so the result can be sent with Nokia5110_DisplayBuffer_Dirty.
+ *
+ * Bitmaps use the same bank-major layout as the screen buffer: a bitmap with a width of w columns and a height of h rows
+ * holds ((h + 7) / 8) banks of w bytes each, with the top row of each bank in the least significant bit.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef NOKIA5110_GRAPHICS_H_
+#define NOKIA5110_GRAPHICS_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Nokia5110_LCD.h"
+
+/**
+ * @brief Drawing modes of the graphics functions.
+ *
+ * For the shape functions, NOKIA5110_PIXEL_COPY has the same effect as NOKIA5110_PIXEL_SET.
+ * For Nokia5110_Blit, NOKIA5110_PIXEL_SET, NOKIA5110_PIXEL_CLEAR, and NOKIA5110_PIXEL_INVERT only affect the pixels
+ * that are set in the bitmap, while NOKIA5110_PIXEL_COPY replaces the whole rectangle covered by the bitmap.
+ */
+typedef enum
+{
+    NOKIA5110_PIXEL_CLEAR = 0,
+    NOKIA5110_PIXEL_SET,
+    NOKIA5110_PIXEL_INVERT,
+    NOKIA5110_PIXEL_COPY
+} Nokia5110_Pixel_Mode;
+
+/**
+ * @brief Draw a single pixel into the screen buffer.
+ *
+ * @param x The column of the pixel (0 to 83).
+ * @param y The row of the pixel (0 to 47).
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_Pixel(int32_t x, int32_t y, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Fill a rectangle in the screen buffer.
+ *
+ * For each bank covered by the rectangle, this function computes the mask of the rows that are covered,
+ * then applies the mask to the columns of the rectangle 32 bits at a time.
+ *
+ * @param x The leftmost column of the rectangle.
+ * @param y The top row of the rectangle.
+ * @param width The width of the rectangle, in pixels.
+ * @param height The height of the rectangle, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Fill_Rect(int32_t x, int32_t y, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw the outline of a rectangle in the screen buffer.
+ *
+ * @param x The leftmost column of the rectangle.
+ * @param y The top row of the rectangle.
+ * @param width The width of the rectangle, in pixels.
+ * @param height The height of the rectangle, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_Rect(int32_t x, int32_t y, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw a horizontal line in the screen buffer.
+ *
+ * @param x The leftmost column of the line.
+ * @param y The row of the line.
+ * @param width The length of the line, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_HLine(int32_t x, int32_t y, int32_t width, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw a vertical line in the screen buffer.
+ *
+ * @param x The column of the line.
+ * @param y The top row of the line.
+ * @param height The length of the line, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_VLine(int32_t x, int32_t y, int32_t height, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw a line between two points in the screen buffer.
+ *
+ * Horizontal and vertical lines are drawn with Nokia5110_Draw_HLine and Nokia5110_Draw_VLine. Other lines are drawn
+ * with Bresenham's algorithm, which moves a byte pointer and a bit mask through the buffer instead of computing
+ * the index of every pixel.
+ *
+ * @param x0 The column of the first point.
+ * @param y0 The row of the first point.
+ * @param x1 The column of the second point.
+ * @param y1 The row of the second point.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_Line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw the outline of a circle in the screen buffer.
+ *
+ * @param x_center The column of the center.
+ * @param y_center The row of the center.
+ * @param radius The radius, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @note With NOKIA5110_PIXEL_INVERT, the pixels where two octants meet may be inverted twice.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_Circle(int32_t x_center, int32_t y_center, int32_t radius, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Fill a circle in the screen buffer.
+ *
+ * The circle is drawn as one vertical span per column, so each span is drawn 8 pixels at a time
+ * and each pixel is drawn exactly once.
+ *
+ * @param x_center The column of the center.
+ * @param y_center The row of the center.
+ * @param radius The radius, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Fill_Circle(int32_t x_center, int32_t y_center, int32_t radius, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Copy a bank-major bitmap into the screen buffer at any position.
+ *
+ * Each column byte of the bitmap is shifted by the vertical offset of the bitmap within the bank (y & 7),
+ * and the result is combined with the two screen buffer bytes that it overlaps.
+ *
+ * @param x The leftmost column of the bitmap on the screen. It can be negative.
+ * @param y The top row of the bitmap on the screen. It can be negative.
+ * @param bitmap Pointer to the bitmap data, in the bank-major layout.
+ * @param width The width of the bitmap, in pixels.
+ * @param height The height of the bitmap, in pixels.
+ * @param mode The drawing mode.
+ *
+ * @return None
+ */
+void Nokia5110_Blit(int32_t x, int32_t y, const uint8_t *bitmap, int32_t width, int32_t height, Nokia5110_Pixel_Mode mode);
+
+/**
+ * @brief Draw a string of characters into the screen buffer at any position.
+ *
+ * The characters use the same font and the same 7x8 pixel cells as Nokia5110_OutString. Up to 12 characters are rendered
+ * into column bytes at a time with Nokia5110_Text_Columns, then copied with Nokia5110_Blit. The string does not wrap:
+ * characters past the right edge of the screen are clipped.
+ *
+ * @param x The leftmost column of the first character. It can be negative.
+ * @param y The top row of the characters. It can be negative.
+ * @param ptr Pointer to a NULL-terminated ASCII string.
+ * @param mode The drawing mode. NOKIA5110_PIXEL_COPY also clears the background of each character cell.
+ *
+ * @return None
+ */
+void Nokia5110_Draw_String(int32_t x, int32_t y, const char *ptr, Nokia5110_Pixel_Mode mode);
+
+#endif /* NOKIA5110_GRAPHICS_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file Nokia5110_Image.h
+ * @brief Header file for the Nokia5110_Image driver.
+ *
+ * This file contains the function definitions for the Nokia5110_Image driver.
+ * It draws images that were converted on the host by tools/bmp_to_nokia.py into the screen buffer of the Nokia5110_LCD driver.
+ *
+ * Nokia5110_PrintBMP parses a 4-bit Windows BMP at run time: it reads the header, compares every pixel with a threshold,
+ * and sets or clears one bit of the screen buffer per pixel. The BMP also stores 4 bits per pixel plus row padding.
+ * Instead, bmp_to_nokia.py applies the threshold at build time and stores the image in the bank-major 1 bit per pixel layout
+ * of the screen buffer (see Nokia5110_Graphics.h), so drawing an image only copies one column byte at a time with Nokia5110_Blit.
+ *
+ * The image data can be stored either raw or compressed with a byte-oriented run-length encoding (RLE).
+ * The RLE data is a sequence of packets, each starting with a header byte:
+ *  - If bit 7 of the header is set, the next byte is repeated ((header & 0x7F) + 1) times.
+ *  - Otherwise, the next (header + 1) bytes are copied as they are.
+ *
+ * The decoded bytes are the same as the raw bank-major data. RLE images are decoded one bank at a time into a buffer
+ * on the stack, then each bank is drawn with Nokia5110_Blit.
+ *
+ * Example of converting an image:
+ *  - python3 tools/bmp_to_nokia.py logo.bmp --name Logo --rle > logo_image.c
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef NOKIA5110_IMAGE_H_
+#define NOKIA5110_IMAGE_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Nokia5110_LCD.h"
+#include "../inc/Nokia5110_Graphics.h"
+
+// Image data is stored as raw bank-major bytes
+#define NOKIA5110_IMAGE_RAW             0
+
+// Image data is compressed with run-length encoding
+#define NOKIA5110_IMAGE_RLE             1
+
+// Widest RLE image that can be drawn, in pixels (size of the bank buffer on the stack)
+#define NOKIA5110_IMAGE_MAX_RLE_WIDTH   SCREENW
+
+/**
+ * @brief Image converted by tools/bmp_to_nokia.py.
+ *
+ * The data holds ((height + 7) / 8) banks of width bytes each, either raw or RLE-compressed as indicated by encoding.
+ * size is the number of bytes in data.
+ */
+typedef struct
+{
+    uint8_t width;
+    uint8_t height;
+    uint8_t encoding;
+    uint16_t size;
+    const uint8_t *data;
+} Nokia5110_Image;
+
+/**
+ * @brief Draw a converted image into the screen buffer.
+ *
+ * Raw images are drawn directly with Nokia5110_Blit. RLE images are decoded one bank at a time, then each bank is drawn
+ * with Nokia5110_Blit, so any position is supported and the image is clipped to the screen. The modified region is marked
+ * with Nokia5110_Invalidate_Region.
+ *
+ * @param x The leftmost column of the image on the screen. It can be negative.
+ * @param y The top row of the image on the screen. It can be negative.
+ * @param image Pointer to the image.
+ * @param mode The drawing mode. NOKIA5110_PIXEL_COPY replaces the rectangle covered by the image.
+ *
+ * @note Unlike Nokia5110_PrintBMP, the position is the top-left corner of the image.
+ *
+ * @return 1 if the image was drawn, or 0 if the encoding is unknown, the RLE data is shorter than the image,
+ *         or an RLE image is wider than NOKIA5110_IMAGE_MAX_RLE_WIDTH.
+ */
+uint8_t Nokia5110_Draw_Image(int32_t x, int32_t y, const Nokia5110_Image *image, Nokia5110_Pixel_Mode mode);
+
+#endif /* NOKIA5110_IMAGE_H_ */
@@ -38,6 +38,9 @@
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/Clock.h"
+#include "../inc/DMA.h"
+#include "../inc/EUSCI_A3_SPI.h"
+#include "../inc/Format.h"
 
 /**
  * @brief The SCREENW constant defines the width of the screen in pixels as 84.
@@ -89,6 +92,13 @@
  */
 #define MAX_Y       48
 
+/**
+ * @brief The number of 8-pixel rows (banks) of the LCD.
+ *
+ * Each byte of the screen buffer holds a vertical column of 8 pixels within a bank.
+ */
+#define NOKIA5110_NUM_BANKS     (SCREENH/8)
+
 /**
  * @brief The CONTRAST constant represents the contrast value for the Nokia 5110 LCD display.
  *
@@ -100,11 +110,45 @@
  */
 #define CONTRAST   0xB1
 
+/**
+ * @brief The default SPI bit rate used by Nokia5110_Init.
+ *
+ * The PCD8544 controller of the Nokia 5110 LCD accepts a serial clock of up to 4 MHz (refer to Page 20 of the datasheet).
+ */
+#define NOKIA5110_SPI_BIT_RATE  4000000
+
+/**
+ * @brief The uDMA channel and trigger source used by Nokia5110_DisplayBuffer_DMA.
+ *
+ * Channel 6 with source 1 is triggered by the EUSCI_A3 transmit interrupt flag (UCTXIFG).
+ */
+#define NOKIA5110_DMA_CHANNEL   6
+#define NOKIA5110_DMA_SOURCE    1
+
+/**
+ * @brief The number of columns of each character cell: one blank column, five glyph columns, and one blank column.
+ */
+#define NOKIA5110_CHAR_WIDTH    7
+
+/**
+ * @brief The longest string that can be sent by Nokia5110_OutString_DMA, in characters (one row of the LCD by default).
+ */
+#define NOKIA5110_TEXT_DMA_MAX_CHARS    12
+
+/**
+ * @brief The screen buffer, in the bank-major layout of the LCD.
+ *
+ * The byte at index (SCREENW * bank + x) holds the pixels of column x in rows (8 * bank) to (8 * bank + 7),
+ * with the top row in the least significant bit. Functions that modify the buffer directly must call
+ * Nokia5110_Invalidate_Region so that the change is sent by Nokia5110_DisplayBuffer_Dirty.
+ */
+extern uint8_t Screen[SCREENW*SCREENH/8];
+
 /**
  * @brief The ASCII table contains the hexadecimal values that represent
  * pixels for a font that is 5 pixels wide and 8 pixels high
  */
-//extern const uint8_t ASCII[][5];
+extern const uint8_t ASCII[][5];
 
 /**
  * @brief Initializes the SPI module EUSCI_A3 for the Nokia 5110 LCD.
@@ -128,7 +172,8 @@
  *   1          UCSTEM       0x1        UCSTE pin is used to generate signal for 4-wire slave
  *   0          UCSWRST      0x1        eUSCI logic held in reset state
  *
- * - Clock Frequency: 4 MHz (refer to Page 20 of Nokia 5110 LCD datasheet)
+ * - Bit Rate: bit_rate, derived from the current SMCLK frequency (see EUSCI_A3_SPI_Prescaler).
+ *   The maximum is 4 MHz (refer to Page 20 of Nokia 5110 LCD datasheet)
  * - Interrupts disabled
  *
  * For more information regarding the registers used, refer to the eUSCI_A SPI Registers section (25.4)
@@ -137,9 +182,11 @@
  * @note This function assumes that the necessary pin configurations for SPI communication have been performed
  *       on the corresponding pins. The Nokia 5110 LCD does not have a Master In Slave Out (MISO) line.
  *
+ * @param bit_rate The requested SPI bit rate, in bits per second. Use EUSCI_A3_SPI_Set_Bit_Rate to change it later.
+ *
  * @return None
  */
-void Nokia5110_SPI_Init();
+void Nokia5110_SPI_Init(uint32_t bit_rate);
 
 /**
  * @brief The Nokia5110_SPI_Data_Command_Bit_Out function sets the data/command select bit for the Nokia5110 LCD.
@@ -208,6 +255,7 @@ void Nokia5110_Config();
  *
  * This function initializes the Nokia5110 LCD by performing the SPI initialization, reset, and configuration.
  * It calls the respective functions for SPI initialization, reset, and configuration.
+ * The SPI bit rate is set to NOKIA5110_SPI_BIT_RATE.
  *
  * @param None
  *
@@ -265,6 +313,10 @@ void Nokia5110_OutChar(char data);
  * The string will automatically wrap to the next row when reaching the right edge of the display,
  * so padding spaces may be needed to make the output look optimal.
  *
+ * Instead of calling Nokia5110_OutChar for each character, this function sets the Data/Command pin once
+ * and streams the columns of all characters back to back, only waiting for the transmit buffer to be empty
+ * before each byte.
+ *
  * @param ptr Pointer to a NULL-terminated ASCII string.
  *
  * @return None
@@ -273,6 +325,37 @@ void Nokia5110_OutChar(char data);
  */
 void Nokia5110_OutString(char *ptr);
 
+/**
+ * @brief The Nokia5110_OutString_DMA function starts printing a string of characters without waiting for the transfer.
+ *
+ * This function renders the columns of the string into a static buffer with Nokia5110_Text_Columns, sets the Data/Command pin
+ * for data, and starts a uDMA transfer of the columns to the EUSCI_A3 transmit buffer. It shares the uDMA channel and
+ * the busy flag with Nokia5110_DisplayBuffer_DMA, so Nokia5110_Flush_Busy returns 1 until the transfer completes.
+ *
+ * @param ptr Pointer to a NULL-terminated ASCII string of at most NOKIA5110_TEXT_DMA_MAX_CHARS characters.
+ *            The string is copied, so it can be modified as soon as the function returns.
+ * @param done_task A pointer to the function that is called from DMA_INT0_IRQHandler when the transfer completes, or 0.
+ *
+ * @return 1 if the transfer was started, or 0 if a previous transfer is still in progress or the string is empty or too long.
+ *
+ * @note DMA_Init must be called before using this function. Assumes the LCD is in the default horizontal addressing mode (V = 0).
+ */
+uint8_t Nokia5110_OutString_DMA(const char *ptr, void (*done_task)(void));
+
+/**
+ * @brief The Nokia5110_Text_Columns function renders a string of characters into an array of column bytes.
+ *
+ * Each character produces NOKIA5110_CHAR_WIDTH column bytes, in the same format as the bytes sent by Nokia5110_OutChar.
+ * Characters outside the range of the font (0x20 to 0x7F) are rendered as spaces.
+ *
+ * @param ptr Pointer to a NULL-terminated ASCII string.
+ * @param columns Pointer to the array that will hold the column bytes.
+ * @param max_chars The maximum number of characters to render.
+ *
+ * @return The number of characters that were rendered.
+ */
+uint32_t Nokia5110_Text_Columns(const char *ptr, uint8_t *columns, uint32_t max_chars);
+
 /**
  * @brief The Nokia5110_OutUDec function outputs a 16-bit number in unsigned decimal format.
  *
@@ -431,6 +514,10 @@ void Nokia5110_DrawFullImage(const uint8_t *ptr);
  * @param threshold Grayscale colors above this number make the corresponding pixel 'on'.
  *                  Valid range: 0 to 14. 0 is fine for ships, explosions, projectiles, and bunkers.
  *
+ * @note This function parses the BMP and tests every pixel at run time. Images that do not change can be converted
+ *       with tools/bmp_to_nokia.py and drawn with Nokia5110_Draw_Image (see Nokia5110_Image.h) instead, which takes
+ *       less flash and copies one column byte at a time.
+ *
  * @return None
  */
 void Nokia5110_PrintBMP(uint8_t xpos, uint8_t ypos, const uint8_t *ptr, uint8_t threshold);
@@ -460,6 +547,67 @@ void Nokia5110_ClearBuffer();
  */
 void Nokia5110_DisplayBuffer();
 
+/**
+ * @brief The Nokia5110_DisplayBuffer_DMA function starts drawing the RAM buffer on the screen without waiting for the transfer.
+ *
+ * This function moves the cursor to (0, 0), sets the Data/Command pin for data, and starts a uDMA transfer
+ * of the 504-byte screen buffer to the EUSCI_A3 transmit buffer. The CPU is only busy for the setup time;
+ * the bytes are moved by the uDMA controller at the rate of the SPI clock.
+ *
+ * While the transfer is in progress, Nokia5110_Command_Write and Nokia5110_Data_Write wait for it to finish,
+ * and changes to the screen buffer may appear on the screen in the current frame.
+ *
+ * @param done_task A pointer to the function that is called from DMA_INT0_IRQHandler when the transfer completes, or 0.
+ *                  The last byte may still be in the SPI shift register when it is called.
+ *
+ * @return 1 if the transfer was started, or 0 if a previous transfer is still in progress.
+ *
+ * @note DMA_Init must be called before using this function. Assumes the LCD is in the default horizontal addressing mode (V = 0).
+ */
+uint8_t Nokia5110_DisplayBuffer_DMA(void (*done_task)(void));
+
+/**
+ * @brief The Nokia5110_Flush_Busy function checks whether a transfer started by Nokia5110_DisplayBuffer_DMA or Nokia5110_OutString_DMA is in progress.
+ *
+ * @param None
+ *
+ * @return 1 if the transfer is in progress, 0 otherwise.
+ */
+uint8_t Nokia5110_Flush_Busy();
+
+/**
+ * @brief The Nokia5110_DisplayBuffer_Dirty function draws only the parts of the RAM buffer that changed since the last flush.
+ *
+ * The screen buffer functions (Nokia5110_SetPxl, Nokia5110_ClrPxl, Nokia5110_PrintBMP, and Nokia5110_ClearBuffer)
+ * record the first and last modified column of each bank. This function sends one span per modified bank:
+ * two cursor commands (0x80 | column, 0x40 | bank) followed by the modified columns. When only a few characters
+ * change between frames, this is more than 10 times less SPI traffic than Nokia5110_DisplayBuffer.
+ *
+ * Functions that write to the LCD directly (Nokia5110_OutChar, Nokia5110_Clear, and Nokia5110_DrawFullImage) make
+ * the LCD differ from the buffer, so they mark the whole buffer as modified. Nokia5110_DisplayBuffer and
+ * Nokia5110_DisplayBuffer_DMA send the whole buffer and mark it as unmodified.
+ *
+ * @param None
+ *
+ * @return The number of bytes sent to the LCD, including the cursor commands.
+ */
+uint16_t Nokia5110_DisplayBuffer_Dirty();
+
+/**
+ * @brief The Nokia5110_Invalidate_Region function marks a region of the RAM buffer as modified.
+ *
+ * This function is used by the screen buffer functions. It can also be used to force a region to be sent
+ * by the next call to Nokia5110_DisplayBuffer_Dirty. The region is clipped to the screen.
+ *
+ * @param x0 The leftmost column of the region.
+ * @param y0 The top row of the region.
+ * @param x1 The rightmost column of the region.
+ * @param y1 The bottom row of the region.
+ *
+ * @return None
+ */
+void Nokia5110_Invalidate_Region(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
 /**
  * @brief The Nokia5110_ClrPxl function clears the internal screen buffer pixel at position (i, j), turning it off.
  *
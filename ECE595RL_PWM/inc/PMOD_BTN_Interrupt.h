@@ -44,7 +44,7 @@
  *
  * @return None
  */
-void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
+extern void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
 
 /**
  * @brief Initialize the PMOD BTN module and set up interrupt handling.
@@ -0,0 +1,115 @@
+/**
+ * @file Servo_Angle.h
+ * @brief Header file for the Servo_Angle driver.
+ *
+ * This file contains the function definitions for the Servo_Angle driver.
+ * It converts servo angles in millidegrees to Timer A2 compare register counts, so that callers
+ * do not need to hardcode raw values such as 1700 and 7000.
+ *
+ * Timer A2 runs in up/down mode at 6 MHz (SMCLK / 2) with CCR1 and CCR2 in Toggle/Reset mode.
+ * The output is high while the counter is below the compare value, so the pulse width is (2 * CCR) / 6 MHz,
+ * or 3 counts per microsecond. For example, 1700 counts produce a 567 us pulse, and 7000 counts produce a 2333 us pulse.
+ *
+ * The endpoints of each servo are calibrated with the SERVO_n_MIN_COUNTS and SERVO_n_MAX_COUNTS macros below.
+ * The calibration is folded into a constant table at compile time: each entry holds the count at 0 degrees and
+ * a Q19 scale factor in counts per millidegree. At run time, the conversion is a table lookup, a multiply, and a shift.
+ *
+ * @note The Servo_Trajectory_Init function must be called before using the move functions of this driver.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef SERVO_ANGLE_H_
+#define SERVO_ANGLE_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Servo_Trajectory.h"
+
+// Full range of the servos, in millidegrees
+#define SERVO_ANGLE_MAX_MILLIDEGREES    180000
+
+// Number of Timer A2 counts per microsecond of pulse width
+#define SERVO_ANGLE_COUNTS_PER_US       3
+
+// Calibrated compare register values of servo 1 (P5.6) at 0 degrees and 180 degrees
+#define SERVO_1_MIN_COUNTS              1700
+#define SERVO_1_MAX_COUNTS              7000
+
+// Calibrated compare register values of servo 2 (P5.7) at 0 degrees and 180 degrees
+#define SERVO_2_MIN_COUNTS              1700
+#define SERVO_2_MAX_COUNTS              7000
+
+// Number of fractional bits of the scale factor
+#define SERVO_ANGLE_SCALE_SHIFT         19
+
+/**
+ * @brief Compute the Q19 scale factor, in counts per millidegree, of a servo at compile time.
+ *
+ * The result is rounded to the nearest value. Both the intermediate value and the product computed by
+ * Servo_Angle_To_Counts fit in 32 bits as long as the range (max_counts - min_counts) is less than 8192 counts.
+ */
+#define SERVO_ANGLE_SCALE(min_counts, max_counts) \
+    (((((uint32_t)(max_counts) - (uint32_t)(min_counts)) << SERVO_ANGLE_SCALE_SHIFT) + (SERVO_ANGLE_MAX_MILLIDEGREES / 2)) / SERVO_ANGLE_MAX_MILLIDEGREES)
+
+/**
+ * @brief Calibration of a single servo.
+ */
+typedef struct
+{
+    uint16_t min_counts;
+    uint16_t max_counts;
+    uint32_t scale;
+} Servo_Angle_Calibration;
+
+/**
+ * @brief Convert an angle in millidegrees to a Timer A2 compare register value.
+ *
+ * The angle is limited to SERVO_ANGLE_MAX_MILLIDEGREES. The conversion error is less than 1 count (0.33 us)
+ * over the full range. This function does not use division, so it can be called from an interrupt service routine.
+ *
+ * @param servo The servo whose calibration is used.
+ * @param millidegrees The angle, from 0 to SERVO_ANGLE_MAX_MILLIDEGREES.
+ *
+ * @return The compare register value, in counts.
+ */
+uint16_t Servo_Angle_To_Counts(Servo_Trajectory_ID servo, uint32_t millidegrees);
+
+/**
+ * @brief Return the calibration table entry of a servo.
+ *
+ * @param servo The servo whose calibration is returned.
+ *
+ * @return A pointer to the constant calibration entry.
+ */
+const Servo_Angle_Calibration *Servo_Angle_Get_Calibration(Servo_Trajectory_ID servo);
+
+/**
+ * @brief Start moving a servo to an angle without blocking.
+ *
+ * This function converts the angle with Servo_Angle_To_Counts and calls Servo_Trajectory_Move,
+ * so the move follows the velocity and acceleration limits of the servo.
+ *
+ * @param servo The servo to move.
+ * @param millidegrees The target angle, from 0 to SERVO_ANGLE_MAX_MILLIDEGREES.
+ *
+ * @return None
+ */
+void Servo_Angle_Move(Servo_Trajectory_ID servo, uint32_t millidegrees);
+
+/**
+ * @brief Move a servo to an angle and wait until it arrives.
+ *
+ * This function converts the angle with Servo_Angle_To_Counts and calls Servo_Trajectory_Move_Blocking.
+ *
+ * @param servo The servo to move.
+ * @param millidegrees The target angle, from 0 to SERVO_ANGLE_MAX_MILLIDEGREES.
+ *
+ * @note This function must not be called from an interrupt service routine.
+ *
+ * @return None
+ */
+void Servo_Angle_Move_Blocking(Servo_Trajectory_ID servo, uint32_t millidegrees);
+
+#endif /* SERVO_ANGLE_H_ */
@@ -0,0 +1,123 @@
+/**
+ * @file Servo_Mux.h
+ * @brief Header file for the Servo_Mux driver.
+ *
+ * This file contains the function definitions for the Servo_Mux driver.
+ * It uses Timer A3 to drive up to SERVO_MUX_NUM_CHANNELS servos from general-purpose output pins
+ * by generating their pulses one after another within each 20 ms frame.
+ *
+ * The frame is divided into SERVO_MUX_NUM_CHANNELS slots. Timer A3 runs in continuous mode at 12 MHz (SMCLK),
+ * and CCR0 marks the start of each slot. At the start of a slot, TA3_0_IRQHandler sets the output pin of
+ * the channel and schedules the end of its pulse on CCR1. Then, TA3_N_IRQHandler clears the output pin.
+ * Since the compare registers are always advanced from the previous compare value instead of the time at which
+ * the interrupt was handled, interrupt latency does not accumulate from one slot to the next.
+ *
+ * The pins are driven by software, so each edge is delayed by the interrupt latency. The latency is bounded
+ * by the execution time of the interrupt service routines with a higher or equal priority (PORT4_IRQHandler at
+ * priority 0, and TA0_0_IRQHandler at priority 1). The driver measures the latency of each edge by reading
+ * the timer counter right after writing the pin, and it records the minimum and maximum latency and the
+ * maximum pulse width error of each channel.
+ *
+ * The output pins are listed in the Servo_Mux_Pins table in Servo_Mux.c. By default, channels 0 to 7 use P7.0 to P7.7.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef SERVO_MUX_H_
+#define SERVO_MUX_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+
+// Set to 1 to initialize the multiplexed servo outputs in the main program
+#define SERVO_MUX_ENABLED               0
+
+// Number of servo channels. Each channel gets a slot of (20 ms / SERVO_MUX_NUM_CHANNELS).
+#define SERVO_MUX_NUM_CHANNELS          8
+
+// Number of Timer A3 counts per microsecond (SMCLK = 12 MHz)
+#define SERVO_MUX_COUNTS_PER_US         12
+
+// Length of one frame, in microseconds
+#define SERVO_MUX_FRAME_US              20000
+
+// Length of one slot, in counts. It must be less than 65536.
+#define SERVO_MUX_SLOT_COUNTS           ((SERVO_MUX_FRAME_US / SERVO_MUX_NUM_CHANNELS) * SERVO_MUX_COUNTS_PER_US)
+
+// Time between the end of the longest pulse and the start of the next slot, in counts (50 us)
+#define SERVO_MUX_GUARD_COUNTS          (50 * SERVO_MUX_COUNTS_PER_US)
+
+// Longest pulse that can be generated, in counts
+#define SERVO_MUX_MAX_PULSE_COUNTS      (SERVO_MUX_SLOT_COUNTS - SERVO_MUX_GUARD_COUNTS)
+
+/**
+ * @brief Timing statistics of a single channel, in Timer A3 counts.
+ */
+typedef struct
+{
+    uint32_t pulse_count;
+    uint16_t min_latency;
+    uint16_t max_latency;
+    uint16_t max_width_error;
+} Servo_Mux_Stats;
+
+/**
+ * @brief Initialize the Servo_Mux driver.
+ *
+ * This function configures the output pins of all channels as GPIO outputs that are driven low,
+ * and it disables all channels. Then, it configures Timer A3 in continuous mode with SMCLK (12 MHz),
+ * enables the CCR0 interrupt, and enables TA3_0 (IRQ 14) and TA3_N (IRQ 15) in the NVIC with priority 1.
+ *
+ * @note The Clock_Init48MHz function should be called before using this function.
+ *
+ * @return None
+ */
+void Servo_Mux_Init(void);
+
+/**
+ * @brief Set the pulse width of a channel, in Timer A3 counts.
+ *
+ * The new pulse width is used starting from the next slot of the channel. A pulse width of 0 disables the channel,
+ * so its pin stays low. Otherwise, the pulse width is limited to SERVO_MUX_MAX_PULSE_COUNTS.
+ *
+ * @param channel The channel, from 0 to SERVO_MUX_NUM_CHANNELS - 1.
+ * @param pulse_counts The pulse width, in counts.
+ *
+ * @return None
+ */
+void Servo_Mux_Set_Pulse(uint8_t channel, uint16_t pulse_counts);
+
+/**
+ * @brief Set the pulse width of a channel, in microseconds.
+ *
+ * @param channel The channel, from 0 to SERVO_MUX_NUM_CHANNELS - 1.
+ * @param pulse_us The pulse width, in microseconds. A value of 0 disables the channel.
+ *
+ * @return None
+ */
+void Servo_Mux_Set_Pulse_Us(uint8_t channel, uint16_t pulse_us);
+
+/**
+ * @brief Return the timing statistics of a channel.
+ *
+ * The latency is the time from the compare event to the write of the output pin. The width error is the
+ * absolute difference between the measured and the requested pulse width, so the maximum width error is
+ * the worst-case jitter of the pulse.
+ *
+ * @param channel The channel, from 0 to SERVO_MUX_NUM_CHANNELS - 1.
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void Servo_Mux_Get_Stats(uint8_t channel, Servo_Mux_Stats *stats);
+
+/**
+ * @brief Clear the timing statistics of all channels.
+ *
+ * @return None
+ */
+void Servo_Mux_Reset_Stats(void);
+
+#endif /* SERVO_MUX_H_ */
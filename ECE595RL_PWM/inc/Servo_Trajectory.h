@@ -0,0 +1,134 @@
+/**
+ * @file Servo_Trajectory.h
+ * @brief Header file for the Servo_Trajectory driver.
+ *
+ * This file contains the function definitions for the Servo_Trajectory driver.
+ * It moves the two servos connected to Timer A2 (P5.6 and P5.7) along a trapezoidal velocity profile
+ * instead of jumping the compare registers directly to the target value.
+ *
+ * The trajectory is advanced once per 20 ms PWM frame by the Timer A2 CCR0 interrupt (TA2_0_IRQHandler).
+ * On each frame, the velocity of each servo is increased by at most the maximum acceleration until it reaches
+ * the maximum velocity, and it is decreased again when the remaining distance is smaller than the stopping distance.
+ * The new position is then written to CCR1 or CCR2 with Timer_A2_Update_Duty_Cycle_1 and Timer_A2_Update_Duty_Cycle_2.
+ *
+ * Positions are expressed in Timer A2 compare register counts (the same values that are passed to
+ * Timer_A2_Update_Duty_Cycle_1). Velocities are expressed in counts per frame, and accelerations are expressed
+ * in counts per frame squared. Internally, the position and velocity are stored in Q8 fixed-point format
+ * (8 fractional bits), so no floating-point work is done in the interrupt service routine.
+ *
+ * @note The Timer_A2_PWM_Init function must be called before using this driver.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef SERVO_TRAJECTORY_H_
+#define SERVO_TRAJECTORY_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/Timer_A2_PWM.h"
+
+// Default maximum velocity, in counts per frame.
+// A full sweep from 1700 to 7000 takes approximately 0.6 seconds.
+#define SERVO_TRAJECTORY_DEFAULT_MAX_VELOCITY       200
+
+// Default maximum acceleration, in counts per frame squared.
+// The servo reaches the default maximum velocity after 10 frames (200 ms).
+#define SERVO_TRAJECTORY_DEFAULT_MAX_ACCELERATION   20
+
+// Upper limit of the maximum velocity, in counts per frame.
+// It keeps the square of the velocity in Q8 format within 32 bits.
+#define SERVO_TRAJECTORY_VELOCITY_LIMIT             255
+
+/**
+ * @brief Identifiers for the servos driven by Timer A2.
+ */
+typedef enum
+{
+    SERVO_TRAJECTORY_SERVO_1 = 0,   // CCR1, P5.6
+    SERVO_TRAJECTORY_SERVO_2,       // CCR2, P5.7
+    SERVO_TRAJECTORY_NUM_SERVOS
+} Servo_Trajectory_ID;
+
+/**
+ * @brief Initialize the Servo_Trajectory driver.
+ *
+ * This function sets the current position of both servos, writes them to CCR1 and CCR2, and loads the default
+ * maximum velocity and acceleration. Then, it registers the trajectory update with Timer_A2_PWM_Set_Period_Task,
+ * which enables the Timer A2 CCR0 interrupt.
+ *
+ * @param initial_position_1 The initial position of servo 1, in counts.
+ * @param initial_position_2 The initial position of servo 2, in counts.
+ *
+ * @note The servos are commanded to the initial positions directly, without a trajectory, since their
+ *       actual positions are unknown at power-up.
+ *
+ * @return None
+ */
+void Servo_Trajectory_Init(uint16_t initial_position_1, uint16_t initial_position_2);
+
+/**
+ * @brief Set the maximum velocity and acceleration of a servo.
+ *
+ * The maximum velocity is limited to SERVO_TRAJECTORY_VELOCITY_LIMIT, and both values are limited to at least 1.
+ * The new limits are applied on the next frame, including to a move that is already in progress.
+ *
+ * @param servo The servo to configure.
+ * @param max_velocity The maximum velocity, in counts per frame.
+ * @param max_acceleration The maximum acceleration, in counts per frame squared.
+ *
+ * @return None
+ */
+void Servo_Trajectory_Set_Limits(Servo_Trajectory_ID servo, uint16_t max_velocity, uint16_t max_acceleration);
+
+/**
+ * @brief Start moving a servo to a target position without blocking.
+ *
+ * This function only updates the target position and returns immediately. If the servo is already moving,
+ * the trajectory continues from its current position and velocity, so the servo decelerates smoothly before
+ * reversing direction. This function can be called from an interrupt service routine.
+ *
+ * @param servo The servo to move.
+ * @param target_position The target position, in counts. It must be less than the Timer A2 period.
+ *
+ * @return None
+ */
+void Servo_Trajectory_Move(Servo_Trajectory_ID servo, uint16_t target_position);
+
+/**
+ * @brief Move a servo to a target position and wait until it arrives.
+ *
+ * This function calls Servo_Trajectory_Move, then puts the processor to sleep with WaitForInterrupt
+ * until the trajectory is completed.
+ *
+ * @param servo The servo to move.
+ * @param target_position The target position, in counts. It must be less than the Timer A2 period.
+ *
+ * @note This function must not be called from an interrupt service routine with a priority that is equal to
+ *       or higher than the Timer A2 CCR0 interrupt, since the trajectory would never be updated.
+ *
+ * @return None
+ */
+void Servo_Trajectory_Move_Blocking(Servo_Trajectory_ID servo, uint16_t target_position);
+
+/**
+ * @brief Check whether a servo has reached its target position.
+ *
+ * @param servo The servo to check.
+ *
+ * @return 1 if the servo is at its target position and stopped, 0 otherwise.
+ */
+uint8_t Servo_Trajectory_Is_Done(Servo_Trajectory_ID servo);
+
+/**
+ * @brief Return the position that was last written to the compare register of a servo.
+ *
+ * @param servo The servo to read.
+ *
+ * @return The current position, in counts.
+ */
+uint16_t Servo_Trajectory_Get_Position(Servo_Trajectory_ID servo);
+
+#endif /* SERVO_TRAJECTORY_H_ */
@@ -0,0 +1,172 @@
+/**
+ * @file Task_Scheduler.h
+ * @brief Header file for the Task_Scheduler driver.
+ *
+ * This file contains the function definitions for the Task_Scheduler driver.
+ * It uses the Timer_A1_Interrupt driver to generate a periodic tick, and it runs multiple
+ * user-defined tasks from the TA1_0 interrupt. Each task has its own period and phase offset,
+ * both expressed in ticks. By default, the tick rate is 1 kHz, so a task with a period of 10
+ * runs at 100 Hz.
+ *
+ * The phase offset delays the first execution of a task. It can be used to spread tasks with
+ * the same period across different ticks (for example, a 100 Hz telemetry task with a phase of 5
+ * runs halfway between two 100 Hz control tasks with a phase of 0).
+ *
+ * For each task, the scheduler records the number of executions and the execution time in clock
+ * cycles using the Cycle_Counter driver. A task overrun is counted when the execution time of a
+ * task is longer than its period. A scheduler overrun is counted when the next tick is already
+ * pending after all of the due tasks have been executed.
+ *
+ * When TASK_SCHEDULER_TICKLESS is set to 1, the scheduler does not interrupt the CPU on every tick.
+ * After the due tasks have been executed, it computes the number of ticks until the next task is due,
+ * and it reprograms the Timer A1 period (CCR0) so that the next interrupt occurs at that deadline.
+ * If the tasks ran past that deadline, the period is extended to the next tick boundary ahead of the counter
+ * instead, and a scheduler overrun is counted, so the tick count and the sleep time stay consistent.
+ * The main loop can then call Task_Scheduler_Idle, which puts the CPU to sleep with WaitForInterrupt
+ * until the next interrupt. The fraction of time spent sleeping is reported by Task_Scheduler_Get_Sleep_Permille.
+ *
+ * @note The tasks are executed in interrupt context at the priority of Timer A1 (priority 2).
+ *       Cycle_Counter_Init must be called before Task_Scheduler_Init.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef TASK_SCHEDULER_H_
+#define TASK_SCHEDULER_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Cycle_Counter.h"
+#include "../inc/Timer_A1_Interrupt.h"
+
+// The maximum number of tasks that can be registered
+#define TASK_SCHEDULER_MAX_TASKS 8
+
+// The tick rate of the scheduler in Hz
+#define TASK_SCHEDULER_TICK_HZ 1000
+
+// The number of Timer A1 clock cycles per tick
+// Timer A1 is clocked at 12 MHz / 4 / 6 = 500 kHz, so 500 cycles result in a 1 ms tick
+#define TASK_SCHEDULER_CCR0_VALUE 500
+
+// Set to 1 to skip the ticks on which no task is due. Set to 0 to interrupt the CPU on every tick.
+#define TASK_SCHEDULER_TICKLESS 1
+
+// The maximum number of ticks between two interrupts in tickless mode
+// The Timer A1 period register is 16 bits wide, so (TASK_SCHEDULER_MAX_IDLE_TICKS * TASK_SCHEDULER_CCR0_VALUE) must not exceed 65536
+#define TASK_SCHEDULER_MAX_IDLE_TICKS 128
+
+/**
+ * @brief Execution statistics of a single task.
+ */
+typedef struct
+{
+    uint32_t run_count;
+    uint32_t overrun_count;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint32_t mean_cycles;
+} Task_Scheduler_Stats;
+
+/**
+ * @brief Initialize the task scheduler.
+ *
+ * This function removes all registered tasks, clears the statistics, and starts Timer A1
+ * to generate a periodic interrupt at TASK_SCHEDULER_TICK_HZ.
+ *
+ * @return None
+ */
+void Task_Scheduler_Init(void);
+
+/**
+ * @brief Register a periodic task.
+ *
+ * The task is executed every period_ticks ticks. Its first execution occurs phase_ticks ticks
+ * after the next tick.
+ *
+ * @note In tickless mode, a task registered after the tasks have started running is first considered
+ *       when the interrupt that is already scheduled occurs.
+ *
+ * @param task Pointer to the user-defined task function.
+ * @param period_ticks The period of the task, in ticks. It must be greater than 0.
+ * @param phase_ticks The phase offset of the task, in ticks.
+ *
+ * @return The ID of the task (0 to TASK_SCHEDULER_MAX_TASKS - 1), or -1 if the task could not be registered.
+ */
+int8_t Task_Scheduler_Add(void(*task)(void), uint16_t period_ticks, uint16_t phase_ticks);
+
+/**
+ * @brief Put the CPU to sleep until the next interrupt.
+ *
+ * This function should be called repeatedly from the main loop. It disables interrupts, reads the time,
+ * and executes WaitForInterrupt. The CPU wakes up when any interrupt becomes pending (usually the next
+ * scheduler deadline). The time spent sleeping is added to the sleep statistics before interrupts are
+ * enabled again, and then the pending interrupt service routine runs.
+ *
+ * @return None
+ */
+void Task_Scheduler_Idle(void);
+
+/**
+ * @brief Return the fraction of time spent sleeping in Task_Scheduler_Idle since Task_Scheduler_Init was called.
+ *
+ * @return The sleep ratio in parts per thousand (0 to 1000).
+ */
+uint32_t Task_Scheduler_Get_Sleep_Permille(void);
+
+/**
+ * @brief Change the period of a registered task.
+ *
+ * The new period takes effect after the next execution of the task.
+ *
+ * @param task_id The ID returned by Task_Scheduler_Add.
+ * @param period_ticks The new period of the task, in ticks. It must be greater than 0.
+ *
+ * @return None
+ */
+void Task_Scheduler_Set_Period(int8_t task_id, uint16_t period_ticks);
+
+/**
+ * @brief Return the number of ticks elapsed since Task_Scheduler_Init was called.
+ *
+ * @return The tick count.
+ */
+uint32_t Task_Scheduler_Get_Ticks(void);
+
+/**
+ * @brief Return the number of ticks that were still being processed when the next tick became pending.
+ *
+ * @return The scheduler overrun count.
+ */
+uint32_t Task_Scheduler_Get_Overrun_Count(void);
+
+/**
+ * @brief Return the number of registered tasks.
+ *
+ * @return The number of registered tasks.
+ */
+uint8_t Task_Scheduler_Get_Num_Tasks(void);
+
+/**
+ * @brief Get the execution statistics of a registered task.
+ *
+ * @param task_id The ID returned by Task_Scheduler_Add.
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void Task_Scheduler_Get_Stats(int8_t task_id, Task_Scheduler_Stats *stats);
+
+/**
+ * @brief Execute the tasks that are due on the current tick.
+ *
+ * This function is registered as the Timer A1 task by Task_Scheduler_Init, so it is called from TA1_0_IRQHandler.
+ *
+ * @return None
+ */
+void Task_Scheduler_Tick(void);
+
+#endif /* TASK_SCHEDULER_H_ */
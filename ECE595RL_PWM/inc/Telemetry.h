@@ -0,0 +1,108 @@
+/**
+ * @file Telemetry.h
+ * @brief Header file for the Telemetry driver.
+ *
+ * This file contains the function definitions for the Telemetry driver.
+ * It periodically takes a snapshot of the motor, servo, bumper, LED, and scheduler state, packs it into a
+ * fixed-format binary frame, and transmits the frame over EUSCI_A0 with the uDMA controller (EUSCI_A0_UART_Write_DMA).
+ * The CPU only fills the frame and computes its checksum. The bytes are moved to the UART by DMA channel 0.
+ *
+ * Frame format (all multi-byte fields are little-endian):
+ *
+ *      Offset      Size        Field               Description
+ *      ------      ----        -----               -----------
+ *      0           1           Sync                TELEMETRY_SYNC
+ *      1           1           Length              TELEMETRY_PAYLOAD_SIZE
+ *      2           2           Sequence            Incremented for each frame, so skipped frames can be detected on the host
+ *      4           4           Timestamp           Task_Scheduler_Get_Ticks (ms)
+ *      8           2           Left duty cycle     Timer A0 CCR4 (P2.7), in counts of the 15000-count PWM period
+ *      10          2           Right duty cycle    Timer A0 CCR3 (P2.6)
+ *      12          1           Motor pins          Bit 4: left backward (P5.4), bit 5: right backward (P5.5),
+ *                                                  bit 6: right enable (P3.6), bit 7: left enable (P3.7)
+ *      13          1           Bumpers             Bumper_Read (bit n is set while BUMP_n is pressed)
+ *      14          2           Servo 1             Timer A2 CCR1, in counts of the 60000-count PWM period
+ *      16          2           Servo 2             Timer A2 CCR2
+ *      18          1           LaunchPad LEDs      Bit 0: LED1 (P1.0), bits 1-3: LED2 red, green, and blue (P2.0-P2.2)
+ *      19          1           Chassis LEDs        P8 output (bits 0 and 5: front yellow LEDs, bits 6 and 7: back red LEDs)
+ *      20          2           Sleep               Task_Scheduler_Get_Sleep_Permille
+ *      22          4           Overruns            Task_Scheduler_Get_Overrun_Count
+ *      26          2           Skipped frames      Number of frames skipped because the previous frame was still being sent
+ *      28          2           CRC                 CRC-16/CCITT-FALSE (see CRC16.h) of the Length field through the Skipped frames field
+ *
+ * A frame is only sent after the bytes already queued by printf, Binary_Log, and Command_Protocol, so it never
+ * splits their messages. At 115200 baud, a 30-byte frame at 100 Hz uses about a quarter of the bandwidth of the link.
+ * The baud rate can be raised with EUSCI_A0_UART_Set_Baud_Rate for higher frame rates.
+ *
+ * tools/telemetry_decode.py extracts the frames from the serial stream and writes them to a CSV file.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Bumper_Sensors.h"
+#include "../inc/CRC16.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Task_Scheduler.h"
+
+// Set to 1 to stream the telemetry frames in the main program
+#define TELEMETRY_ENABLED           0
+
+// First byte of a telemetry frame
+#define TELEMETRY_SYNC              0xA7
+
+// Number of bytes between the Length field and the CRC
+#define TELEMETRY_PAYLOAD_SIZE      26
+
+// Total number of bytes in a frame, including the sync, length, and CRC fields
+#define TELEMETRY_FRAME_SIZE        (TELEMETRY_PAYLOAD_SIZE + 4)
+
+// Default period between two frames, in scheduler ticks (100 Hz)
+#define TELEMETRY_DEFAULT_PERIOD    10
+
+/**
+ * @brief Transmit statistics of the Telemetry driver.
+ */
+typedef struct
+{
+    uint32_t frame_count;
+    uint32_t skipped_count;
+} Telemetry_Stats;
+
+/**
+ * @brief Initialize the Telemetry driver and register its task with the task scheduler.
+ *
+ * The frames are sent from the first execution of the task, TELEMETRY_DEFAULT_PERIOD ticks apart unless
+ * Telemetry_Set_Period is called.
+ *
+ * @note EUSCI_A0_UART_Init, DMA_Init, and Task_Scheduler_Init must be called first.
+ *
+ * @param phase_ticks The phase offset of the task, in ticks, so that it does not share a tick with other tasks.
+ *
+ * @return 1 on success, or 0 if the task could not be registered.
+ */
+uint8_t Telemetry_Init(uint16_t phase_ticks);
+
+/**
+ * @brief Change the period between two frames.
+ *
+ * @param period_ticks The new period in scheduler ticks, or 0 to stop sending frames.
+ *
+ * @return None
+ */
+void Telemetry_Set_Period(uint16_t period_ticks);
+
+/**
+ * @brief Return the transmit statistics.
+ *
+ * @param stats Pointer to the structure that will hold the statistics.
+ *
+ * @return None
+ */
+void Telemetry_Get_Stats(Telemetry_Stats *stats);
+
+#endif /* TELEMETRY_H_ */
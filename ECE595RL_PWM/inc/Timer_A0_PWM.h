@@ -8,6 +8,10 @@
  *
  * @note The Motor driver uses Timer_A0_PWM as a base driver.
  *
+ * The duty cycles of both channels can be committed together with Timer_A0_PWM_Commit. The new values are
+ * latched by the CCR0 interrupt (TA0_0_IRQHandler) at the top of the up/down period, where both outputs are low,
+ * so both channels switch to the new values in the same PWM period.
+ *
  * @author Aaron Nanas
  *
  */
@@ -17,6 +21,7 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/CortexM.h"
 
 /**
  * @brief Initialize Timer A0 for PWM signal generation.
@@ -64,4 +69,49 @@ void Timer_A0_Update_Duty_Cycle_1(uint16_t duty_cycle_1);
  */
 void Timer_A0_Update_Duty_Cycle_2(uint16_t duty_cycle_2);
 
+/**
+ * @brief Register a task that is executed when a commit is latched.
+ *
+ * The task is called from TA0_0_IRQHandler at the period boundary, right before the new duty cycle values
+ * are written to CCR3 and CCR4. It can be used to update other outputs (such as the motor direction pins)
+ * in the same PWM period as the duty cycles.
+ *
+ * @param task A pointer to the user-defined task function, or 0 to remove it.
+ *
+ * @return None
+ */
+void Timer_A0_PWM_Set_Commit_Task(void(*task)(void));
+
+/**
+ * @brief Commit new duty cycle values for CCR3 and CCR4 of Timer A0 at the next period boundary.
+ *
+ * This function stores the new duty cycle values and enables the CCR0 interrupt. At the top of the next
+ * up/down period, TA0_0_IRQHandler executes the commit task (if any), writes both values, and disables
+ * the CCR0 interrupt again. If a commit is already pending, it is replaced by the new one.
+ * It immediately returns if either duty cycle value is greater than or equal to the configured PWM period.
+ * In that case, a commit that is already pending is left unchanged.
+ *
+ * It is safe to call this function from an interrupt service routine.
+ *
+ * @param duty_cycle_1 The new duty cycle value for CCR3, in timer ticks.
+ * @param duty_cycle_2 The new duty cycle value for CCR4, in timer ticks.
+ *
+ * @return 1 if the duty cycles were committed, or 0 if either value is out of range.
+ */
+uint8_t Timer_A0_PWM_Commit(uint16_t duty_cycle_1, uint16_t duty_cycle_2);
+
+/**
+ * @brief Discard the pending commit, if any.
+ *
+ * @return None
+ */
+void Timer_A0_PWM_Cancel_Commit(void);
+
+/**
+ * @brief Check whether a commit is waiting for the next period boundary.
+ *
+ * @return 1 if a commit is pending. Otherwise, 0.
+ */
+uint8_t Timer_A0_PWM_Commit_Pending(void);
+
 #endif /* TIMER_A0_PWM_H_ */
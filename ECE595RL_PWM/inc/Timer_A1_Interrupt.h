@@ -17,7 +17,7 @@
 
 #define TIMER_A1_INT_CCR0_VALUE 50000
 
-void (*Timer_A1_Task)(void);
+extern void (*Timer_A1_Task)(void);
 
 /**
  * @brief Initialize Timer A1 for periodic interrupt generation.
@@ -47,4 +47,19 @@ void Timer_A2_Update_Duty_Cycle_1(uint16_t duty_cycle_1);
  */
 void Timer_A2_Update_Duty_Cycle_2(uint16_t duty_cycle_2);
 
+/**
+ * @brief Register a task that is executed once per PWM period.
+ *
+ * This function enables the CCR0 interrupt of Timer A2 (IRQ 12, priority 2). In up/down mode, the interrupt
+ * occurs when the counter reaches the top of the period, where both PWM outputs are low. The task is called
+ * from TA2_0_IRQHandler, so new duty cycle values written by the task take effect at the start of the next pulse.
+ *
+ * @param task A pointer to the user-defined task function, or 0 to disable the CCR0 interrupt.
+ *
+ * @note The Timer_A2_PWM_Init function should be called before using this function.
+ *
+ * @return None
+ */
+void Timer_A2_PWM_Set_Period_Task(void(*task)(void));
+
 #endif /* TIMER_A2_PWM_H_ */
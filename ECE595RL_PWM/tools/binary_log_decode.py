@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+@file binary_log_decode.py
+@brief Host-side decoder for the Binary_Log driver.
+
+Reads the ".log_fmt" section from the executable (.out) built by Code Composer Studio
+to map each format ID back to its format string. Then, it reads the binary log
+records from a serial port or a capture file and prints them as text.
+
+A record is only accepted when its CRC is valid and its format ID is the address of a
+format string of the executable. Otherwise, the sync byte was found in the middle of
+console text or of another frame: one byte is dropped, and the decoder resynchronizes
+on the next sync byte. The rejected candidates are counted and reported at the end.
+
+Usage:
+    python3 binary_log_decode.py Debug/PWM.out /dev/ttyACM0
+    python3 binary_log_decode.py Debug/PWM.out capture.bin --clock 48000000
+
+Reading from a serial port requires pyserial (pip install pyserial).
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC_BYTE = 0xA5
+MAX_ARGS = 4
+
+# Sync byte, number of arguments, format ID, timestamp, and CRC
+FRAME_OVERHEAD = 12
+
+
+def read_format_strings(elf_path, section_name=".log_fmt"):
+    """Return a dictionary that maps the address of each format string to the string."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        raise ValueError("%s is not a 32-bit little-endian ELF file" % elf_path)
+
+    e_shoff, = struct.unpack_from("<I", elf, 0x20)
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def section_header(index):
+        # sh_name, sh_type, sh_flags, sh_addr, sh_offset, sh_size
+        return struct.unpack_from("<IIIIII", elf, e_shoff + index * e_shentsize)
+
+    names_offset = section_header(e_shstrndx)[4]
+    for index in range(e_shnum):
+        sh_name, _, _, sh_addr, sh_offset, sh_size = section_header(index)
+        name_end = elf.index(b"\0", names_offset + sh_name)
+        if elf[names_offset + sh_name:name_end].decode() != section_name:
+            continue
+
+        formats = {}
+        data = elf[sh_offset:sh_offset + sh_size]
+        start = 0
+        while start < len(data):
+            end = data.find(b"\0", start)
+            if end < 0:
+                end = len(data)
+            if end > start:
+                formats[sh_addr + start] = data[start:end].decode(errors="replace")
+            # Skip the terminator and any alignment padding
+            start = end + 1
+            while start < len(data) and data[start] == 0:
+                start += 1
+        return formats
+
+    raise ValueError("section %s not found in %s" % (section_name, elf_path))
+
+
+def crc16(data, crc=0xFFFF):
+    """Return the CRC-16/CCITT-FALSE checksum of the bytes."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def format_message(fmt, args):
+    """Apply a printf-style format string to a list of 32-bit arguments."""
+    # Python's % operator does not understand C length modifiers
+    fmt = re.sub(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|t)?([diouxXcsfeEgG%])", r"%\1\2", fmt)
+    values = []
+    arg_index = 0
+    for conversion in re.findall(r"%[-+ #0]*\d*(?:\.\d+)?([diouxXcsfeEgG%])", fmt):
+        if conversion == "%":
+            continue
+        value = args[arg_index] if arg_index < len(args) else 0
+        arg_index += 1
+        if conversion in "di" and value >= 0x80000000:
+            value -= 0x100000000
+        elif conversion in "feEgG":
+            value = struct.unpack("<f", struct.pack("<I", value))[0]
+        elif conversion == "s":
+            value = "<0x%08X>" % value
+        values.append(value)
+    return fmt % tuple(values)
+
+
+def read_records(stream, formats, counters):
+    """Yield (format ID, timestamp, arguments) for each valid record found in the byte stream."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            return
+        buffer.extend(chunk)
+        while True:
+            start = buffer.find(bytes([SYNC_BYTE]))
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 2:
+                break
+            num_args = buffer[1]
+            if num_args > MAX_ARGS:
+                # Not a record header, so resynchronize on the next sync byte
+                del buffer[0]
+                continue
+            frame_size = FRAME_OVERHEAD + 4 * num_args
+            if len(buffer) < frame_size:
+                break
+            crc, = struct.unpack_from("<H", buffer, frame_size - 2)
+            if crc != crc16(buffer[1:frame_size - 2]):
+                counters["crc_errors"] += 1
+                del buffer[0]
+                continue
+            fmt_id, timestamp = struct.unpack_from("<II", buffer, 2)
+            if fmt_id not in formats:
+                counters["unknown_formats"] += 1
+                del buffer[0]
+                continue
+            args = list(struct.unpack_from("<%dI" % num_args, buffer, 10))
+            del buffer[:frame_size]
+            yield fmt_id, timestamp, args
+
+
+def open_input(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        return serial.Serial(path, baud, timeout=None)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Binary_Log records into text")
+    parser.add_argument("elf", help="executable (.out) that produced the log")
+    parser.add_argument("input", help="serial port or capture file")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate (default: 115200)")
+    parser.add_argument("--clock", type=float, default=48e6, help="CPU clock in Hz used for timestamps (default: 48 MHz)")
+    args = parser.parse_args()
+
+    formats = read_format_strings(args.elf)
+    counters = {"records": 0, "crc_errors": 0, "unknown_formats": 0}
+    try:
+        with open_input(args.input, args.baud) as stream:
+            for fmt_id, timestamp, values in read_records(stream, formats, counters):
+                text = format_message(formats[fmt_id], values)
+                sys.stdout.write("[%12.6f] %s" % (timestamp / args.clock, text if text.endswith("\n") else text + "\n"))
+                sys.stdout.flush()
+                counters["records"] += 1
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sys.stderr.write("%d records, %d CRC errors, %d unknown format IDs\n"
+                         % (counters["records"], counters["crc_errors"], counters["unknown_formats"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+@file bmp_to_nokia.py
+@brief Host-side converter from Windows BMP files to Nokia5110_Image data.
+
+Reads an uncompressed BMP (1, 4, 8, 24, or 32 bits per pixel), applies a brightness
+threshold to each pixel, and prints C source code that defines a Nokia5110_Image
+in the bank-major 1 bit per pixel layout of the Nokia 5110 screen buffer.
+The output can be drawn with Nokia5110_Draw_Image (see inc/Nokia5110_Image.h).
+
+With --rle, the data is compressed with the run-length encoding that is decoded by
+Nokia5110_Draw_Image. The raw data is kept if it is not larger than the RLE data.
+
+Usage:
+    python3 bmp_to_nokia.py logo.bmp --name Logo > logo_image.c
+    python3 bmp_to_nokia.py ship.bmp --name Ship --rle --threshold 7 --invert
+"""
+
+import argparse
+import struct
+import sys
+
+IMAGE_RAW = 0
+IMAGE_RLE = 1
+MAX_PACKET_LENGTH = 128
+
+
+def read_bmp(path):
+    """Return (width, height, rows), where rows[y][x] is the brightness of the pixel from 0 to 255, top row first."""
+    with open(path, "rb") as f:
+        bmp = f.read()
+
+    if bmp[:2] != b"BM":
+        raise ValueError("%s is not a BMP file" % path)
+
+    data_offset, = struct.unpack_from("<I", bmp, 10)
+    header_size, width, height, _, bits_per_pixel, compression = struct.unpack_from("<IiiHHI", bmp, 14)
+    if compression not in (0, 3) or bits_per_pixel not in (1, 4, 8, 24, 32):
+        raise ValueError("%s: only uncompressed 1, 4, 8, 24, and 32-bit BMP files are supported" % path)
+
+    # Rows are stored from the bottom up unless the height is negative
+    top_down = height < 0
+    height = abs(height)
+
+    palette = []
+    if bits_per_pixel <= 8:
+        palette_offset = 14 + header_size
+        num_colors = (data_offset - palette_offset) // 4
+        for index in range(num_colors):
+            blue, green, red, _ = struct.unpack_from("<BBBB", bmp, palette_offset + 4 * index)
+            palette.append((red, green, blue))
+
+    # Each row is padded to a multiple of 4 bytes
+    row_size = ((width * bits_per_pixel + 31) // 32) * 4
+
+    rows = []
+    for y in range(height):
+        row_offset = data_offset + row_size * (y if top_down else (height - 1 - y))
+        row = []
+        for x in range(width):
+            if bits_per_pixel >= 24:
+                blue, green, red = struct.unpack_from("<BBB", bmp, row_offset + x * (bits_per_pixel // 8))
+            else:
+                bit_offset = x * bits_per_pixel
+                byte = bmp[row_offset + bit_offset // 8]
+                index = (byte >> (8 - bits_per_pixel - bit_offset % 8)) & ((1 << bits_per_pixel) - 1)
+                red, green, blue = palette[index] if index < len(palette) else (0, 0, 0)
+            row.append((299 * red + 587 * green + 114 * blue) // 1000)
+        rows.append(row)
+    return width, height, rows
+
+
+def to_bank_major(width, height, rows, threshold, invert):
+    """Return the image as ((height + 7) / 8) banks of width bytes, with the top row of each bank in bit 0."""
+    data = bytearray()
+    for bank in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = 8 * bank + bit
+                if y < height and ((rows[y][x] > threshold) != invert):
+                    byte |= 1 << bit
+            data.append(byte)
+    return bytes(data)
+
+
+def rle_encode(data):
+    """Compress the data into repeated packets (header bit 7 set) and literal packets."""
+    output = bytearray()
+    literals = bytearray()
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:MAX_PACKET_LENGTH]
+            output.append(len(chunk) - 1)
+            output.extend(chunk)
+            del literals[:MAX_PACKET_LENGTH]
+
+    index = 0
+    while index < len(data):
+        run = 1
+        while index + run < len(data) and data[index + run] == data[index] and run < MAX_PACKET_LENGTH:
+            run += 1
+        # A repeated packet of 2 bytes only pays off if it does not split a literal packet
+        if run >= 3 or (run == 2 and not literals):
+            flush_literals()
+            output.append(0x80 | (run - 1))
+            output.append(data[index])
+        else:
+            literals.extend(data[index:index + run])
+        index += run
+    flush_literals()
+    return bytes(output)
+
+
+def rle_decode(data, size):
+    """Decode RLE data in the same way as Nokia5110_Draw_Image, to check the encoder."""
+    output = bytearray()
+    index = 0
+    while len(output) < size:
+        header = data[index]
+        length = (header & 0x7F) + 1
+        if header & 0x80:
+            output.extend(bytes([data[index + 1]]) * length)
+            index += 2
+        else:
+            output.extend(data[index + 1:index + 1 + length])
+            index += 1 + length
+    return bytes(output[:size])
+
+
+def print_source(name, width, height, encoding, data, source_path, out):
+    out.write("// Generated by bmp_to_nokia.py from %s\n" % source_path)
+    out.write("// %dx%d pixels, %s, %d bytes\n" % (width, height, "RLE" if encoding == IMAGE_RLE else "raw", len(data)))
+    out.write('#include "../inc/Nokia5110_Image.h"\n\n')
+    out.write("static const uint8_t %s_Data[%d] =\n{\n" % (name, len(data)))
+    for start in range(0, len(data), 16):
+        out.write("    " + ", ".join("0x%02X" % b for b in data[start:start + 16]) + ",\n")
+    out.write("};\n\n")
+    out.write("const Nokia5110_Image %s =\n{\n" % name)
+    out.write("    %d, %d, %s, %d, %s_Data\n" % (width, height,
+              "NOKIA5110_IMAGE_RLE" if encoding == IMAGE_RLE else "NOKIA5110_IMAGE_RAW", len(data), name))
+    out.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a BMP file into a Nokia5110_Image")
+    parser.add_argument("bmp", help="input BMP file")
+    parser.add_argument("--name", default="Image", help="name of the Nokia5110_Image variable (default: Image)")
+    parser.add_argument("--threshold", type=int, default=127,
+                        help="pixels brighter than this value (0 to 255) are turned on (default: 127)")
+    parser.add_argument("--invert", action="store_true", help="turn on the pixels that are not brighter than the threshold")
+    parser.add_argument("--rle", action="store_true", help="compress the data with run-length encoding when it is smaller")
+    args = parser.parse_args()
+
+    width, height, rows = read_bmp(args.bmp)
+    if width > 255 or height > 255:
+        raise ValueError("%s: the image must be at most 255x255 pixels" % args.bmp)
+
+    data = to_bank_major(width, height, rows, args.threshold, args.invert)
+    encoding = IMAGE_RAW
+    if args.rle:
+        compressed = rle_encode(data)
+        assert rle_decode(compressed, len(data)) == data
+        if len(compressed) < len(data):
+            data = compressed
+            encoding = IMAGE_RLE
+
+    print_source(args.name, width, height, encoding, data, args.bmp, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,1514 @@
+/**
+ * @file Simulator.c
+ * @brief Source code for the host simulator of the MSP432P401R peripherals.
+ *
+ * This file contains the function definitions for the Simulator module. It also defines the peripheral
+ * instances declared in msp.h, the CortexM functions, and the stdio device functions declared in file.h.
+ *
+ * @note This file must be compiled without -fsanitize-coverage, since it implements __sanitizer_cov_trace_pc.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "Simulator.h"
+#include "file.h"
+#include "../../inc/CortexM.h"
+
+// The simulator opens the host files with the functions of the C library
+#undef fopen
+#undef freopen
+
+// Time of an event that never occurs
+#define SIMULATOR_NEVER                 UINT64_MAX
+
+// Execution priority of the thread mode, below all exceptions
+#define SIMULATOR_THREAD_PRIORITY       0x100
+
+// Number of capture/compare registers of each Timer A module
+#define SIMULATOR_TIMER_NUM_CCR         5
+
+// Size of the receive queue of each EUSCI_A module
+#define SIMULATOR_RX_QUEUE_SIZE         4096
+
+// Maximum number of devices registered with add_device
+#define SIMULATOR_MAX_DEVICES           4
+
+// Peripheral instances declared in msp.h
+Timer_A_Type Host_Timer_A[4];
+EUSCI_A_Type Host_EUSCI_A[4];
+DIO_PORT_Type Host_Port[11];
+NVIC_Type Host_NVIC;
+SCB_Type Host_SCB;
+DWT_Type Host_DWT;
+CoreDebug_Type Host_CoreDebug;
+SysTick_Type Host_SysTick;
+CS_Type Host_CS;
+PCM_Type Host_PCM;
+FLCTL_Type Host_FLCTL;
+WDT_A_Type Host_WDT_A;
+SYSCTL_Type Host_SYSCTL;
+DMA_Control_Type Host_DMA_Control;
+DMA_Channel_Type Host_DMA_Channel;
+
+// Interrupt handlers of the drivers. The handlers that are not linked are null.
+extern void SysTick_Handler(void) __attribute__((weak));
+extern void TA0_0_IRQHandler(void) __attribute__((weak));
+extern void TA0_N_IRQHandler(void) __attribute__((weak));
+extern void TA1_0_IRQHandler(void) __attribute__((weak));
+extern void TA1_N_IRQHandler(void) __attribute__((weak));
+extern void TA2_0_IRQHandler(void) __attribute__((weak));
+extern void TA2_N_IRQHandler(void) __attribute__((weak));
+extern void TA3_0_IRQHandler(void) __attribute__((weak));
+extern void TA3_N_IRQHandler(void) __attribute__((weak));
+extern void EUSCIA0_IRQHandler(void) __attribute__((weak));
+extern void EUSCIA1_IRQHandler(void) __attribute__((weak));
+extern void EUSCIA2_IRQHandler(void) __attribute__((weak));
+extern void EUSCIA3_IRQHandler(void) __attribute__((weak));
+extern void DMA_INT0_IRQHandler(void) __attribute__((weak));
+extern void PORT1_IRQHandler(void) __attribute__((weak));
+extern void PORT2_IRQHandler(void) __attribute__((weak));
+extern void PORT3_IRQHandler(void) __attribute__((weak));
+extern void PORT4_IRQHandler(void) __attribute__((weak));
+extern void PORT5_IRQHandler(void) __attribute__((weak));
+extern void PORT6_IRQHandler(void) __attribute__((weak));
+
+typedef struct
+{
+    uint8_t exception;
+    const char *name;
+    void (*handler)(void);
+} Simulator_Vector;
+
+// Exceptions of the modeled peripherals. DMA_INT0 can only be pended in software (NVIC->ISPR).
+static const Simulator_Vector Vectors[] =
+{
+    {15, "SysTick_Handler", SysTick_Handler},
+    {24, "TA0_0_IRQHandler", TA0_0_IRQHandler},
+    {25, "TA0_N_IRQHandler", TA0_N_IRQHandler},
+    {26, "TA1_0_IRQHandler", TA1_0_IRQHandler},
+    {27, "TA1_N_IRQHandler", TA1_N_IRQHandler},
+    {28, "TA2_0_IRQHandler", TA2_0_IRQHandler},
+    {29, "TA2_N_IRQHandler", TA2_N_IRQHandler},
+    {30, "TA3_0_IRQHandler", TA3_0_IRQHandler},
+    {31, "TA3_N_IRQHandler", TA3_N_IRQHandler},
+    {32, "EUSCIA0_IRQHandler", EUSCIA0_IRQHandler},
+    {33, "EUSCIA1_IRQHandler", EUSCIA1_IRQHandler},
+    {34, "EUSCIA2_IRQHandler", EUSCIA2_IRQHandler},
+    {35, "EUSCIA3_IRQHandler", EUSCIA3_IRQHandler},
+    {50, "DMA_INT0_IRQHandler", DMA_INT0_IRQHandler},
+    {51, "PORT1_IRQHandler", PORT1_IRQHandler},
+    {52, "PORT2_IRQHandler", PORT2_IRQHandler},
+    {53, "PORT3_IRQHandler", PORT3_IRQHandler},
+    {54, "PORT4_IRQHandler", PORT4_IRQHandler},
+    {55, "PORT5_IRQHandler", PORT5_IRQHandler},
+    {56, "PORT6_IRQHandler", PORT6_IRQHandler}
+};
+
+#define SIMULATOR_NUM_VECTORS   (sizeof(Vectors) / sizeof(Simulator_Vector))
+#define SIMULATOR_NUM_EXCEPTIONS (16 + SIMULATOR_NUM_IRQS)
+
+typedef struct
+{
+    Timer_A_Type shadow;            // Registers after the last update, used to detect the writes of the program
+    uint8_t running;                // 1 if the timer counts
+    uint8_t down;                   // 1 while the timer counts down in up/down mode
+    uint64_t tick_num;              // MCLK cycles per timer clock tick, as the fraction tick_num / tick_den
+    uint64_t tick_den;
+    uint64_t base_cycles;           // Time at which the timer clock was last configured
+    uint64_t ticks;                 // Number of ticks counted since base_cycles
+    uint64_t event_ticks;           // Tick at which the counter reaches the next compare value, zero, or turning point
+    uint64_t next_tick_cycles;
+    uint64_t next_event_cycles;
+} Timer_State;
+
+typedef struct
+{
+    uint16_t ctlw0;                 // CTLW0 after the last update
+    uint8_t tx_buffer;              // Byte waiting in TXBUF
+    uint8_t tx_buffer_full;
+    uint8_t tx_shift;               // Byte in the transmit shift register
+    uint8_t tx_shifting;
+    uint64_t tx_end_cycles;
+    uint8_t rx_queue[SIMULATOR_RX_QUEUE_SIZE];
+    uint16_t rx_head;
+    uint16_t rx_tail;
+    uint8_t rx_shifting;
+    uint64_t rx_end_cycles;
+    uint32_t rx_count;              // Number of bytes moved to RXBUF
+    void (*output_task)(uint8_t data);
+} EUSCI_State;
+
+typedef struct
+{
+    uint8_t driven;                 // Pins driven by the host program
+    uint8_t level;                  // Level of the driven pins
+} Port_State;
+
+typedef struct
+{
+    uint64_t cycles;
+    void (*task)(void);
+} Host_Event;
+
+typedef struct
+{
+    char name[16];
+    int dev_fd;
+    int (*dopen)(const char *path, unsigned flags, int llv_fd);
+    int (*dwrite)(int dev_fd, const char *buf, unsigned count);
+} Host_Device;
+
+// 1 once Simulator_Init has been called. The code executed before is not simulated.
+static uint8_t Initialized = 0;
+
+// Virtual time in MCLK cycles, and the times at which the peripherals must be updated
+static uint64_t Cycles = 0;
+static uint64_t Next_Update_Cycles = 0;
+static uint64_t Next_Wake_Cycles = 0;
+
+// PRIMASK, the execution priority, and the active exception (0 in thread mode)
+static uint8_t Primask = 0;
+static uint16_t Current_Priority = SIMULATOR_THREAD_PRIORITY;
+static uint8_t Active_Exception = 0;
+
+// Interrupt handlers and names, indexed by exception number
+static void (*Handlers[SIMULATOR_NUM_EXCEPTIONS])(void);
+static const char *Names[SIMULATOR_NUM_EXCEPTIONS];
+static uint32_t Exception_Counts[SIMULATOR_NUM_EXCEPTIONS];
+
+static Timer_State Timers[4];
+static EUSCI_State EUSCIs[4];
+static Port_State Ports[11];
+
+// NVIC enable and software pending bits of IRQ 0 to 63
+static uint32_t NVIC_Enabled[2];
+static uint32_t NVIC_Pending[2];
+
+// SysTick state
+static uint32_t SysTick_Ctrl = 0;
+static uint32_t SysTick_Load = 0;
+static uint32_t SysTick_Val = 0;
+static uint64_t SysTick_Base_Cycles = 0;
+static uint32_t SysTick_Base_Val = 0;
+static uint64_t SysTick_Next_Zero_Cycles = SIMULATOR_NEVER;
+static uint8_t SysTick_Pending = 0;
+
+// DWT cycle counter state
+static uint32_t Cyccnt_Shadow = 0;
+static uint64_t Cyccnt_Base_Cycles = 0;
+
+// Host events, in no particular order
+static Host_Event Events[SIMULATOR_MAX_EVENTS];
+static uint8_t Num_Events = 0;
+
+// End of the program
+static uint64_t End_Cycles = SIMULATOR_NEVER;
+static void (*End_Task)(void) = 0;
+static uint8_t Ending = 0;
+
+// Output of EUSCI_A0 by default
+static FILE *Host_Output = 0;
+
+static Host_Device Devices[SIMULATOR_MAX_DEVICES];
+static uint8_t Num_Devices = 0;
+
+// 1 once stdout has been redirected to a device. The device stream is not flushed at the end,
+// since flushing it would execute the drivers.
+static uint8_t Stdout_Redirected = 0;
+
+static void Simulator_Fatal(const char *message, const char *detail)
+{
+    if (Host_Output != 0)
+    {
+        fflush(Host_Output);
+    }
+    fprintf(stderr, "Simulator: %s%s at %.6f s\n", message, detail, (double)Cycles / SIMULATOR_MCLK_HZ);
+    _exit(1);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Timer A
+// ---------------------------------------------------------------------------------------------------------
+
+// Return the time of a tick counted from base_cycles
+static uint64_t Timer_Tick_Cycles(Timer_State *state, uint64_t ticks)
+{
+    return state->base_cycles + ((ticks * state->tick_num) + state->tick_den - 1) / state->tick_den;
+}
+
+// Return the value of TAxIV: the highest priority enabled flag among CCIFG1 to CCIFG6 and TAIFG
+static uint16_t Timer_Get_IV(Timer_A_Type *timer)
+{
+    int i;
+
+    for (i = 1; i < 7; i = i + 1)
+    {
+        if ((timer->CCTL[i] & 0x0011) == 0x0011)
+        {
+            return (uint16_t)(i * 2);
+        }
+    }
+
+    if ((timer->CTL & 0x0003) == 0x0003)
+    {
+        return 0x000E;
+    }
+
+    return 0;
+}
+
+// Return the number of ticks until the counter reaches a compare value, zero, or a turning point (at least 1)
+static uint64_t Timer_Ticks_To_Event(Timer_A_Type *timer, Timer_State *state)
+{
+    uint32_t r = timer->R;
+    uint32_t ccr;
+    uint32_t distance;
+    uint16_t mode = (timer->CTL >> 4) & 0x03;
+    int i;
+
+    if ((mode == 2) || (state->down == 0))
+    {
+        // Counting up: the next compare value above the counter, then the wrap (continuous) or CCR0
+        if ((mode != 2) && (r >= timer->CCR[0])) return 1;
+
+        distance = (mode == 2) ? (0x10000 - r) : (timer->CCR[0] - r);
+        for (i = 0; i < SIMULATOR_TIMER_NUM_CCR; i = i + 1)
+        {
+            ccr = timer->CCR[i];
+            if ((ccr > r) && ((ccr - r) < distance))
+            {
+                distance = ccr - r;
+            }
+        }
+    }
+    else
+    {
+        // Counting down in up/down mode: the next compare value below the counter, then zero
+        if (r == 0) return 1;
+
+        distance = r;
+        for (i = 1; i < SIMULATOR_TIMER_NUM_CCR; i = i + 1)
+        {
+            ccr = timer->CCR[i];
+            if ((ccr < r) && ((r - ccr) < distance))
+            {
+                distance = r - ccr;
+            }
+        }
+    }
+
+    return distance;
+}
+
+// Set CCIFGn for the compare registers equal to the counter, starting with register first
+static void Timer_Match(Timer_A_Type *timer, int first)
+{
+    int i;
+
+    for (i = first; i < SIMULATOR_TIMER_NUM_CCR; i = i + 1)
+    {
+        if (timer->R == timer->CCR[i])
+        {
+            timer->CCTL[i] |= 0x0001;
+        }
+    }
+}
+
+// Count one tick, as described in the Timer_A chapter of the MSP432P4xx Technical Reference Manual
+static void Timer_Count_Tick(Timer_A_Type *timer, Timer_State *state)
+{
+    uint16_t mode = (timer->CTL >> 4) & 0x03;
+
+    if (mode == 1)
+    {
+        // Up mode: count to CCR0, then restart from zero. A counter above CCR0 rolls to zero.
+        if (timer->R >= timer->CCR[0])
+        {
+            if (timer->R == timer->CCR[0])
+            {
+                timer->CTL |= 0x0001;
+            }
+            timer->R = 0;
+        }
+        else
+        {
+            timer->R = timer->R + 1;
+            if (timer->R == timer->CCR[0])
+            {
+                timer->CCTL[0] |= 0x0001;
+            }
+        }
+        Timer_Match(timer, 1);
+    }
+    else if (mode == 2)
+    {
+        // Continuous mode: count to 0xFFFF, then restart from zero
+        timer->R = timer->R + 1;
+        if (timer->R == 0)
+        {
+            timer->CTL |= 0x0001;
+        }
+        Timer_Match(timer, 0);
+    }
+    else if (state->down == 0)
+    {
+        // Up/down mode, counting up to CCR0
+        if (timer->R >= timer->CCR[0])
+        {
+            state->down = 1;
+            timer->R = timer->R - 1;
+        }
+        else
+        {
+            timer->R = timer->R + 1;
+            if (timer->R == timer->CCR[0])
+            {
+                timer->CCTL[0] |= 0x0001;
+            }
+        }
+        Timer_Match(timer, 1);
+    }
+    else
+    {
+        // Up/down mode, counting down to zero
+        if (timer->R == 0)
+        {
+            state->down = 0;
+            timer->R = 1;
+        }
+        else
+        {
+            timer->R = timer->R - 1;
+            if (timer->R == 0)
+            {
+                timer->CTL |= 0x0001;
+            }
+        }
+        Timer_Match(timer, 1);
+    }
+}
+
+// Return 1 if the timer is halted because CCR0 is 0 in up or up/down mode
+static uint8_t Timer_Is_Halted(Timer_A_Type *timer)
+{
+    return (timer->CCR[0] == 0) && (((timer->CTL >> 4) & 0x03) != 2);
+}
+
+// Compute the time of the next tick and of the next event
+static void Timer_Schedule(Timer_A_Type *timer, Timer_State *state)
+{
+    if ((state->running == 0) || Timer_Is_Halted(timer))
+    {
+        state->next_tick_cycles = SIMULATOR_NEVER;
+        state->next_event_cycles = SIMULATOR_NEVER;
+        return;
+    }
+
+    state->event_ticks = state->ticks + Timer_Ticks_To_Event(timer, state);
+    state->next_tick_cycles = Timer_Tick_Cycles(state, state->ticks + 1);
+    state->next_event_cycles = Timer_Tick_Cycles(state, state->event_ticks);
+}
+
+// Restart the timer clock divider at the current time with the clock configuration of CTL and EX0
+static void Timer_Configure(Timer_A_Type *timer, Timer_State *state)
+{
+    uint16_t source = (timer->CTL >> 8) & 0x03;
+    uint16_t mode = (timer->CTL >> 4) & 0x03;
+    uint64_t divider = (1 << ((timer->CTL >> 6) & 0x03)) * ((timer->EX0 & 0x07) + 1);
+
+    state->base_cycles = Cycles;
+    state->ticks = 0;
+
+    // TACLK and INCLK are not connected
+    state->running = (mode != 0) && ((source == 1) || (source == 2));
+
+    if (source == 1)
+    {
+        // ACLK: 48 MHz / 32768 Hz = 46875 / 32 cycles per tick
+        state->tick_num = (SIMULATOR_MCLK_HZ / 1024) * divider;
+        state->tick_den = SIMULATOR_ACLK_HZ / 1024;
+    }
+    else
+    {
+        state->tick_num = (SIMULATOR_MCLK_HZ / SIMULATOR_SMCLK_HZ) * divider;
+        state->tick_den = 1;
+    }
+}
+
+// Bring a timer up to the current time
+static void Timer_Advance(Timer_A_Type *timer, Timer_State *state)
+{
+    uint64_t total;
+    uint64_t count;
+
+    if (Cycles < state->next_tick_cycles) return;
+
+    total = ((Cycles - state->base_cycles) * state->tick_den) / state->tick_num;
+
+    while (state->ticks < total)
+    {
+        if (total < state->event_ticks)
+        {
+            // No event before the current time, so the counter moves in a straight line
+            count = total - state->ticks;
+            if ((((timer->CTL >> 4) & 0x03) == 3) && state->down)
+            {
+                timer->R = timer->R - (uint16_t)count;
+            }
+            else
+            {
+                timer->R = timer->R + (uint16_t)count;
+            }
+            state->ticks = total;
+        }
+        else
+        {
+            count = state->event_ticks - 1 - state->ticks;
+            if ((((timer->CTL >> 4) & 0x03) == 3) && state->down)
+            {
+                timer->R = timer->R - (uint16_t)count;
+            }
+            else
+            {
+                timer->R = timer->R + (uint16_t)count;
+            }
+            Timer_Count_Tick(timer, state);
+            state->ticks = state->event_ticks;
+            state->event_ticks = state->ticks + Timer_Ticks_To_Event(timer, state);
+        }
+    }
+
+    state->next_tick_cycles = Timer_Tick_Cycles(state, state->ticks + 1);
+    state->next_event_cycles = Timer_Tick_Cycles(state, state->event_ticks);
+    *(volatile uint16_t *)&timer->IV = Timer_Get_IV(timer);
+    memcpy(&state->shadow, timer, sizeof(Timer_A_Type));
+}
+
+// Apply the register writes of the program
+static uint8_t Timer_Sync(Timer_A_Type *timer, Timer_State *state)
+{
+    uint16_t changed;
+
+    if (memcmp(&state->shadow, timer, sizeof(Timer_A_Type)) == 0) return 0;
+
+    changed = timer->CTL ^ state->shadow.CTL;
+
+    if (timer->CTL & 0x0004)
+    {
+        // TACLR resets the counter, the clock divider, and the count direction, then clears itself
+        timer->CTL &= ~0x0004;
+        timer->R = 0;
+        state->down = 0;
+        Timer_Configure(timer, state);
+    }
+    else if ((changed & 0x03F0) || (timer->EX0 != state->shadow.EX0)
+             || ((state->shadow.CCR[0] == 0) && (timer->CCR[0] != 0)))
+    {
+        // A new clock configuration, or a timer that starts after being halted by CCR0 = 0
+        Timer_Configure(timer, state);
+    }
+
+    Timer_Schedule(timer, state);
+    *(volatile uint16_t *)&timer->IV = Timer_Get_IV(timer);
+    memcpy(&state->shadow, timer, sizeof(Timer_A_Type));
+
+    return 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// EUSCI_A
+// ---------------------------------------------------------------------------------------------------------
+
+// Return the duration of one character in MCLK cycles, from the clock source, the bit rate, and the frame format
+static uint64_t EUSCI_Frame_Cycles(EUSCI_A_Type *module)
+{
+    uint64_t clock_hz;
+    uint64_t divider_x8;
+    uint64_t bits;
+    uint16_t brs = module->MCTLW >> 8;
+    uint8_t brs_bits = 0;
+
+    clock_hz = (((module->CTLW0 >> 6) & 0x03) == 1) ? SIMULATOR_ACLK_HZ : SIMULATOR_SMCLK_HZ;
+
+    while (brs)
+    {
+        brs_bits = brs_bits + (brs & 1);
+        brs = brs >> 1;
+    }
+
+    if (module->CTLW0 & 0x0100)
+    {
+        // SPI: one bit per BRW clock cycles
+        divider_x8 = (module->BRW ? module->BRW : 1) * 8;
+        bits = 8;
+    }
+    else
+    {
+        // UART: N = 16 * UCBRx + UCBRFx in oversampling mode, or UCBRx otherwise, plus the UCBRSx modulation
+        if (module->MCTLW & 0x0001)
+        {
+            divider_x8 = ((module->BRW * 16) + ((module->MCTLW >> 4) & 0x0F)) * 8 + brs_bits;
+        }
+        else
+        {
+            divider_x8 = (module->BRW * 8) + brs_bits;
+        }
+        if (divider_x8 == 0)
+        {
+            divider_x8 = 8;
+        }
+
+        // Start bit, 7 or 8 data bits, parity bit, and 1 or 2 stop bits
+        bits = 1 + ((module->CTLW0 & 0x1000) ? 7 : 8) + ((module->CTLW0 & 0x8000) ? 1 : 0)
+               + ((module->CTLW0 & 0x0800) ? 2 : 1);
+    }
+
+    return ((bits * divider_x8 * SIMULATOR_MCLK_HZ) + (clock_hz * 8) - 1) / (clock_hz * 8);
+}
+
+// Update UCBUSY from the state of the shift registers
+static void EUSCI_Update_Busy(EUSCI_A_Type *module, EUSCI_State *state)
+{
+    if (state->tx_shifting || state->rx_shifting)
+    {
+        module->STATW |= 0x0001;
+    }
+    else
+    {
+        module->STATW &= ~0x0001;
+    }
+}
+
+// Start receiving the next queued byte
+static void EUSCI_Start_Receive(EUSCI_A_Type *module, EUSCI_State *state, uint64_t start_cycles)
+{
+    if (state->rx_shifting || (state->rx_head == state->rx_tail)) return;
+    if ((module->CTLW0 & 0x0001) || (module->CTLW0 & 0x0100)) return;
+
+    state->rx_shifting = 1;
+    state->rx_end_cycles = start_cycles + EUSCI_Frame_Cycles(module);
+}
+
+// Move a received byte to RXBUF and set RXIFG, or UCOE if the previous byte has not been read
+static void EUSCI_Receive(EUSCI_A_Type *module, EUSCI_State *state, uint8_t data)
+{
+    if (module->IFG & 0x0001)
+    {
+        module->STATW |= 0x0020;
+    }
+
+    *(volatile uint16_t *)&module->RXBUF = data;
+    module->IFG |= 0x0001;
+    state->rx_count = state->rx_count + 1;
+}
+
+// Apply the register writes of the program
+static uint8_t EUSCI_Sync(EUSCI_A_Type *module, EUSCI_State *state)
+{
+    uint8_t data;
+
+    if ((module->CTLW0 == state->ctlw0) && (module->TXBUF == 0xFFFF)) return 0;
+
+    if (module->CTLW0 != state->ctlw0)
+    {
+        if (module->CTLW0 & 0x0001)
+        {
+            // UCSWRST stops the transfers, clears the receive flags and the interrupt enables, and sets TXIFG
+            module->IE &= ~0x000F;
+            module->IFG = 0x0002;
+            module->STATW = 0;
+            state->tx_buffer_full = 0;
+            state->tx_shifting = 0;
+            state->rx_shifting = 0;
+        }
+        state->ctlw0 = module->CTLW0;
+        EUSCI_Start_Receive(module, state, Cycles);
+    }
+
+    if (module->TXBUF != 0xFFFF)
+    {
+        data = (uint8_t)module->TXBUF;
+        module->TXBUF = 0xFFFF;
+
+        if ((module->CTLW0 & 0x0001) == 0)
+        {
+            // Writing TXBUF clears TXIFG and UCTXCPTIFG. TXIFG is set again when the byte moves to the shift register.
+            module->IFG &= ~0x000A;
+            if (state->tx_shifting == 0)
+            {
+                state->tx_shift = data;
+                state->tx_shifting = 1;
+                state->tx_end_cycles = Cycles + EUSCI_Frame_Cycles(module);
+                module->IFG |= 0x0002;
+            }
+            else
+            {
+                state->tx_buffer = data;
+                state->tx_buffer_full = 1;
+            }
+        }
+    }
+
+    EUSCI_Update_Busy(module, state);
+
+    return 1;
+}
+
+// Bring an EUSCI_A module up to the current time
+static void EUSCI_Advance(EUSCI_A_Type *module, EUSCI_State *state)
+{
+    uint8_t data;
+
+    while (state->tx_shifting && (Cycles >= state->tx_end_cycles))
+    {
+        if (state->output_task != 0)
+        {
+            (*state->output_task)(state->tx_shift);
+        }
+
+        // In SPI mode, a byte is received for every byte transmitted
+        if (module->CTLW0 & 0x0100)
+        {
+            EUSCI_Receive(module, state, 0x00);
+        }
+
+        if (state->tx_buffer_full)
+        {
+            state->tx_shift = state->tx_buffer;
+            state->tx_buffer_full = 0;
+            state->tx_end_cycles = state->tx_end_cycles + EUSCI_Frame_Cycles(module);
+            module->IFG |= 0x0002;
+        }
+        else
+        {
+            state->tx_shifting = 0;
+            module->IFG |= 0x0008;
+        }
+    }
+
+    while (state->rx_shifting && (Cycles >= state->rx_end_cycles))
+    {
+        data = state->rx_queue[state->rx_tail];
+        state->rx_tail = (state->rx_tail + 1) % SIMULATOR_RX_QUEUE_SIZE;
+        state->rx_shifting = 0;
+        EUSCI_Receive(module, state, data);
+
+        // The next queued byte follows immediately
+        EUSCI_Start_Receive(module, state, state->rx_end_cycles);
+    }
+
+    EUSCI_Update_Busy(module, state);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Ports, NVIC, SysTick, DWT, and PCM
+// ---------------------------------------------------------------------------------------------------------
+
+// Compute IN from the pin configuration and the driven pins, and set IFG on the selected edges (P1 to P6)
+static void Port_Sync(int port)
+{
+    DIO_PORT_Type *regs = &Host_Port[port];
+    Port_State *state = &Ports[port];
+    uint8_t input;
+    uint8_t changed;
+
+    // Output pins read their output. Input pins read the host level, the pull resistor, or 0 when floating.
+    input = (regs->DIR & regs->OUT)
+          | (~regs->DIR & state->driven & state->level)
+          | (~regs->DIR & ~state->driven & regs->REN & regs->OUT);
+
+    changed = input ^ regs->IN;
+    if (changed == 0) return;
+
+    *(volatile uint8_t *)&regs->IN = input;
+
+    if (port < 6)
+    {
+        regs->IFG |= (changed & input & ~regs->IES) | (changed & ~input & regs->IES);
+    }
+}
+
+static void NVIC_Sync(void)
+{
+    int i;
+
+    for (i = 0; i < 2; i = i + 1)
+    {
+        // ISER and ISPR read the enable and pending bits, and a write sets the bits that are 1.
+        // ICER and ICPR read 0, and a write clears the bits that are 1.
+        if (NVIC->ISER[i] != NVIC_Enabled[i])
+        {
+            NVIC_Enabled[i] = NVIC_Enabled[i] | NVIC->ISER[i];
+        }
+        if (NVIC->ICER[i] != 0)
+        {
+            NVIC_Enabled[i] = NVIC_Enabled[i] & ~NVIC->ICER[i];
+            NVIC->ICER[i] = 0;
+        }
+        NVIC->ISER[i] = NVIC_Enabled[i];
+
+        if (NVIC->ISPR[i] != NVIC_Pending[i])
+        {
+            NVIC_Pending[i] = NVIC_Pending[i] | NVIC->ISPR[i];
+        }
+        if (NVIC->ICPR[i] != 0)
+        {
+            NVIC_Pending[i] = NVIC_Pending[i] & ~NVIC->ICPR[i];
+            NVIC->ICPR[i] = 0;
+        }
+        NVIC->ISPR[i] = NVIC_Pending[i];
+    }
+}
+
+// Compute the time at which SysTick next counts from 1 to 0
+static void SysTick_Schedule(void)
+{
+    if (((SysTick_Ctrl & 0x0001) == 0) || (SysTick_Load == 0))
+    {
+        SysTick_Next_Zero_Cycles = SIMULATOR_NEVER;
+    }
+    else if (SysTick_Base_Val == 0)
+    {
+        // The counter reloads on the next cycle
+        SysTick_Next_Zero_Cycles = SysTick_Base_Cycles + SysTick_Load + 1;
+    }
+    else
+    {
+        SysTick_Next_Zero_Cycles = SysTick_Base_Cycles + SysTick_Base_Val;
+    }
+}
+
+// Return the current value of the SysTick counter
+static uint32_t SysTick_Get_Value(void)
+{
+    uint64_t elapsed;
+
+    if (SysTick_Next_Zero_Cycles == SIMULATOR_NEVER) return SysTick_Val;
+
+    elapsed = Cycles - SysTick_Base_Cycles;
+    if (elapsed <= SysTick_Base_Val)
+    {
+        return (uint32_t)(SysTick_Base_Val - elapsed);
+    }
+
+    return (uint32_t)(SysTick_Load - ((elapsed - SysTick_Base_Val - 1) % (SysTick_Load + 1)));
+}
+
+// Restart the SysTick counter at the current time from a given value
+static void SysTick_Restart(uint32_t value)
+{
+    SysTick_Val = value;
+    SysTick_Base_Cycles = Cycles;
+    SysTick_Base_Val = value;
+    SysTick_Schedule();
+}
+
+static uint8_t SysTick_Sync(void)
+{
+    if (((SysTick->CTRL & ~0x00010000) == SysTick_Ctrl) && (SysTick->LOAD == SysTick_Load)
+        && (SysTick->VAL == SysTick_Val))
+    {
+        return 0;
+    }
+
+    if (SysTick->VAL != SysTick_Val)
+    {
+        // Writing any value clears the counter and COUNTFLAG
+        SysTick->CTRL &= ~0x00010000;
+        SysTick_Val = 0;
+    }
+    else
+    {
+        SysTick_Val = SysTick_Get_Value();
+    }
+
+    SysTick_Ctrl = SysTick->CTRL & ~0x00010000;
+    SysTick_Load = SysTick->LOAD & 0x00FFFFFF;
+    SysTick_Restart(SysTick_Val);
+    SysTick->VAL = SysTick_Val;
+
+    return 1;
+}
+
+static void SysTick_Advance(void)
+{
+    while (Cycles >= SysTick_Next_Zero_Cycles)
+    {
+        SysTick->CTRL |= 0x00010000;
+        if (SysTick_Ctrl & 0x0002)
+        {
+            SysTick_Pending = 1;
+        }
+        SysTick_Next_Zero_Cycles = SysTick_Next_Zero_Cycles + SysTick_Load + 1;
+    }
+
+    SysTick_Val = SysTick_Get_Value();
+    SysTick->VAL = SysTick_Val;
+}
+
+// Update CYCCNT, which counts MCLK cycles while TRCENA and CYCCNTENA are set
+static void DWT_Sync(void)
+{
+    if (DWT->CYCCNT != Cyccnt_Shadow)
+    {
+        Cyccnt_Base_Cycles = Cycles - DWT->CYCCNT;
+    }
+
+    if ((CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        DWT->CYCCNT = (uint32_t)(Cycles - Cyccnt_Base_Cycles);
+    }
+    else
+    {
+        Cyccnt_Base_Cycles = Cycles - DWT->CYCCNT;
+    }
+
+    Cyccnt_Shadow = DWT->CYCCNT;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Update and dispatch
+// ---------------------------------------------------------------------------------------------------------
+
+// Compute the next time at which a register changes (Next_Update_Cycles), and the next time at which
+// an interrupt flag can be set (Next_Wake_Cycles)
+static void Simulator_Schedule_Update(void)
+{
+    uint64_t next_update = SIMULATOR_NEVER;
+    uint64_t next_wake = (End_Cycles > Cycles) ? End_Cycles : SIMULATOR_NEVER;
+    int i;
+
+    for (i = 0; i < 4; i = i + 1)
+    {
+        if (Timers[i].next_tick_cycles < next_update) next_update = Timers[i].next_tick_cycles;
+        if (Timers[i].next_event_cycles < next_wake) next_wake = Timers[i].next_event_cycles;
+        if (EUSCIs[i].tx_shifting && (EUSCIs[i].tx_end_cycles < next_wake)) next_wake = EUSCIs[i].tx_end_cycles;
+        if (EUSCIs[i].rx_shifting && (EUSCIs[i].rx_end_cycles < next_wake)) next_wake = EUSCIs[i].rx_end_cycles;
+    }
+
+    if (SysTick_Next_Zero_Cycles < next_wake) next_wake = SysTick_Next_Zero_Cycles;
+
+    for (i = 0; i < Num_Events; i = i + 1)
+    {
+        if (Events[i].cycles < next_wake) next_wake = Events[i].cycles;
+    }
+
+    Next_Wake_Cycles = next_wake;
+    Next_Update_Cycles = (next_wake < next_update) ? next_wake : next_update;
+}
+
+// Apply the register writes of the program
+static void Simulator_Sync(void)
+{
+    uint8_t changed = 0;
+    int i;
+
+    for (i = 0; i < 4; i = i + 1)
+    {
+        changed = changed | Timer_Sync(&Host_Timer_A[i], &Timers[i]);
+        changed = changed | EUSCI_Sync(&Host_EUSCI_A[i], &EUSCIs[i]);
+    }
+
+    for (i = 0; i < 11; i = i + 1)
+    {
+        Port_Sync(i);
+    }
+
+    NVIC_Sync();
+    changed = changed | SysTick_Sync();
+    DWT_Sync();
+
+    // The requested core voltage level (AMR) is reached immediately (CPM)
+    PCM->CTL0 = (PCM->CTL0 & ~0x00003F00) | ((PCM->CTL0 & 0x0000000F) << 8);
+
+    if (changed)
+    {
+        Simulator_Schedule_Update();
+    }
+}
+
+// Bring the peripherals up to the current time, and run the host events that are due
+static void Simulator_Update(void)
+{
+    void (*task)(void);
+    int i;
+
+    for (i = 0; i < 4; i = i + 1)
+    {
+        Timer_Advance(&Host_Timer_A[i], &Timers[i]);
+        EUSCI_Advance(&Host_EUSCI_A[i], &EUSCIs[i]);
+    }
+
+    SysTick_Advance();
+
+    i = 0;
+    while (i < Num_Events)
+    {
+        if (Events[i].cycles <= Cycles)
+        {
+            task = Events[i].task;
+            Num_Events = Num_Events - 1;
+            Events[i] = Events[Num_Events];
+            (*task)();
+            i = 0;
+        }
+        else
+        {
+            i = i + 1;
+        }
+    }
+
+    Simulator_Sync();
+    Simulator_Schedule_Update();
+}
+
+// Return the priority of an exception (the top 3 bits)
+static uint16_t Simulator_Get_Priority(uint8_t exception)
+{
+    uint8_t irq = exception - 16;
+
+    if (exception == SIMULATOR_SYSTICK_EXCEPTION)
+    {
+        return SCB->SHP[11] & 0xE0;
+    }
+
+    return (NVIC->IP[irq >> 2] >> ((irq & 3) * 8)) & 0xE0;
+}
+
+// Return the pending exception with the highest priority above a given priority, or 0 if there is none
+static uint8_t Simulator_Get_Pending(uint16_t priority)
+{
+    uint64_t pending = 0;
+    uint16_t exception_priority;
+    uint8_t exception = 0;
+    int i;
+
+    for (i = 0; i < 4; i = i + 1)
+    {
+        if ((Host_Timer_A[i].CCTL[0] & 0x0011) == 0x0011) pending |= 1ULL << (8 + (2 * i));
+        if (Host_Timer_A[i].IV != 0) pending |= 1ULL << (9 + (2 * i));
+        if (Host_EUSCI_A[i].IE & Host_EUSCI_A[i].IFG & 0x000F) pending |= 1ULL << (16 + i);
+    }
+
+    for (i = 0; i < 6; i = i + 1)
+    {
+        if (Host_Port[i].IE & Host_Port[i].IFG) pending |= 1ULL << (35 + i);
+    }
+
+    pending = (pending | NVIC_Pending[0] | ((uint64_t)NVIC_Pending[1] << 32))
+            & (NVIC_Enabled[0] | ((uint64_t)NVIC_Enabled[1] << 32));
+
+    if (SysTick_Pending)
+    {
+        exception_priority = Simulator_Get_Priority(SIMULATOR_SYSTICK_EXCEPTION);
+        if (exception_priority < priority)
+        {
+            exception = SIMULATOR_SYSTICK_EXCEPTION;
+            priority = exception_priority;
+        }
+    }
+
+    // Among the exceptions with the same priority, the lowest exception number is taken first
+    while (pending)
+    {
+        i = __builtin_ctzll(pending);
+        pending = pending & (pending - 1);
+        exception_priority = Simulator_Get_Priority(16 + i);
+        if (exception_priority < priority)
+        {
+            exception = 16 + i;
+            priority = exception_priority;
+        }
+    }
+
+    return exception;
+}
+
+// Execute an interrupt handler
+static void Simulator_Take_Exception(uint8_t exception)
+{
+    uint16_t saved_priority = Current_Priority;
+    uint8_t saved_exception = Active_Exception;
+    uint8_t irq = exception - 16;
+    uint32_t rx_count = 0;
+    uint16_t iv = 0;
+    Timer_A_Type *timer = 0;
+    EUSCI_A_Type *module = 0;
+
+    if (Handlers[exception] == 0)
+    {
+        Simulator_Fatal("no handler is linked for the pending interrupt ",
+                        Names[exception] ? Names[exception] : "(not modeled)");
+    }
+
+    Current_Priority = Simulator_Get_Priority(exception);
+    Active_Exception = exception;
+    SCB->ICSR = (SCB->ICSR & ~0x1FF) | exception;
+    Exception_Counts[exception] = Exception_Counts[exception] + 1;
+
+    if (exception == SIMULATOR_SYSTICK_EXCEPTION)
+    {
+        SysTick_Pending = 0;
+    }
+    else
+    {
+        NVIC_Pending[irq >> 5] &= ~(1UL << (irq & 31));
+        NVIC->ISPR[irq >> 5] = NVIC_Pending[irq >> 5];
+
+        // Remember the flags that the handler clears by reading TAxIV or RXBUF
+        if ((irq >= 8) && (irq < 16) && (irq & 1))
+        {
+            timer = &Host_Timer_A[(irq - 8) / 2];
+            iv = timer->IV;
+        }
+        else if ((irq >= 16) && (irq < 20))
+        {
+            module = &Host_EUSCI_A[irq - 16];
+            rx_count = EUSCIs[irq - 16].rx_count;
+        }
+    }
+
+    Cycles = Cycles + SIMULATOR_EXCEPTION_CYCLES;
+
+    (*Handlers[exception])();
+
+    Cycles = Cycles + SIMULATOR_EXCEPTION_CYCLES;
+
+    if (iv == 0x000E)
+    {
+        timer->CTL &= ~0x0001;
+    }
+    else if (iv != 0)
+    {
+        timer->CCTL[iv / 2] &= ~0x0001;
+    }
+
+    if ((module != 0) && (EUSCIs[irq - 16].rx_count == rx_count) && (module->IFG & 0x0001))
+    {
+        module->IFG &= ~0x0001;
+        module->STATW &= ~0x007C;
+    }
+
+    Current_Priority = saved_priority;
+    Active_Exception = saved_exception;
+    SCB->ICSR = (SCB->ICSR & ~0x1FF) | saved_exception;
+
+    Simulator_Sync();
+    if (Cycles >= Next_Update_Cycles)
+    {
+        Simulator_Update();
+    }
+}
+
+// Execute the pending interrupts that can preempt the current code
+static void Simulator_Dispatch(void)
+{
+    uint8_t exception;
+
+    while (Primask == 0)
+    {
+        exception = Simulator_Get_Pending(Current_Priority);
+        if (exception == 0) break;
+        Simulator_Take_Exception(exception);
+    }
+}
+
+// Stop the program once the end time is reached in thread mode, with interrupts enabled or while sleeping
+static void Simulator_Check_End(uint8_t sleeping)
+{
+    if (Ending || (Cycles < End_Cycles) || (Active_Exception != 0)) return;
+    if ((Primask != 0) && (sleeping == 0)) return;
+
+    // The end task runs with interrupts enabled so that it can print
+    Ending = 1;
+    Primask = 0;
+    if (End_Task != 0)
+    {
+        (*End_Task)();
+    }
+
+    fflush(Host_Output);
+    fflush(stderr);
+    if (Stdout_Redirected == 0)
+    {
+        fflush(stdout);
+    }
+    _exit(0);
+}
+
+// Called by the instrumented code at the start of every basic block
+static void Simulator_Step(void)
+{
+    Simulator_Sync();
+    if (Cycles >= Next_Update_Cycles)
+    {
+        Simulator_Update();
+    }
+    Simulator_Check_End(0);
+    Simulator_Dispatch();
+}
+
+// Let time pass while the CPU executes a delay loop
+static void Simulator_Busy_Wait(uint64_t cycles)
+{
+    uint64_t end_cycles = Cycles + cycles;
+
+    while (Cycles < end_cycles)
+    {
+        if (Next_Wake_Cycles > Cycles)
+        {
+            Cycles = (Next_Wake_Cycles < end_cycles) ? Next_Wake_Cycles : end_cycles;
+        }
+        Simulator_Step();
+    }
+}
+
+void __sanitizer_cov_trace_pc(void)
+{
+    if (Initialized == 0) return;
+
+    Cycles = Cycles + SIMULATOR_CYCLES_PER_BLOCK;
+    Simulator_Step();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// CortexM functions
+// ---------------------------------------------------------------------------------------------------------
+
+void DisableInterrupts(void)
+{
+    Primask = 1;
+}
+
+void EnableInterrupts(void)
+{
+    Primask = 0;
+    Simulator_Sync();
+    Simulator_Dispatch();
+}
+
+long StartCritical(void)
+{
+    long sr = Primask;
+
+    Primask = 1;
+    return sr;
+}
+
+void EndCritical(long sr)
+{
+    Primask = sr & 1;
+    Simulator_Sync();
+    Simulator_Dispatch();
+}
+
+void WaitForInterrupt(void)
+{
+    Simulator_Sync();
+    if (Cycles >= Next_Update_Cycles)
+    {
+        Simulator_Update();
+    }
+
+    // WFI wakes up on an interrupt that can preempt the current code, even if PRIMASK is set
+    while (Simulator_Get_Pending(Current_Priority) == 0)
+    {
+        if (Next_Wake_Cycles == SIMULATOR_NEVER)
+        {
+            Simulator_Fatal("WaitForInterrupt would sleep forever", "");
+        }
+        if (Next_Wake_Cycles > Cycles)
+        {
+            Cycles = Next_Wake_Cycles;
+        }
+        Simulator_Update();
+        Simulator_Check_End(1);
+    }
+
+    Simulator_Dispatch();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// stdio devices (file.h)
+// ---------------------------------------------------------------------------------------------------------
+
+int add_device(char *name, unsigned flags,
+               int (*dopen)(const char *path, unsigned flags, int llv_fd),
+               int (*dclose)(int dev_fd),
+               int (*dread)(int dev_fd, char *buf, unsigned count),
+               int (*dwrite)(int dev_fd, const char *buf, unsigned count),
+               off_t (*dlseek)(int dev_fd, off_t offset, int origin),
+               int (*dunlink)(const char *path),
+               int (*drename)(const char *old_name, const char *new_name))
+{
+    Host_Device *device;
+
+    if ((Num_Devices >= SIMULATOR_MAX_DEVICES) || (strlen(name) >= sizeof(device->name))) return -1;
+
+    device = &Devices[Num_Devices];
+    strcpy(device->name, name);
+    device->dev_fd = -1;
+    device->dopen = dopen;
+    device->dwrite = dwrite;
+    Num_Devices = Num_Devices + 1;
+
+    return 0;
+}
+
+static ssize_t Host_Device_Write(void *cookie, const char *buf, size_t size)
+{
+    Host_Device *device = cookie;
+    size_t count = 0;
+    int written;
+
+    while (count < size)
+    {
+        written = (*device->dwrite)(device->dev_fd, buf + count, (unsigned)(size - count));
+        if (written <= 0) break;
+        count = count + written;
+    }
+
+    return count;
+}
+
+// Open a stream on the device named by the path ("name" or "name:file")
+static FILE *Host_Device_Open(const char *path, const char *mode)
+{
+    cookie_io_functions_t functions = {0, Host_Device_Write, 0, 0};
+    size_t length = strcspn(path, ":");
+    int i;
+
+    for (i = 0; i < Num_Devices; i = i + 1)
+    {
+        if ((strlen(Devices[i].name) == length) && (strncmp(Devices[i].name, path, length) == 0))
+        {
+            Devices[i].dev_fd = (*Devices[i].dopen)(path, 0, 0);
+            return fopencookie(&Devices[i], mode, functions);
+        }
+    }
+
+    return 0;
+}
+
+FILE *Host_Fopen(const char *path, const char *mode)
+{
+    FILE *stream = Host_Device_Open(path, mode);
+
+    return (stream != 0) ? stream : fopen(path, mode);
+}
+
+FILE *Host_Freopen(const char *path, const char *mode, FILE *stream)
+{
+    FILE *device_stream = Host_Device_Open(path, mode);
+
+    if (device_stream == 0) return freopen(path, mode, stream);
+
+    // The standard streams of the host are kept open, so that the simulator can still write to them
+    if (stream == stdout)
+    {
+        stdout = device_stream;
+        Stdout_Redirected = 1;
+    }
+    else if (stream == stderr)
+    {
+        stderr = device_stream;
+    }
+    else
+    {
+        fclose(stream);
+    }
+
+    return device_stream;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Host interface
+// ---------------------------------------------------------------------------------------------------------
+
+static void Simulator_Write_Host_Output(uint8_t data)
+{
+    putc(data, Host_Output);
+}
+
+void Simulator_Init(void)
+{
+    int i;
+
+    memset(Host_Timer_A, 0, sizeof(Host_Timer_A));
+    memset(Host_EUSCI_A, 0, sizeof(Host_EUSCI_A));
+    memset(Host_Port, 0, sizeof(Host_Port));
+    memset(&Host_NVIC, 0, sizeof(Host_NVIC));
+    memset(&Host_SCB, 0, sizeof(Host_SCB));
+    memset(&Host_DWT, 0, sizeof(Host_DWT));
+    memset(&Host_CoreDebug, 0, sizeof(Host_CoreDebug));
+    memset(&Host_SysTick, 0, sizeof(Host_SysTick));
+    memset(&Host_CS, 0, sizeof(Host_CS));
+    memset(&Host_PCM, 0, sizeof(Host_PCM));
+
+    memset(Timers, 0, sizeof(Timers));
+    memset(EUSCIs, 0, sizeof(EUSCIs));
+    memset(Ports, 0, sizeof(Ports));
+    memset(Exception_Counts, 0, sizeof(Exception_Counts));
+    memset(Handlers, 0, sizeof(Handlers));
+    memset(Names, 0, sizeof(Names));
+
+    Cycles = 0;
+    Primask = 0;
+    Current_Priority = SIMULATOR_THREAD_PRIORITY;
+    Active_Exception = 0;
+    NVIC_Enabled[0] = 0;
+    NVIC_Enabled[1] = 0;
+    NVIC_Pending[0] = 0;
+    NVIC_Pending[1] = 0;
+    SysTick_Ctrl = 0;
+    SysTick_Load = 0;
+    SysTick_Val = 0;
+    SysTick_Pending = 0;
+    SysTick_Restart(0);
+    Cyccnt_Shadow = 0;
+    Cyccnt_Base_Cycles = 0;
+    Num_Events = 0;
+    End_Cycles = SIMULATOR_NEVER;
+    End_Task = 0;
+    Ending = 0;
+
+    for (i = 0; i < SIMULATOR_NUM_VECTORS; i = i + 1)
+    {
+        Handlers[Vectors[i].exception] = Vectors[i].handler;
+        Names[Vectors[i].exception] = Vectors[i].name;
+    }
+
+    for (i = 0; i < 4; i = i + 1)
+    {
+        // The modules start in reset with TXIFG set. 0xFFFF in TXBUF means that no byte has been written.
+        Host_EUSCI_A[i].CTLW0 = 0x0001;
+        Host_EUSCI_A[i].IFG = 0x0002;
+        Host_EUSCI_A[i].TXBUF = 0xFFFF;
+        EUSCIs[i].ctlw0 = 0x0001;
+        Timer_Schedule(&Host_Timer_A[i], &Timers[i]);
+    }
+
+    if (Host_Output == 0)
+    {
+        Host_Output = fdopen(dup(STDOUT_FILENO), "w");
+    }
+    EUSCIs[0].output_task = &Simulator_Write_Host_Output;
+
+    Simulator_Schedule_Update();
+    Initialized = 1;
+}
+
+uint64_t Simulator_Get_Cycles(void)
+{
+    return Cycles;
+}
+
+void Simulator_Set_End(uint64_t end_cycles, void (*end_task)(void))
+{
+    End_Cycles = end_cycles;
+    End_Task = end_task;
+    Simulator_Schedule_Update();
+}
+
+uint8_t Simulator_Schedule(uint64_t cycles, void (*task)(void))
+{
+    if (Num_Events >= SIMULATOR_MAX_EVENTS) return 0;
+
+    Events[Num_Events].cycles = cycles;
+    Events[Num_Events].task = task;
+    Num_Events = Num_Events + 1;
+    Simulator_Schedule_Update();
+
+    return 1;
+}
+
+void Simulator_Run_Until(uint64_t cycles)
+{
+    while (Cycles < cycles)
+    {
+        Simulator_Sync();
+        if (Next_Wake_Cycles > Cycles)
+        {
+            Cycles = (Next_Wake_Cycles < cycles) ? Next_Wake_Cycles : cycles;
+        }
+        Simulator_Update();
+        Simulator_Check_End(1);
+        Simulator_Dispatch();
+    }
+}
+
+void Simulator_Drive_Pins(uint8_t port, uint8_t pins, uint8_t level)
+{
+    if ((port < 1) || (port > 11)) return;
+
+    Ports[port - 1].driven |= pins;
+    Ports[port - 1].level = (Ports[port - 1].level & ~pins) | (level & pins);
+    Port_Sync(port - 1);
+}
+
+void Simulator_Release_Pins(uint8_t port, uint8_t pins)
+{
+    if ((port < 1) || (port > 11)) return;
+
+    Ports[port - 1].driven &= ~pins;
+    Port_Sync(port - 1);
+}
+
+uint16_t Simulator_UART_Receive(uint8_t module, const uint8_t *data, uint16_t length)
+{
+    EUSCI_State *state;
+    uint16_t next;
+    uint16_t count = 0;
+
+    if (module > 3) return 0;
+
+    state = &EUSCIs[module];
+    while (count < length)
+    {
+        next = (state->rx_head + 1) % SIMULATOR_RX_QUEUE_SIZE;
+        if (next == state->rx_tail) break;
+        state->rx_queue[state->rx_head] = data[count];
+        state->rx_head = next;
+        count = count + 1;
+    }
+
+    EUSCI_Start_Receive(&Host_EUSCI_A[module], state, Cycles);
+    EUSCI_Update_Busy(&Host_EUSCI_A[module], state);
+    Simulator_Schedule_Update();
+
+    return count;
+}
+
+void Simulator_Set_Output_Task(uint8_t module, void (*output_task)(uint8_t data))
+{
+    if (module > 3) return;
+
+    EUSCIs[module].output_task = output_task;
+}
+
+uint32_t Simulator_Get_Exception_Count(uint8_t exception)
+{
+    if (exception >= SIMULATOR_NUM_EXCEPTIONS) return 0;
+
+    return Exception_Counts[exception];
+}
+
+const char *Simulator_Get_Exception_Name(uint8_t exception)
+{
+    if (exception >= SIMULATOR_NUM_EXCEPTIONS) return 0;
+
+    return Names[exception];
+}
+
+void Simulator_Delay_Loop(uint32_t count)
+{
+    // Clock_Delay1ms is tuned for 48 MHz with ClockFrequency / 9162 iterations per millisecond
+    Simulator_Busy_Wait(((uint64_t)count * 9162) / 1000);
+}
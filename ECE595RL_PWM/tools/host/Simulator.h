@@ -0,0 +1,201 @@
+/**
+ * @file Simulator.h
+ * @brief Header file for the host simulator of the MSP432P401R peripherals.
+ *
+ * This file contains the function definitions for the Simulator module, which runs the drivers in PWM
+ * on a Linux host. The drivers are compiled against the stub device header in this directory (msp.h),
+ * where every peripheral is a plain structure in memory. The simulator gives those registers the
+ * behavior of the device:
+ *  - Timer A0 to A3 count in stop, up, continuous, and up/down mode from SMCLK or ACLK with the ID and
+ *    TAIDEX dividers, set CCIFG and TAIFG, and raise TAx_0_IRQHandler and TAx_N_IRQHandler.
+ *  - P1 to P10 and PJ compute IN from DIR, OUT, REN, and the pins driven by the host program.
+ *    P1 to P6 set IFG on the edge selected by IES and raise PORTx_IRQHandler.
+ *  - EUSCI_A0 to A3 shift out TXBUF at the configured bit rate (UART or SPI), receive the bytes queued
+ *    by the host program (UART), and raise EUSCIAx_IRQHandler.
+ *  - SysTick counts down from LOAD and raises SysTick_Handler.
+ *  - The NVIC enables, prioritizes, and nests the interrupts. ICSR reports the active exception.
+ *  - The DWT cycle counter returns the simulated cycle count, and the PCM reports the requested power mode.
+ *
+ * The uDMA controller, the ADC, and the Timer32 modules are not modeled.
+ *
+ * Time is virtual. The drivers are compiled with -fsanitize-coverage=trace-pc, so every executed basic block
+ * calls the simulator, which charges SIMULATOR_CYCLES_PER_BLOCK cycles of MCLK, brings the peripherals up
+ * to the new time, and dispatches the pending interrupts. WaitForInterrupt skips directly to the next
+ * peripheral event, so a program that sleeps most of the time runs much faster than real time. The cycle
+ * counts are a model of the instruction count, not a cycle-accurate emulation of the Cortex-M4F: they are
+ * reproducible on a given host compiler, so they can be compared between two versions of the drivers.
+ *
+ * The simulator also replaces the CortexM functions (PRIMASK, WaitForInterrupt) and the add_device
+ * mechanism of the TI run-time library that EUSCI_A0_UART_Init_Printf uses to redirect printf.
+ *
+ * The following simplifications are made:
+ *  - MCLK is 48 MHz, SMCLK is 12 MHz, and ACLK is 32.768 kHz, as set by Clock_Init48MHz.
+ *  - Register reads cannot be observed. The flags that the device clears on a read are cleared when the
+ *    interrupt handler returns: RXIFG and the receive error flags for EUSCIAx_IRQHandler (which reads RXBUF),
+ *    and the flag reported by TAxIV for TAx_N_IRQHandler.
+ *  - The interrupt requests are level-sensitive: an interrupt is pending while its flag and its enable bit are set.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "msp.h"
+
+// Clock frequencies of the model, in Hz
+#define SIMULATOR_MCLK_HZ               48000000
+#define SIMULATOR_SMCLK_HZ              12000000
+#define SIMULATOR_ACLK_HZ               32768
+
+// The number of MCLK cycles charged for each executed basic block of the instrumented code
+#define SIMULATOR_CYCLES_PER_BLOCK      4
+
+// The number of MCLK cycles charged for an exception entry, and for an exception return
+#define SIMULATOR_EXCEPTION_CYCLES      12
+
+// Convert a time in milliseconds to MCLK cycles
+#define SIMULATOR_MS(ms)                ((uint64_t)(ms) * (SIMULATOR_MCLK_HZ / 1000))
+
+// Exception number of SysTick, and the number of device interrupts (IRQ 0 to 63)
+#define SIMULATOR_SYSTICK_EXCEPTION     15
+#define SIMULATOR_NUM_IRQS              64
+
+// The maximum number of pending host events
+#define SIMULATOR_MAX_EVENTS            64
+
+/**
+ * @brief Reset all registers and start the virtual time at 0.
+ *
+ * EUSCI_A0 output is written to the standard output of the host by default.
+ *
+ * @return None
+ */
+void Simulator_Init(void);
+
+/**
+ * @brief Return the number of MCLK cycles elapsed since Simulator_Init was called.
+ *
+ * @return The virtual time in cycles.
+ */
+uint64_t Simulator_Get_Cycles(void);
+
+/**
+ * @brief Stop the program at a given time.
+ *
+ * When the virtual time reaches end_cycles, end_task is called, the output files are flushed, and the host
+ * process exits with status 0. This is how a program that never returns (for example, PWM_main) is stopped.
+ *
+ * @param end_cycles The virtual time at which the program is stopped, in cycles.
+ * @param end_task Pointer to a function called before exiting. It can be 0.
+ *
+ * @return None
+ */
+void Simulator_Set_End(uint64_t end_cycles, void (*end_task)(void));
+
+/**
+ * @brief Call a host function at a given virtual time.
+ *
+ * The function is called between two basic blocks of the instrumented code, as if an external device
+ * changed state at that time. It should only call the Simulator functions (for example, Simulator_Drive_Pins).
+ *
+ * @param cycles The virtual time, in cycles.
+ * @param task Pointer to the function.
+ *
+ * @return 1 if the event was scheduled, or 0 if too many events are pending.
+ */
+uint8_t Simulator_Schedule(uint64_t cycles, void (*task)(void));
+
+/**
+ * @brief Run the simulated CPU in its sleep mode until a given time.
+ *
+ * This function is called from host code that is not instrumented. The interrupts are executed as they
+ * occur, but no time passes in the host code itself.
+ *
+ * @param cycles The virtual time at which the function returns, in cycles.
+ *
+ * @return None
+ */
+void Simulator_Run_Until(uint64_t cycles);
+
+/**
+ * @brief Drive port pins from outside of the device.
+ *
+ * The driven pins that are configured as inputs read the given level, regardless of the pull resistors.
+ *
+ * @param port The port number (1 to 10), or 11 for PJ.
+ * @param pins The mask of the pins.
+ * @param level The mask of the pins that are driven high. The other pins in the mask are driven low.
+ *
+ * @return None
+ */
+void Simulator_Drive_Pins(uint8_t port, uint8_t pins, uint8_t level);
+
+/**
+ * @brief Stop driving port pins from outside of the device.
+ *
+ * The released pins that are configured as inputs follow their pull resistors again.
+ *
+ * @param port The port number (1 to 10), or 11 for PJ.
+ * @param pins The mask of the pins.
+ *
+ * @return None
+ */
+void Simulator_Release_Pins(uint8_t port, uint8_t pins);
+
+/**
+ * @brief Queue bytes on the receive line of an EUSCI_A module in UART mode.
+ *
+ * The bytes are received back to back, at the bit rate of the module, starting now.
+ *
+ * @param module The EUSCI_A module (0 to 3).
+ * @param data Pointer to the bytes.
+ * @param length The number of bytes.
+ *
+ * @return The number of bytes queued.
+ */
+uint16_t Simulator_UART_Receive(uint8_t module, const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Set the function that receives the bytes transmitted by an EUSCI_A module.
+ *
+ * @param module The EUSCI_A module (0 to 3).
+ * @param output_task Pointer to the function, or 0 to discard the bytes.
+ *
+ * @return None
+ */
+void Simulator_Set_Output_Task(uint8_t module, void (*output_task)(uint8_t data));
+
+/**
+ * @brief Return the number of times an interrupt handler was executed.
+ *
+ * @param exception The exception number: 15 for SysTick, or 16 + n for IRQ n.
+ *
+ * @return The number of executions.
+ */
+uint32_t Simulator_Get_Exception_Count(uint8_t exception);
+
+/**
+ * @brief Return the name of an interrupt handler, or 0 if it is not modeled.
+ *
+ * @param exception The exception number: 15 for SysTick, or 16 + n for IRQ n.
+ *
+ * @return The name of the handler.
+ */
+const char *Simulator_Get_Exception_Name(uint8_t exception);
+
+/**
+ * @brief Charge the cycles of the delay loop of Clock.c.
+ *
+ * Clock.c is compiled with its inline assembly replaced by a call to this function.
+ *
+ * @param count The number of iterations of the delay loop.
+ *
+ * @return None
+ */
+void Simulator_Delay_Loop(uint32_t count);
+
+#endif /* SIMULATOR_H_ */
@@ -0,0 +1,154 @@
+/**
+ * @file bench_isr.c
+ * @brief Print the ISR and task tables of the Benchmark module for a fixed run of PWM_main.c on the host.
+ *
+ * This program runs main() of PWM_main.c with the Simulator module for 20 seconds of virtual time, with
+ * a fixed script of bumper presses and console lines, then prints Benchmark_Print_ISR_Table and
+ * Benchmark_Print_Task_Table to the standard output. The UART output of the run itself is discarded.
+ *
+ * The cycle counts come from the simulator model: the DWT cycle counter returns the virtual time, which
+ * advances by SIMULATOR_CYCLES_PER_BLOCK for each basic block executed by the drivers, plus the exception
+ * entry and return. They are not the cycle counts of the device, but they are reproducible: two builds
+ * compiled by the same host compiler can be compared with a text diff tool to see how a change affects the
+ * execution time of the interrupt service routines, without the hardware.
+ *
+ * Build:
+ *     sh tools/host/build.sh
+ *
+ * Usage:
+ *     tools/host/build/bench_isr > isr_table.txt
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "Simulator.h"
+#include "../../inc/Benchmark.h"
+#include "../../inc/EUSCI_A0_UART.h"
+
+// Virtual time of the run, in milliseconds
+#define BENCH_RUN_MS        20000
+
+typedef struct
+{
+    uint32_t time_ms;
+    uint8_t pins;           // P4 pins pressed, or 0 for a console line
+    uint16_t duration_ms;
+    const char *line;
+} Bench_Step;
+
+// Presses of single and multiple bumper switches, overlapping presses during the collision sequence,
+// and console lines. The steps are sorted by time.
+static const Bench_Step Script[] =
+{
+    {1000, 0x01, 100, 0},
+    {1500, 0, 0, "stats"},
+    {2500, 0xC0, 50, 0},
+    {3000, 0x20, 20, 0},
+    {8000, 0, 0, "help"},
+    {15000, 0x0C, 300, 0},
+    {15020, 0x80, 300, 0},
+    {17000, 0, 0, "stats"}
+};
+
+#define BENCH_NUM_STEPS     (sizeof(Script) / sizeof(Bench_Step))
+
+static int Next_Step = 0;
+
+// Time at which each P4 pin is released
+static uint64_t Release_Cycles[8];
+
+// Standard output of the host, saved before PWM_main redirects stdout to EUSCI_A0
+static FILE *Bench_Output;
+
+int PWM_Main(void);
+
+// Release the P4 pins whose press has ended
+static void Bench_Release_Task(void)
+{
+    int pin;
+
+    for (pin = 0; pin < 8; pin = pin + 1)
+    {
+        if ((Release_Cycles[pin] != 0) && (Release_Cycles[pin] <= Simulator_Get_Cycles()))
+        {
+            Simulator_Release_Pins(4, 1 << pin);
+            Release_Cycles[pin] = 0;
+        }
+    }
+}
+
+// Execute the next step of the script, then schedule the one after it
+static void Bench_Step_Task(void)
+{
+    const Bench_Step *step = &Script[Next_Step];
+    uint64_t release_cycles;
+    int pin;
+
+    if (step->pins != 0)
+    {
+        // The bumper switches pull the pins low when pressed
+        release_cycles = Simulator_Get_Cycles() + SIMULATOR_MS(step->duration_ms);
+        for (pin = 0; pin < 8; pin = pin + 1)
+        {
+            if (step->pins & (1 << pin))
+            {
+                Release_Cycles[pin] = release_cycles;
+            }
+        }
+        Simulator_Drive_Pins(4, step->pins, 0x00);
+        Simulator_Schedule(release_cycles, &Bench_Release_Task);
+    }
+    else
+    {
+        Simulator_UART_Receive(0, (const uint8_t *)step->line, strlen(step->line));
+        Simulator_UART_Receive(0, (const uint8_t *)"\r", 1);
+    }
+
+    Next_Step = Next_Step + 1;
+    if (Next_Step < BENCH_NUM_STEPS)
+    {
+        Simulator_Schedule(SIMULATOR_MS(Script[Next_Step].time_ms), &Bench_Step_Task);
+    }
+}
+
+// Write the tables to the host without the carriage returns added by EUSCI_A0_UART_Write
+static void Bench_Write_Output(uint8_t data)
+{
+    if (data != '\r')
+    {
+        putc(data, Bench_Output);
+    }
+}
+
+// Print the tables at the end of the run. The interrupts keep running while they are transmitted.
+static void Bench_End_Task(void)
+{
+    // Finish sending the output of the run, which is discarded
+    EUSCI_A0_UART_Flush();
+
+    Simulator_Set_Output_Task(0, &Bench_Write_Output);
+    Benchmark_Print_ISR_Table();
+    Benchmark_Print_Task_Table();
+    EUSCI_A0_UART_Flush();
+
+    fflush(Bench_Output);
+}
+
+int main(void)
+{
+    Bench_Output = stdout;
+
+    Simulator_Init();
+    Simulator_Set_Output_Task(0, 0);
+    Simulator_Schedule(SIMULATOR_MS(Script[0].time_ms), &Bench_Step_Task);
+    Simulator_Set_End(SIMULATOR_MS(BENCH_RUN_MS), &Bench_End_Task);
+
+    PWM_Main();
+
+    // PWM_Main does not return, so the program ends after Bench_End_Task
+    return 1;
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# @file build.sh
+# @brief Build the host programs that run the drivers in PWM with the Simulator module.
+#
+# Every driver in PWM is compiled with -fsanitize-coverage=trace-pc, so that each executed basic block calls
+# the simulator (see Simulator.h), and linked with Simulator.c and the host program. main() of PWM_main.c
+# is renamed to PWM_Main, and the delay loop of Clock.c, which is written in Cortex-M assembly, is replaced
+# by a call to Simulator_Delay_Loop. The startup code, the system file, and CortexM.c are not compiled,
+# since the simulator provides the functions of CortexM.c.
+#
+# The programs are written to tools/host/build:
+#     run_pwm_main      Runs PWM_main.c for a given virtual time (see run_pwm_main.c)
+#     bench_isr         Prints the ISR and task tables of the Benchmark module for a fixed run (see bench_isr.c)
+#
+# Usage:
+#     sh tools/host/build.sh
+#
+# @author Michael Granberry
+#
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+SOURCE_DIR="$HOST_DIR/../../PWM"
+BUILD_DIR="$HOST_DIR/build"
+CFLAGS="-std=gnu99 -O2 -Wall -Werror -Wno-main -Wno-unknown-pragmas -Wno-overflow -I$HOST_DIR"
+
+mkdir -p "$BUILD_DIR/drivers" || exit 1
+objects=""
+
+for source in "$SOURCE_DIR"/*.c; do
+    name=$(basename "$source" .c)
+
+    case "$name" in
+        startup_*|system_*|CortexM) continue ;;
+        PWM_main) flags="-Dmain=PWM_Main" ;;
+        Clock) flags="-include $HOST_DIR/Simulator.h -D__asm(code)=Simulator_Delay_Loop(ulCount)" ;;
+        *) flags="" ;;
+    esac
+
+    gcc $CFLAGS -fsanitize-coverage=trace-pc $flags -c "$source" -o "$BUILD_DIR/drivers/$name.o" || exit 1
+    objects="$objects $BUILD_DIR/drivers/$name.o"
+done
+
+gcc $CFLAGS -c "$HOST_DIR/Simulator.c" -o "$BUILD_DIR/Simulator.o" || exit 1
+
+for program in run_pwm_main bench_isr; do
+    gcc $CFLAGS -o "$BUILD_DIR/$program" "$HOST_DIR/$program.c" "$BUILD_DIR/Simulator.o" $objects || exit 1
+done
+
+echo "Host programs written to $BUILD_DIR"
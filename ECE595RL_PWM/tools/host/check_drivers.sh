@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# @file check_drivers.sh
+# @brief Check that every driver in PWM compiles on a Linux host against the stub device header in this directory.
+#
+# Each source file is checked with gcc -fsyntax-only and the warnings enabled. No object code is generated,
+# since some drivers contain Cortex-M inline assembly. build.sh compiles, links, and runs the drivers with
+# the Simulator module. The script exits with a non-zero status if any file produces an error
+# or a warning. -Wno-overflow is needed for the P9/P10 writes such as "P9->SEL0 &= ~0xFF".
+#
+# Usage:
+#     sh tools/host/check_drivers.sh
+#
+# @author Michael Granberry
+#
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+SOURCE_DIR="$HOST_DIR/../../PWM"
+status=0
+
+for source in "$SOURCE_DIR"/*.c; do
+    name=$(basename "$source")
+
+    # The startup code, the system file, and the Cortex-M assembly helpers are specific to the device
+    case "$name" in
+        startup_*|system_*|CortexM.c) continue ;;
+    esac
+
+    if ! gcc -std=gnu99 -fsyntax-only -Wall -Werror -Wno-main -Wno-unknown-pragmas -Wno-overflow \
+             -I"$HOST_DIR" "$source"; then
+        status=1
+    fi
+done
+
+if [ $status -eq 0 ]; then
+    echo "All drivers compiled without warnings"
+fi
+
+exit $status
@@ -0,0 +1,39 @@
+/**
+ * @file file.h
+ * @brief Host stub of the file.h header of the TI run-time support library.
+ *
+ * It declares add_device, which EUSCI_A0_UART_Init_Printf uses to redirect printf to the UART.
+ * A host program that calls EUSCI_A0_UART_Init_Printf must define add_device (see Simulator.c).
+ *
+ * fopen and freopen are replaced by Host_Fopen and Host_Freopen, which open a stream on a registered
+ * device ("uart" or "uart:") and pass every write to its write function, as the TI library does.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef FILE_STUB_H_
+#define FILE_STUB_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+
+// Single-stream device, as defined by the TI run-time support library
+#define _SSA 0
+
+int add_device(char *name, unsigned flags,
+               int (*dopen)(const char *path, unsigned flags, int llv_fd),
+               int (*dclose)(int dev_fd),
+               int (*dread)(int dev_fd, char *buf, unsigned count),
+               int (*dwrite)(int dev_fd, const char *buf, unsigned count),
+               off_t (*dlseek)(int dev_fd, off_t offset, int origin),
+               int (*dunlink)(const char *path),
+               int (*drename)(const char *old_name, const char *new_name));
+
+FILE *Host_Fopen(const char *path, const char *mode);
+FILE *Host_Freopen(const char *path, const char *mode, FILE *stream);
+
+#define fopen   Host_Fopen
+#define freopen Host_Freopen
+
+#endif /* FILE_STUB_H_ */
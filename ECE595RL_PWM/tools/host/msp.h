@@ -0,0 +1,214 @@
+/**
+ * @file msp.h
+ * @brief Host stub of the MSP432P401R device header.
+ *
+ * This file replaces the msp.h header of the TI toolchain when the drivers are compiled on a Linux host.
+ * Each peripheral is declared as a plain structure with the register names used by the drivers, and the
+ * peripheral macros (TIMER_A0, P4, EUSCI_A0, NVIC, ...) point to variables that a host program must define.
+ * The register layout does not match the device. The behavior of the peripherals is modeled by the Simulator
+ * module (Simulator.c), which also defines the variables. A host test that does not use the simulator defines
+ * the variables it needs, and writing a register then only stores the value. It is used by check_drivers.sh,
+ * build.sh, and the host tests in this directory.
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#ifndef MSP_STUB_H_
+#define MSP_STUB_H_
+
+#include <stdint.h>
+
+#define __IO volatile
+#define __I  volatile const
+#define __O  volatile
+
+typedef struct
+{
+    __IO uint16_t CTL;
+    __IO uint16_t CCTL[7];
+    __IO uint16_t R;
+    __IO uint16_t CCR[7];
+    __IO uint16_t EX0;
+    __I  uint16_t IV;
+} Timer_A_Type;
+
+typedef struct
+{
+    __IO uint16_t CTLW0;
+    __IO uint16_t CTLW1;
+    __IO uint16_t BRW;
+    __IO uint16_t MCTLW;
+    __IO uint16_t STATW;
+    __I  uint16_t RXBUF;
+    __IO uint16_t TXBUF;
+    __IO uint16_t ABCTL;
+    __IO uint16_t IRCTL;
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV;
+} EUSCI_A_Type;
+
+typedef struct
+{
+    __I  uint8_t IN;
+    __IO uint8_t OUT;
+    __IO uint8_t DIR;
+    __IO uint8_t REN;
+    __IO uint8_t DS;
+    __IO uint8_t SEL0;
+    __IO uint8_t SEL1;
+    __IO uint8_t SELC;
+    __IO uint8_t IES;
+    __IO uint8_t IE;
+    __IO uint8_t IFG;
+    __I  uint16_t IV;
+} DIO_PORT_Type;
+
+typedef struct
+{
+    __IO uint32_t ISER[16];
+    __IO uint32_t ICER[16];
+    __IO uint32_t ISPR[16];
+    __IO uint32_t ICPR[16];
+    __IO uint32_t IABR[16];
+    __IO uint32_t IP[128];
+} NVIC_Type;
+
+typedef struct
+{
+    __IO uint32_t ICSR;
+    __IO uint32_t SCR;
+    __IO uint32_t CPACR;
+    __IO uint8_t SHP[12];
+} SCB_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+} SysTick_Type;
+
+typedef struct
+{
+    __IO uint32_t KEY;
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t CTL2;
+    __IO uint32_t CLKEN;
+    __IO uint32_t IFG;
+    __IO uint32_t CLRIFG;
+} CS_Type;
+
+typedef struct
+{
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t IFG;
+    __IO uint32_t CLRIFG;
+} PCM_Type;
+
+typedef struct
+{
+    __IO uint32_t BANK0_RDCTL;
+    __IO uint32_t BANK1_RDCTL;
+} FLCTL_Type;
+
+typedef struct
+{
+    __IO uint16_t CTL;
+} WDT_A_Type;
+
+typedef struct
+{
+    __IO uint32_t SRAM_BANKEN;
+} SYSCTL_Type;
+
+typedef struct
+{
+    __IO uint32_t CFG;
+    __IO uint32_t CTLBASE;
+    __IO uint32_t ALTCLR;
+    __IO uint32_t PRIOCLR;
+    __IO uint32_t USEBURSTCLR;
+    __IO uint32_t REQMASKCLR;
+    __IO uint32_t ENASET;
+} DMA_Control_Type;
+
+typedef struct
+{
+    __IO uint32_t CH_SRCCFG[32];
+    __IO uint32_t INT0_SRCFLG;
+    __IO uint32_t INT0_CLRFLG;
+} DMA_Channel_Type;
+
+// Peripheral instances, defined by the host program
+extern Timer_A_Type Host_Timer_A[4];
+extern EUSCI_A_Type Host_EUSCI_A[4];
+extern DIO_PORT_Type Host_Port[11];
+extern NVIC_Type Host_NVIC;
+extern SCB_Type Host_SCB;
+extern DWT_Type Host_DWT;
+extern CoreDebug_Type Host_CoreDebug;
+extern SysTick_Type Host_SysTick;
+extern CS_Type Host_CS;
+extern PCM_Type Host_PCM;
+extern FLCTL_Type Host_FLCTL;
+extern WDT_A_Type Host_WDT_A;
+extern SYSCTL_Type Host_SYSCTL;
+extern DMA_Control_Type Host_DMA_Control;
+extern DMA_Channel_Type Host_DMA_Channel;
+
+#define TIMER_A0        (&Host_Timer_A[0])
+#define TIMER_A1        (&Host_Timer_A[1])
+#define TIMER_A2        (&Host_Timer_A[2])
+#define TIMER_A3        (&Host_Timer_A[3])
+
+#define EUSCI_A0        (&Host_EUSCI_A[0])
+#define EUSCI_A1        (&Host_EUSCI_A[1])
+#define EUSCI_A2        (&Host_EUSCI_A[2])
+#define EUSCI_A3        (&Host_EUSCI_A[3])
+
+#define P1              (&Host_Port[0])
+#define P2              (&Host_Port[1])
+#define P3              (&Host_Port[2])
+#define P4              (&Host_Port[3])
+#define P5              (&Host_Port[4])
+#define P6              (&Host_Port[5])
+#define P7              (&Host_Port[6])
+#define P8              (&Host_Port[7])
+#define P9              (&Host_Port[8])
+#define P10             (&Host_Port[9])
+#define PJ              (&Host_Port[10])
+
+#define NVIC            (&Host_NVIC)
+#define SCB             (&Host_SCB)
+#define DWT             (&Host_DWT)
+#define CoreDebug       (&Host_CoreDebug)
+#define SysTick         (&Host_SysTick)
+#define CS              (&Host_CS)
+#define PCM             (&Host_PCM)
+#define FLCTL           (&Host_FLCTL)
+#define WDT_A           (&Host_WDT_A)
+#define SYSCTL          (&Host_SYSCTL)
+#define DMA_Control     (&Host_DMA_Control)
+#define DMA_Channel     (&Host_DMA_Channel)
+
+#define FLCTL_BANK0_RDCTL_WAIT_2        0x00002000
+#define FLCTL_BANK1_RDCTL_WAIT_2        0x00002000
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL)
+
+#endif /* MSP_STUB_H_ */
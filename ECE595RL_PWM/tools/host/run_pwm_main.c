@@ -0,0 +1,248 @@
+/**
+ * @file run_pwm_main.c
+ * @brief Run PWM_main.c on a Linux host with the Simulator module.
+ *
+ * This program starts main() of PWM_main.c (compiled as PWM_Main by build.sh) on the simulated device, and
+ * stops it after a given virtual time. The bytes transmitted by EUSCI_A0 (the printf output and the binary
+ * log records) are written to the standard output, or to a file. The bumper switches can be pressed and lines
+ * can be typed on the console at given times. At the end, a summary is printed to the standard error:
+ * the virtual and host run times, the number of executions of each interrupt handler, the scheduler tick
+ * count, and the state of the motor outputs.
+ *
+ * Build:
+ *     sh tools/host/build.sh
+ *
+ * Usage:
+ *     tools/host/build/run_pwm_main [-t seconds] [-b ms:bumper[:duration_ms]]... [-r ms:text]... [-o file]
+ *
+ *     -t seconds                   Virtual time at which the program is stopped (default: 60)
+ *     -b ms:bumper[:duration_ms]   Press BUMP_<bumper> (0 to 5) at the given time, for duration_ms (default: 100)
+ *     -r ms:text                   Type the text followed by a carriage return on EUSCI_A0 at the given time
+ *     -o file                      Write the EUSCI_A0 output to a file instead of the standard output
+ *
+ * Example:
+ *     tools/host/build/run_pwm_main -t 60 -b 1000:0 -b 20000:5:250 -o /tmp/uart.bin
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Simulator.h"
+#include "../../inc/Motor.h"
+#include "../../inc/Task_Scheduler.h"
+
+// Maximum number of scripted events
+#define RUN_MAX_EVENTS      256
+
+// Types of scripted events
+#define RUN_EVENT_PRESS     0
+#define RUN_EVENT_RELEASE   1
+#define RUN_EVENT_RECEIVE   2
+
+typedef struct
+{
+    uint64_t cycles;
+    uint8_t type;
+    uint8_t pins;
+    const char *text;
+} Run_Event;
+
+// P4 pins of BUMP_0 to BUMP_5, in the bit order of Bumper_Read
+static const uint8_t Bumper_Pins[6] = {0x01, 0x04, 0x08, 0x20, 0x40, 0x80};
+
+// Scripted events, sorted by time
+static Run_Event Events[RUN_MAX_EVENTS];
+static int Num_Events = 0;
+static int Next_Event = 0;
+
+static FILE *Output_File = 0;
+static struct timespec Start_Time;
+
+int PWM_Main(void);
+
+static void Usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-t seconds] [-b ms:bumper[:duration_ms]]... [-r ms:text]... [-o file]\n", program);
+    exit(2);
+}
+
+static void Add_Event(uint64_t cycles, uint8_t type, uint8_t pins, const char *text)
+{
+    if (Num_Events >= RUN_MAX_EVENTS)
+    {
+        fprintf(stderr, "Too many events\n");
+        exit(2);
+    }
+
+    Events[Num_Events].cycles = cycles;
+    Events[Num_Events].type = type;
+    Events[Num_Events].pins = pins;
+    Events[Num_Events].text = text;
+    Num_Events = Num_Events + 1;
+}
+
+static int Compare_Events(const void *a, const void *b)
+{
+    const Run_Event *event_a = a;
+    const Run_Event *event_b = b;
+
+    if (event_a->cycles < event_b->cycles) return -1;
+    if (event_a->cycles > event_b->cycles) return 1;
+    return 0;
+}
+
+// Execute the scripted events that are due, then schedule the next one
+static void Run_Events_Task(void)
+{
+    Run_Event *event;
+
+    while ((Next_Event < Num_Events) && (Events[Next_Event].cycles <= Simulator_Get_Cycles()))
+    {
+        event = &Events[Next_Event];
+
+        if (event->type == RUN_EVENT_PRESS)
+        {
+            // The bumper switches pull the pins low when pressed
+            Simulator_Drive_Pins(4, event->pins, 0x00);
+        }
+        else if (event->type == RUN_EVENT_RELEASE)
+        {
+            Simulator_Release_Pins(4, event->pins);
+        }
+        else
+        {
+            Simulator_UART_Receive(0, (const uint8_t *)event->text, strlen(event->text));
+            Simulator_UART_Receive(0, (const uint8_t *)"\r", 1);
+        }
+
+        Next_Event = Next_Event + 1;
+    }
+
+    if (Next_Event < Num_Events)
+    {
+        Simulator_Schedule(Events[Next_Event].cycles, &Run_Events_Task);
+    }
+}
+
+static void Write_Output_File(uint8_t data)
+{
+    putc(data, Output_File);
+}
+
+static void Print_Summary(void)
+{
+    struct timespec end_time;
+    double host_seconds;
+    int16_t left_duty_cycle;
+    int16_t right_duty_cycle;
+    const char *name;
+    int exception;
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    host_seconds = (end_time.tv_sec - Start_Time.tv_sec) + ((end_time.tv_nsec - Start_Time.tv_nsec) / 1e9);
+
+    if (Output_File != 0)
+    {
+        fflush(Output_File);
+    }
+
+    Motor_Get_Duty_Cycles(&left_duty_cycle, &right_duty_cycle);
+
+    fprintf(stderr, "\nVirtual time: %.3f s, host time: %.3f s\n",
+            (double)Simulator_Get_Cycles() / SIMULATOR_MCLK_HZ, host_seconds);
+
+    fprintf(stderr, "%-24s %10s\n", "Interrupt handler", "Count");
+    for (exception = 0; exception < 16 + SIMULATOR_NUM_IRQS; exception = exception + 1)
+    {
+        name = Simulator_Get_Exception_Name(exception);
+        if ((name != 0) && (Simulator_Get_Exception_Count(exception) > 0))
+        {
+            fprintf(stderr, "%-24s %10u\n", name, Simulator_Get_Exception_Count(exception));
+        }
+    }
+
+    fprintf(stderr, "Scheduler ticks: %u, overruns: %u\n",
+            Task_Scheduler_Get_Ticks(), Task_Scheduler_Get_Overrun_Count());
+    fprintf(stderr, "Motor duty cycles: left %d, right %d (TA0 CCR3 %u, CCR4 %u)\n",
+            left_duty_cycle, right_duty_cycle, TIMER_A0->CCR[3], TIMER_A0->CCR[4]);
+    fprintf(stderr, "Motor pins: P5.4/P5.5 direction %u/%u, P3.6/P3.7 enable %u/%u\n",
+            (P5->OUT >> 4) & 1, (P5->OUT >> 5) & 1, (P3->OUT >> 6) & 1, (P3->OUT >> 7) & 1);
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = 60.0;
+    unsigned long time_ms;
+    unsigned long duration_ms;
+    unsigned int bumper;
+    int offset;
+    int i;
+
+    for (i = 1; i < argc; i = i + 1)
+    {
+        if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            i = i + 1;
+            seconds = atof(argv[i]);
+        }
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+        {
+            i = i + 1;
+            duration_ms = 100;
+            if ((sscanf(argv[i], "%lu:%u:%lu", &time_ms, &bumper, &duration_ms) < 2) || (bumper > 5))
+            {
+                Usage(argv[0]);
+            }
+            Add_Event(SIMULATOR_MS(time_ms), RUN_EVENT_PRESS, Bumper_Pins[bumper], 0);
+            Add_Event(SIMULATOR_MS(time_ms + duration_ms), RUN_EVENT_RELEASE, Bumper_Pins[bumper], 0);
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+        {
+            i = i + 1;
+            if (sscanf(argv[i], "%lu:%n", &time_ms, &offset) < 1)
+            {
+                Usage(argv[0]);
+            }
+            Add_Event(SIMULATOR_MS(time_ms), RUN_EVENT_RECEIVE, 0, argv[i] + offset);
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            i = i + 1;
+            Output_File = fopen(argv[i], "wb");
+            if (Output_File == 0)
+            {
+                perror(argv[i]);
+                return 1;
+            }
+        }
+        else
+        {
+            Usage(argv[0]);
+        }
+    }
+
+    Simulator_Init();
+    if (Output_File != 0)
+    {
+        Simulator_Set_Output_Task(0, &Write_Output_File);
+    }
+
+    qsort(Events, Num_Events, sizeof(Run_Event), &Compare_Events);
+    if (Num_Events > 0)
+    {
+        Simulator_Schedule(Events[0].cycles, &Run_Events_Task);
+    }
+
+    Simulator_Set_End((uint64_t)(seconds * SIMULATOR_MCLK_HZ), &Print_Summary);
+
+    clock_gettime(CLOCK_MONOTONIC, &Start_Time);
+    PWM_Main();
+
+    // PWM_Main does not return, so the program ends in Print_Summary
+    return 1;
+}
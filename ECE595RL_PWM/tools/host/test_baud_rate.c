@@ -0,0 +1,184 @@
+/**
+ * @file test_baud_rate.c
+ * @brief Host test of EUSCI_A_UART_Compute_Baud_Rate.
+ *
+ * For each entry of Table 24-5 of the MSP432P4xx Technical Reference Manual (SLAU356, "Recommended Settings
+ * for Typical Crystals and Baud Rates"), this test computes the divider with EUSCI_A_UART_Compute_Baud_Rate
+ * and compares it with the recommended setting. The manual derives its settings by searching for the
+ * lowest bit error, while the driver follows the algorithm of the manual: it uses the oversampling mode whenever
+ * N >= 16, and it looks up UCBRSx from the fractional part of N (Table 24-4). For this reason, some settings differ.
+ * An entry passes when the registers are identical, or when the worst-case transmit bit error of the computed
+ * setting is no more than BAUD_RATE_ERROR_MARGIN percentage points above that of the recommended setting.
+ *
+ * The transmit bit error is computed as in the "Transmit Bit Timing - Error Calculation" section of the
+ * manual, over a frame of 10 bits (start bit, 8 data bits, and stop bit), with bit i of the frame lengthened
+ * by one BRCLK cycle when bit i of UCBRSx is set.
+ *
+ * Usage (from the ECE595RL_PWM directory):
+ *     gcc -std=gnu99 -Wall -I tools/host -o /tmp/test_baud_rate tools/host/test_baud_rate.c PWM/EUSCI_A_UART.c
+ *     /tmp/test_baud_rate
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../inc/EUSCI_A_UART.h"
+
+// Allowed difference between the bit error of the computed setting and that of the recommended setting
+#define BAUD_RATE_ERROR_MARGIN 0.5
+
+// Number of bits in a frame: start bit, 8 data bits, and stop bit
+#define FRAME_BITS 10
+
+typedef struct
+{
+    uint32_t clock_frequency;
+    uint32_t baud_rate;
+    uint8_t ucos16;
+    uint16_t ucbr;
+    uint8_t ucbrf;
+    uint8_t ucbrs;
+} Baud_Rate_Entry;
+
+// Table 24-5 of the MSP432P4xx Technical Reference Manual
+static const Baud_Rate_Entry Table_24_5[] =
+{
+    {   32768,   1200, 1,   1, 11, 0x25},
+    {   32768,   2400, 0,  13,  0, 0xB6},
+    {   32768,   4800, 0,   6,  0, 0xEE},
+    {   32768,   9600, 0,   3,  0, 0x92},
+    { 1000000,   9600, 1,   6,  8, 0x20},
+    { 1000000,  19200, 1,   3,  4, 0x02},
+    { 1000000,  38400, 1,   1, 10, 0x00},
+    { 1000000,  57600, 0,  17,  0, 0x4A},
+    { 1000000, 115200, 0,   8,  0, 0xD6},
+    { 1048576,   9600, 1,   6, 13, 0x22},
+    { 1048576,  19200, 1,   3,  6, 0xAD},
+    { 1048576,  57600, 0,  18,  0, 0x11},
+    { 1048576, 115200, 0,   9,  0, 0x08},
+    { 4000000,   9600, 1,  26,  0, 0xB6},
+    { 4000000,  19200, 1,  13,  0, 0x84},
+    { 4000000,  38400, 1,   6,  8, 0x20},
+    { 4000000,  57600, 1,   4,  5, 0x55},
+    { 4000000, 115200, 1,   2,  2, 0xBB},
+    { 4000000, 230400, 0,  17,  0, 0x4A},
+    { 8000000,   9600, 1,  52,  1, 0x49},
+    { 8000000,  19200, 1,  26,  0, 0xB6},
+    { 8000000,  38400, 1,  13,  0, 0x84},
+    { 8000000,  57600, 1,   8, 10, 0xF7},
+    { 8000000, 115200, 1,   4,  5, 0x55},
+    { 8000000, 230400, 1,   2,  2, 0xBB},
+    { 8000000, 460800, 0,  17,  0, 0x4A},
+    {12000000,   9600, 1,  78,  2, 0x00},
+    {12000000,  19200, 1,  39,  1, 0x00},
+    {12000000,  38400, 1,  19,  8, 0x65},
+    {12000000,  57600, 1,  13,  0, 0x25},
+    {12000000, 115200, 1,   6,  8, 0x20},
+    {12000000, 230400, 1,   3,  4, 0x02},
+    {16000000,   9600, 1, 104,  2, 0xD6},
+    {16000000,  19200, 1,  52,  1, 0x49},
+    {16000000,  38400, 1,  26,  0, 0xB6},
+    {16000000,  57600, 1,  17,  5, 0xDD},
+    {16000000, 115200, 1,   8, 10, 0xF7},
+    {16000000, 230400, 1,   4,  5, 0x55},
+    {16000000, 460800, 1,   2,  2, 0xBB}
+};
+
+// Peripheral instances used by EUSCI_A_UART.c
+SCB_Type Host_SCB;
+
+long StartCritical(void)
+{
+    return 0;
+}
+
+void EndCritical(long sr)
+{
+    (void)sr;
+}
+
+// Return the worst-case transmit bit error of a divider setting, in percent
+static double Transmit_Bit_Error(uint32_t clock_frequency, uint32_t baud_rate, uint8_t ucos16, uint16_t ucbr, uint8_t ucbrf, uint8_t ucbrs)
+{
+    double bit_time = (double)clock_frequency / (double)baud_rate;
+    double max_error = 0.0;
+    double error;
+    uint32_t cycles = 0;
+    int i;
+
+    for (i = 0; i < FRAME_BITS; i = i + 1)
+    {
+        cycles = cycles + (ucos16 ? ((16 * ucbr) + ucbrf) : ucbr) + ((ucbrs >> (i % 8)) & 0x01);
+
+        // Position of the end of bit i compared with its ideal position, in percent of a bit
+        error = ((cycles / bit_time) - (i + 1)) * 100.0;
+        if (error < 0.0) error = -error;
+        if (error > max_error) max_error = error;
+    }
+
+    return max_error;
+}
+
+int main(void)
+{
+    EUSCI_A_UART_Baud_Rate_Config config;
+    const Baud_Rate_Entry *entry;
+    uint8_t ucos16;
+    uint16_t ucbr;
+    uint8_t ucbrf;
+    uint8_t ucbrs;
+    double computed_error;
+    double table_error;
+    int num_entries = sizeof(Table_24_5) / sizeof(Baud_Rate_Entry);
+    int num_failures = 0;
+    int num_identical = 0;
+    int i;
+
+    printf("%10s %8s  %-22s %-22s %8s %8s  %s\n", "BRCLK", "Baud", "Table 24-5", "Computed", "Table %", "Comp. %", "Result");
+
+    for (i = 0; i < num_entries; i = i + 1)
+    {
+        entry = &Table_24_5[i];
+
+        if (EUSCI_A_UART_Compute_Baud_Rate(entry->clock_frequency, entry->baud_rate, &config) == 0)
+        {
+            printf("%10lu %8lu  rejected\n", (unsigned long)entry->clock_frequency, (unsigned long)entry->baud_rate);
+            num_failures = num_failures + 1;
+            continue;
+        }
+
+        ucos16 = config.mctlw & 0x01;
+        ucbr = config.brw;
+        ucbrf = (config.mctlw >> 4) & 0x0F;
+        ucbrs = config.mctlw >> 8;
+
+        table_error = Transmit_Bit_Error(entry->clock_frequency, entry->baud_rate, entry->ucos16, entry->ucbr, entry->ucbrf, entry->ucbrs);
+        computed_error = Transmit_Bit_Error(entry->clock_frequency, entry->baud_rate, ucos16, ucbr, ucbrf, ucbrs);
+
+        printf("%10lu %8lu  OS16=%u BR=%-3u F=%-2u S=%02X  OS16=%u BR=%-3u F=%-2u S=%02X %8.2f %8.2f  ",
+               (unsigned long)entry->clock_frequency, (unsigned long)entry->baud_rate,
+               entry->ucos16, entry->ucbr, entry->ucbrf, entry->ucbrs, ucos16, ucbr, ucbrf, ucbrs,
+               table_error, computed_error);
+
+        if ((ucos16 == entry->ucos16) && (ucbr == entry->ucbr) && (ucbrf == entry->ucbrf) && (ucbrs == entry->ucbrs))
+        {
+            printf("identical\n");
+            num_identical = num_identical + 1;
+        }
+        else if (computed_error <= (table_error + BAUD_RATE_ERROR_MARGIN))
+        {
+            printf("differs, error within margin\n");
+        }
+        else
+        {
+            printf("FAIL\n");
+            num_failures = num_failures + 1;
+        }
+    }
+
+    printf("%d entries, %d identical, %d failures\n", num_entries, num_identical, num_failures);
+
+    return (num_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file test_motion_sequencer.c
+ * @brief Host test of the Motion_Sequencer driver.
+ *
+ * The Motor functions are replaced by fakes that record the last command and its duty cycles, so that
+ * each call to Motion_Sequencer_Tick can be checked against the motor command that should be applied.
+ * The test covers the following cases:
+ *  - The first step is applied by Motion_Sequencer_Start, and a step advances when its duration has elapsed.
+ *  - The time that exceeds the current step is carried over to the next steps, including when a single
+ *    tick completes more than one step.
+ *  - A second call to Motion_Sequencer_Start replaces the running sequence and its done callback.
+ *  - Motion_Sequencer_Abort stops the motors without calling the done callback.
+ *  - The done callback is called once, after the motors are stopped, and it can start a new sequence.
+ *
+ * Usage (from the ECE595RL_PWM directory):
+ *     gcc -std=gnu99 -Wall -I tools/host -o /tmp/test_motion_sequencer tools/host/test_motion_sequencer.c PWM/Motion_Sequencer.c
+ *     /tmp/test_motion_sequencer
+ *
+ * @author Michael Granberry
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../inc/Motion_Sequencer.h"
+
+// Record a failure when a condition does not hold
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+// The last command applied by the fake Motor functions
+static Motion_Command Motor_Command = MOTION_STOP;
+static uint16_t Motor_Left_Duty_Cycle = 0;
+static uint16_t Motor_Right_Duty_Cycle = 0;
+static int Motor_Num_Calls = 0;
+
+// The number of calls to each done callback
+static int Done_A_Count = 0;
+static int Done_B_Count = 0;
+static int Done_Restart_Count = 0;
+
+// The command that was applied when Done_A was called
+static Motion_Command Done_A_Command = MOTION_FORWARD;
+
+static int Num_Checks = 0;
+static int Num_Failures = 0;
+
+static const Motion_Step Sequence_A[] =
+{
+    {MOTION_FORWARD,  3000, 3000, 100},
+    {MOTION_LEFT,     2000, 2000,  50},
+    {MOTION_BACKWARD, 1500, 1500, 200}
+};
+
+static const Motion_Step Sequence_B[] =
+{
+    {MOTION_RIGHT,    2500, 2500,  40},
+    {MOTION_STOP,        0,    0,  60}
+};
+
+long StartCritical(void)
+{
+    return 0;
+}
+
+void EndCritical(long sr)
+{
+    (void)sr;
+}
+
+static void Fake_Motor(Motion_Command command, uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    Motor_Command = command;
+    Motor_Left_Duty_Cycle = left_duty_cycle;
+    Motor_Right_Duty_Cycle = right_duty_cycle;
+    Motor_Num_Calls = Motor_Num_Calls + 1;
+}
+
+uint8_t Motor_Forward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    Fake_Motor(MOTION_FORWARD, left_duty_cycle, right_duty_cycle);
+    return 1;
+}
+
+uint8_t Motor_Backward(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    Fake_Motor(MOTION_BACKWARD, left_duty_cycle, right_duty_cycle);
+    return 1;
+}
+
+uint8_t Motor_Left(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    Fake_Motor(MOTION_LEFT, left_duty_cycle, right_duty_cycle);
+    return 1;
+}
+
+uint8_t Motor_Right(uint16_t left_duty_cycle, uint16_t right_duty_cycle)
+{
+    Fake_Motor(MOTION_RIGHT, left_duty_cycle, right_duty_cycle);
+    return 1;
+}
+
+void Motor_Stop()
+{
+    Fake_Motor(MOTION_STOP, 0, 0);
+}
+
+static void Done_A(void)
+{
+    Done_A_Count = Done_A_Count + 1;
+    Done_A_Command = Motor_Command;
+}
+
+static void Done_B(void)
+{
+    Done_B_Count = Done_B_Count + 1;
+}
+
+// Start Sequence_B from the done callback of Sequence_A
+static void Done_Restart(void)
+{
+    Done_Restart_Count = Done_Restart_Count + 1;
+    Motion_Sequencer_Start(Sequence_B, 2, &Done_B);
+}
+
+static void Check(int condition, const char *text, int line)
+{
+    Num_Checks = Num_Checks + 1;
+
+    if (!condition)
+    {
+        printf("FAIL line %d: %s\n", line, text);
+        Num_Failures = Num_Failures + 1;
+    }
+}
+
+static void Reset(void)
+{
+    Motion_Sequencer_Init();
+    Motor_Num_Calls = 0;
+    Done_A_Count = 0;
+    Done_B_Count = 0;
+    Done_Restart_Count = 0;
+    Done_A_Command = MOTION_FORWARD;
+}
+
+// Each step is applied when its duration has elapsed, and the excess time is carried over
+static void Test_Step_Advance(void)
+{
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+    CHECK(Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_FORWARD);
+    CHECK((Motor_Left_Duty_Cycle == 3000) && (Motor_Right_Duty_Cycle == 3000));
+
+    Motion_Sequencer_Tick(30);
+    CHECK(Motor_Command == MOTION_FORWARD);
+    CHECK(Motor_Num_Calls == 1);
+
+    // 120 ms: 20 ms into the second step, so 30 ms are left
+    Motion_Sequencer_Tick(90);
+    CHECK(Motor_Command == MOTION_LEFT);
+    CHECK((Motor_Left_Duty_Cycle == 2000) && (Motor_Right_Duty_Cycle == 2000));
+
+    Motion_Sequencer_Tick(29);
+    CHECK(Motor_Command == MOTION_LEFT);
+
+    Motion_Sequencer_Tick(1);
+    CHECK(Motor_Command == MOTION_BACKWARD);
+    CHECK(Motor_Num_Calls == 3);
+
+    Motion_Sequencer_Tick(199);
+    CHECK(Motion_Sequencer_Is_Busy());
+    CHECK(Done_A_Count == 0);
+
+    Motion_Sequencer_Tick(1);
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_STOP);
+    CHECK(Done_A_Count == 1);
+    CHECK(Done_A_Command == MOTION_STOP);
+
+    // A tick after the end has no effect
+    Motion_Sequencer_Tick(500);
+    CHECK(Done_A_Count == 1);
+    CHECK(Motor_Num_Calls == 4);
+}
+
+// A single tick that completes several steps applies each of them in order
+static void Test_Overshoot_Carry(void)
+{
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+
+    // 160 ms: the first two steps complete, and 10 ms of the third step have elapsed
+    Motion_Sequencer_Tick(160);
+    CHECK(Motor_Command == MOTION_BACKWARD);
+    CHECK(Motor_Num_Calls == 3);
+
+    Motion_Sequencer_Tick(189);
+    CHECK(Motion_Sequencer_Is_Busy());
+
+    Motion_Sequencer_Tick(1);
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Done_A_Count == 1);
+
+    // A tick longer than the whole sequence ends it and calls the done callback once
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+    Motion_Sequencer_Tick(1000);
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_STOP);
+    CHECK(Motor_Num_Calls == 4);
+    CHECK(Done_A_Count == 1);
+}
+
+// A second Start replaces the running sequence and its done callback
+static void Test_Preemption(void)
+{
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+    Motion_Sequencer_Tick(120);
+    CHECK(Motor_Command == MOTION_LEFT);
+
+    Motion_Sequencer_Start(Sequence_B, 2, &Done_B);
+    CHECK(Motor_Command == MOTION_RIGHT);
+    CHECK((Motor_Left_Duty_Cycle == 2500) && (Motor_Right_Duty_Cycle == 2500));
+
+    // The time of the first sequence is not carried over to the second one
+    Motion_Sequencer_Tick(39);
+    CHECK(Motor_Command == MOTION_RIGHT);
+
+    Motion_Sequencer_Tick(1);
+    CHECK(Motor_Command == MOTION_STOP);
+    CHECK(Motion_Sequencer_Is_Busy());
+
+    Motion_Sequencer_Tick(60);
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Done_A_Count == 0);
+    CHECK(Done_B_Count == 1);
+
+    // An empty sequence does not replace the running one
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+    Motion_Sequencer_Start(Sequence_B, 0, &Done_B);
+    CHECK(Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_FORWARD);
+    CHECK(Motor_Num_Calls == 1);
+}
+
+// Abort stops the motors without calling the done callback
+static void Test_Abort(void)
+{
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_A);
+    Motion_Sequencer_Tick(120);
+
+    Motion_Sequencer_Abort();
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_STOP);
+
+    Motion_Sequencer_Tick(1000);
+    CHECK(Done_A_Count == 0);
+    CHECK(Motor_Command == MOTION_STOP);
+    CHECK(Motor_Num_Calls == 3);
+}
+
+// The done callback can start the next sequence
+static void Test_Done_Callback_Restart(void)
+{
+    Reset();
+    Motion_Sequencer_Start(Sequence_A, 3, &Done_Restart);
+
+    Motion_Sequencer_Tick(350);
+    CHECK(Done_Restart_Count == 1);
+    CHECK(Motion_Sequencer_Is_Busy());
+    CHECK(Motor_Command == MOTION_RIGHT);
+
+    // The time left after the end of the first sequence is not carried over to the new one
+    Motion_Sequencer_Tick(39);
+    CHECK(Motor_Command == MOTION_RIGHT);
+
+    Motion_Sequencer_Tick(61);
+    CHECK(!Motion_Sequencer_Is_Busy());
+    CHECK(Done_Restart_Count == 1);
+    CHECK(Done_B_Count == 1);
+}
+
+int main(void)
+{
+    Test_Step_Advance();
+    Test_Overshoot_Carry();
+    Test_Preemption();
+    Test_Abort();
+    Test_Done_Callback_Restart();
+
+    printf("%d checks, %d failures\n", Num_Checks, Num_Failures);
+
+    return (Num_Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
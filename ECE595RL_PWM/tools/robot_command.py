@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+@file robot_command.py
+@brief Host-side client for the Command_Protocol driver.
+
+Builds command frames, sends them over the serial port, and prints the decoded reply.
+Several setpoints given to the "set" command are sent in one frame, so they are
+applied together by the robot.
+
+Setpoints:
+    left=<duty>         Left motor duty cycle in Timer A0 counts (-14999 to 14999)
+    right=<duty>        Right motor duty cycle in Timer A0 counts (-14999 to 14999)
+    angle<n>=<deg>      Target angle of servo n in degrees (millidegree resolution)
+    counts<n>=<counts>  Target pulse width of servo n in Timer A2 counts
+    period<id>=<ticks>  Period of scheduled task id in scheduler ticks
+
+Usage:
+    python3 robot_command.py /dev/ttyACM0 ping
+    python3 robot_command.py /dev/ttyACM0 set left=6000 right=-6000 angle0=90
+    python3 robot_command.py /dev/ttyACM0 state
+    python3 robot_command.py /dev/ttyACM0 stop
+
+Requires pyserial (pip install pyserial).
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC_BYTE = 0xA5
+REPLY_SYNC_BYTE = 0xA6
+MAX_PAYLOAD = 60
+
+OPCODES = {"ping": 0x01, "stop": 0x02, "set": 0x10, "state": 0x20}
+
+TARGETS = {"left": 0x00, "right": 0x01, "angle": 0x10, "counts": 0x20, "period": 0x30}
+
+STATUS = ["OK", "UNKNOWN_OPCODE", "BAD_LENGTH", "BAD_SETPOINT", "COMMIT_FAILED"]
+
+# ticks, left duty, right duty, servo positions, servo done bits, sleep permille, CRC errors
+STATE_FORMAT = "<IhhHHBHH"
+
+
+def crc16(data, crc=0xFFFF):
+    """Return the CRC-16/CCITT-FALSE checksum of the bytes."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def build_frame(opcode, payload=b""):
+    """Return a command frame with the sync byte and the checksum."""
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError("payload of %d bytes exceeds %d bytes" % (len(payload), MAX_PAYLOAD))
+    body = bytes([len(payload), opcode]) + payload
+    return bytes([SYNC_BYTE]) + body + struct.pack("<H", crc16(body))
+
+
+def parse_setpoint(text):
+    """Return the 5-byte entry of a setpoint such as "left=6000" or "angle1=45.5"."""
+    match = re.fullmatch(r"(left|right|angle|counts|period)(\d*)=(-?[\d.]+)", text)
+    if match is None:
+        raise ValueError("invalid setpoint: %s" % text)
+    name, index, value = match.groups()
+    if (name in ("left", "right")) != (index == ""):
+        raise ValueError("invalid setpoint: %s" % text)
+    target = TARGETS[name] + (int(index) if index else 0)
+    if name == "angle":
+        number = int(round(float(value) * 1000))
+    else:
+        number = int(value)
+    return struct.pack("<Bi", target, number)
+
+
+def read_reply(stream, opcode):
+    """Return the status and the data of the reply to the opcode, or None after a timeout."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            return None
+        buffer.extend(chunk)
+        start = buffer.find(bytes([REPLY_SYNC_BYTE]))
+        if start < 0:
+            # Console text and Binary_Log records are skipped
+            buffer.clear()
+            continue
+        del buffer[:start]
+        if len(buffer) < 2:
+            continue
+        length = buffer[1]
+        if length > MAX_PAYLOAD:
+            del buffer[0]
+            continue
+        frame_size = 5 + length
+        if len(buffer) < frame_size:
+            continue
+        body = bytes(buffer[1:3 + length])
+        crc, = struct.unpack_from("<H", buffer, 3 + length)
+        if crc != crc16(body) or body[1] != (opcode | 0x80) or length == 0:
+            del buffer[0]
+            continue
+        return body[2], body[3:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Send a command frame to the robot and print the reply")
+    parser.add_argument("port", help="serial port")
+    parser.add_argument("command", choices=sorted(OPCODES), help="command to send")
+    parser.add_argument("setpoints", nargs="*", help="setpoints of the set command, such as left=6000")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate (default: 115200)")
+    parser.add_argument("--timeout", type=float, default=1.0, help="reply timeout in seconds (default: 1)")
+    args = parser.parse_args()
+
+    if (args.command == "set") != (len(args.setpoints) > 0):
+        parser.error("setpoints are required by the set command and only by the set command")
+
+    opcode = OPCODES[args.command]
+    payload = b"".join(parse_setpoint(text) for text in args.setpoints)
+
+    import serial
+    with serial.Serial(args.port, args.baud, timeout=args.timeout) as stream:
+        stream.reset_input_buffer()
+        stream.write(build_frame(opcode, payload))
+        reply = read_reply(stream, opcode)
+
+    if reply is None:
+        sys.exit("no reply")
+
+    status, data = reply
+    print("Status: %s" % (STATUS[status] if status < len(STATUS) else "0x%02X" % status))
+
+    if args.command == "ping" and len(data) >= 1:
+        print("Version: %d" % data[0])
+    elif args.command == "state" and len(data) >= struct.calcsize(STATE_FORMAT):
+        ticks, left, right, servo0, servo1, done, sleep, crc_errors = struct.unpack_from(STATE_FORMAT, data)
+        print("Ticks: %d" % ticks)
+        print("Motors: left %d, right %d" % (left, right))
+        print("Servos: %d%s, %d%s" % (servo0, "" if done & 1 else " (moving)", servo1, "" if done & 2 else " (moving)"))
+        print("Sleep: %d permille" % sleep)
+        print("CRC errors: %d" % crc_errors)
+
+    sys.exit(0 if status == 0 else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+@file telemetry_decode.py
+@brief Host-side decoder for the Telemetry driver.
+
+Reads the telemetry frames from a serial port or a capture file and writes one CSV row per frame.
+Bytes that do not belong to a valid frame (console text, Binary_Log records, command replies)
+are skipped. Frames with a bad CRC are counted and discarded.
+
+Usage:
+    python3 telemetry_decode.py /dev/ttyACM0 telemetry.csv
+    python3 telemetry_decode.py capture.bin telemetry.csv
+    python3 telemetry_decode.py /dev/ttyACM0 - --baud 460800
+
+Reading from a serial port requires pyserial (pip install pyserial).
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC_BYTE = 0xA7
+PAYLOAD_SIZE = 26
+FRAME_SIZE = PAYLOAD_SIZE + 4
+
+# Sequence, timestamp, left duty, right duty, motor pins, bumpers, servo 1, servo 2,
+# LaunchPad LEDs, chassis LEDs, sleep, overruns, skipped frames
+PAYLOAD_FORMAT = "<HIHHBBHHBBHIH"
+
+COLUMNS = [
+    "sequence", "timestamp_ms",
+    "left_duty", "right_duty", "left_backward", "right_backward", "right_enable", "left_enable",
+    "bumpers", "servo_1", "servo_2",
+    "led1", "led2_red", "led2_green", "led2_blue", "chassis_leds",
+    "sleep_permille", "overruns", "skipped",
+]
+
+
+def crc16(data, crc=0xFFFF):
+    """Return the CRC-16/CCITT-FALSE checksum of the bytes."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def decode_payload(payload):
+    """Return the CSV row of a frame payload."""
+    (sequence, timestamp, left_duty, right_duty, motor_pins, bumpers, servo_1, servo_2,
+     leds, chassis_leds, sleep, overruns, skipped) = struct.unpack(PAYLOAD_FORMAT, payload)
+    return [
+        sequence, timestamp,
+        left_duty, right_duty,
+        (motor_pins >> 4) & 1, (motor_pins >> 5) & 1, (motor_pins >> 6) & 1, (motor_pins >> 7) & 1,
+        "0x%02X" % bumpers, servo_1, servo_2,
+        leds & 1, (leds >> 1) & 1, (leds >> 2) & 1, (leds >> 3) & 1, "0x%02X" % chassis_leds,
+        sleep, overruns, skipped,
+    ]
+
+
+def read_frames(stream, counters):
+    """Yield the payload of each valid frame found in the byte stream."""
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            return
+        buffer.extend(chunk)
+        while True:
+            start = buffer.find(bytes([SYNC_BYTE]))
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 2:
+                break
+            if buffer[1] != PAYLOAD_SIZE:
+                # Not a frame header, so resynchronize on the next sync byte
+                del buffer[0]
+                continue
+            if len(buffer) < FRAME_SIZE:
+                break
+            crc, = struct.unpack_from("<H", buffer, FRAME_SIZE - 2)
+            if crc != crc16(buffer[1:FRAME_SIZE - 2]):
+                counters["crc_errors"] += 1
+                del buffer[0]
+                continue
+            payload = bytes(buffer[2:FRAME_SIZE - 2])
+            del buffer[:FRAME_SIZE]
+            yield payload
+
+
+def open_input(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        return serial.Serial(path, baud, timeout=None)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Telemetry frames into CSV")
+    parser.add_argument("input", help="serial port or capture file")
+    parser.add_argument("output", help="CSV file, or - for standard output")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate (default: 115200)")
+    args = parser.parse_args()
+
+    counters = {"crc_errors": 0, "lost": 0, "frames": 0}
+    previous_sequence = None
+
+    output = sys.stdout if args.output == "-" else open(args.output, "w", newline="")
+    try:
+        writer = csv.writer(output)
+        writer.writerow(COLUMNS)
+        with open_input(args.input, args.baud) as stream:
+            for payload in read_frames(stream, counters):
+                row = decode_payload(payload)
+                sequence = row[0]
+                if previous_sequence is not None:
+                    counters["lost"] += (sequence - previous_sequence - 1) & 0xFFFF
+                previous_sequence = sequence
+                counters["frames"] += 1
+                writer.writerow(row)
+                output.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if output is not sys.stdout:
+            output.close()
+        sys.stderr.write("%d frames, %d lost, %d CRC errors\n"
+                         % (counters["frames"], counters["lost"], counters["crc_errors"]))
+
+
+if __name__ == "__main__":
+    main()